@@ -1,71 +1,156 @@
-#!/bin/bash
-if [ -z "$1" ]; then
-	echo "No argument provided. Possible values:"
+#!/bin/sh
+
+# Benchmarks of the solvers, see tools/406_benchmark_solve for the details
+# and for more options. The library is configured once with the largest
+# number of threads needed, and the number of threads is changed at runtime.
+# Extra arguments are passed to the tool, for example:
+#    ./benchmark.sh multithread -format csv -output results.csv
+
+usage() {
+	echo "Possible values:"
 	echo "  - performance"
 	echo "  - architecture"
 	echo "  - memory"
+	echo "  - k4"
+	echo "  - k1"
+	echo "  - extra"
 	echo "  - nodes"
 	echo "  - multithread"
+	echo "  - numa"
+	echo "  - hugepages"
+	echo "  - cache"
+	echo "  - interleave"
+	echo "  - depth"
+	echo "  - primitives"
+}
+
+if [ -z "$1" ]; then
+	echo "No argument provided."
+	usage
 	exit 1
 fi
 
 input=$1
-ARGS="h48h6k2"
-THREADS=8
+shift
+SOLVER="h48h6k2"
+SCRAMBLES="tools/406_benchmark_solve/scrambles/short.txt"
+SCRAMBLES="$SCRAMBLES,tools/406_benchmark_solve/scrambles/medium.txt"
+
+run() {
+	make clean
+	if [ -n "$2" ]; then
+		THREADS=$1 ARCH=$2 ./configure.sh
+	else
+		THREADS=$1 ./configure.sh
+	fi
+	shift 2
+	TOOL=benchmark_solve \
+	    TOOLARGS="-scrambles $SCRAMBLES $* $EXTRA" make tool
+}
 
+EXTRA="$*"
 case $input in
 	performance)
-		for i in 1 8 64; do
-			make clean
-			THREADS=$i ./configure.sh
-			TOOL=benchmark_performance TOOLARGS="$ARGS" make tool
-		done
+		run 64 "" -solver $SOLVER -threads 1,8,64
 		;;
 	architecture)
 		echo "Architecture Benchmark..."
-		for i in 1 8; do
-			make clean
-			THREADS=$i ARCH=PORTABLE ./configure.sh
-			TOOL=benchmark_performance TOOLARGS="$ARGS" make tool
-		done
+		run 8 PORTABLE -solver $SOLVER -threads 1,8
+		run 8 "" -solver $SOLVER -threads 1,8
 		;;
 	memory)
 		echo "Memory Benchmark..."
-		for i in {1..6}; do
-			make clean
-			THREADS=$THREADS ./configure.sh
-			M_ARGS="h48h${i}k2"
-			TOOL=benchmark_performance TOOLARGS="$M_ARGS" make tool
-		done
+		run 8 "" -threads 8 \
+		    -solver h48h1k2,h48h2k2,h48h3k2,h48h4k2,h48h5k2,h48h6k2
+		;;
+	k4)
+		echo "k4 Benchmark..."
+		# Each k4 table is as large as the k2 table after it, without the
+		# h0k4 fallback table
+		run 8 "" -threads 8 \
+		    -solver h48h1k4,h48h2k2,h48h2k4,h48h3k2,h48h3k4,h48h4k2
+		;;
+	k1)
+		echo "k1 Benchmark..."
+		# Each k1 table is as large as the k2 table before it
+		run 8 "" -threads 8 \
+		    -solver h48h1k2,h48h2k1,h48h2k2,h48h3k1,h48h3k2,h48h4k1
+		;;
+	extra)
+		echo "Extra tables Benchmark..."
+		# The extra tables (see doc/h48.md) in different combinations and
+		# orders; the nodes pruned by each table are shown at the end
+		run 8 "" -threads 1 \
+		    -solver h48h0k4,h48h0k4c,h48h0k4e,h48h0k4ce,h48h0k4ec
 		;;
 	nodes)
 		echo "Nodes Benchmark..."
-		make clean
-		THREADS=1 ./configure.sh
-		TOOL=benchmark_nodes TOOLARGS="$ARGS" make tool
+		run 1 "" -solver $SOLVER -threads 1
 		;;
 	multithread)
 		echo "Multithread Benchmark..."
-		for i in 64 32 16 8 4 2 1; do
-			make clean
-			THREADS=$i ./configure.sh
-			TOOL=benchmark_performance TOOLARGS="$ARGS" make tool
+		run 64 "" -solver $SOLVER -threads 64,32,16,8,4,2,1
+		;;
+	numa)
+		echo "NUMA Benchmark..."
+		# Placement of the data on machines with more than one NUMA node,
+		# see tools/408_benchmark_numa; on a single node all modes are equal
+		make clean
+		THREADS=64 ./configure.sh
+		TOOL=benchmark_numa TOOLARGS="-solver $SOLVER -threads 1,8,64 \
+		    -numa default,interleave,replicate $EXTRA" make tool
+		;;
+	hugepages)
+		echo "Huge pages Benchmark..."
+		# Tables in normal pages and in huge pages, see
+		# tools/409_benchmark_hugepages
+		make clean
+		THREADS=8 ./configure.sh
+		for solver in h48h0k4 $SOLVER; do
+			TOOL=benchmark_hugepages \
+			    TOOLARGS="-solver $solver $EXTRA" make tool
 		done
 		;;
+	cache)
+		echo "Cache Benchmark..."
+		# Solutions cached by canonical cube, see tools/410_benchmark_cache
+		make clean
+		THREADS=8 ./configure.sh
+		TOOL=benchmark_cache \
+		    TOOLARGS="-solver $SOLVER -threads 8 $EXTRA" make tool
+		;;
+	interleave)
+		echo "Interleave Benchmark..."
+		# Searches run at the same time by each thread, see
+		# tools/411_benchmark_interleave
+		make clean
+		THREADS=8 ./configure.sh
+		TOOL=benchmark_interleave TOOLARGS="-solver $SOLVER \
+		    -threads 1,8 -interleave 1,2,4,8 $EXTRA" make tool
+		;;
 	depth)
 		echo "Depth Benchmark..."
+		run 8 "" -solver $SOLVER -threads 8
+		;;
+	primitives)
+		echo "Primitives Benchmark..."
+		# Every backend up to the one detected for this machine
+		native="$(./configure.sh | sed -n 's/^Selected architecture: //p')"
+		case "$native" in
+			AVX512) archs="PORTABLE AVX2 AVX512" ;;
+			AVX2) archs="PORTABLE AVX2" ;;
+			NEON) archs="PORTABLE NEON" ;;
+			*) archs="PORTABLE" ;;
+		esac
+		for arch in $archs; do
 			make clean
-			THREADS=$THREADS ./configure.sh
-			TOOL=benchmark_performance TOOLARGS="$ARGS" make tool
+			ARCH=$arch ./configure.sh
+			TOOL=benchmark_primitives TOOLARGS="$EXTRA" make tool
+		done
 		;;
 	*)
-	echo "Invalid argument. Possible values:"
-	echo "  - performance"
-	echo "  - architecture"
-	echo "  - memory"
-	echo "  - nodes"
-	echo "  - multithread"
-	echo "  - depth"
-	exit 1
-	;;
-esac
\ No newline at end of file
+		echo "Invalid argument."
+		usage
+		exit 1
+		;;
+esac
@@ -11,7 +11,17 @@
 # You can use this variable to build for a different architecture, for example
 # if you want to cross-compile or to use the portable version.
 # By default, the build script will detect which architecture it is running on.
-# The string "architecture" must be one of "AVX2", "NEON" or "PORTABLE".
+# The string "architecture" must be one of "AVX512", "AVX2", "NEON" or
+# "PORTABLE". AVX512 requires the AVX512F, AVX512BW and AVX512VL extensions;
+# when they are not available, AVX2 is detected instead.
+#
+# DISPATCH="yes"
+# Build the library for all the x86_64 backends (AVX512, AVX2 and PORTABLE)
+# and select the one to use at runtime, based on the CPU. This way the same
+# nissy.o can be used on any x86_64 machine. This only affects nissy.o and
+# what is built on top of it: the debug build used for the tests and the
+# tool sources are still compiled for the architecture given by ARCH.
+# By default this is disabled.
 #
 # THREADS=n
 # Choose how many threads to use for multi-threaded oerations.
@@ -34,6 +44,9 @@
 #
 # 2. Build using thread and undefined behavior sanitizers when in debug mode
 #    SANITIZE="thread,undefined" ./configure.sh && make
+#
+# 3. Build a library that can run on any x86_64 machine
+#    DISPATCH="yes" ./configure.sh && make
 
 greparch() {
 	$CC -march=native -dM -E - </dev/null 2>/dev/null | grep "$1"
@@ -45,6 +58,8 @@ detectthreads() {
 
 detectarch() {
 	[ -n "$(greparch __AVX2__)" ] && detected="AVX2"
+	[ -n "$(greparch __AVX512F__)" ] && [ -n "$(greparch __AVX512BW__)" ] \
+	    && [ -n "$(greparch __AVX512VL__)" ] && detected="AVX512"
 	[ -n "$(greparch __ARM_NEON)" ] && detected="NEON"
 	[ -z "$detected" ] && detected="PORTABLE"
 
@@ -65,13 +80,31 @@ validatethreads() {
 	fi
 }
 
+validatedispatch() {
+	case "$DISPATCH" in
+	yes)
+		if [ -z "$($CC -dM -E - </dev/null | grep __x86_64__)" ]; then
+			echo "Error: DISPATCH is only supported on x86_64"
+			exit 1
+		fi
+		;;
+	""|no)
+		DISPATCH=""
+		;;
+	*)
+		echo "Error: DISPATCH must be 'yes' or 'no'"
+		exit 1
+		;;
+	esac
+}
+
 validatearch() {
 	case "$ARCH" in
-	AVX2|NEON|PORTABLE)
+	AVX512|AVX2|NEON|PORTABLE)
 		;;
 	*)
 		echo "Error: architecture '$ARCH' not supported"
-		echo "Supported architectures: AVX2, NEON, PORTABLE"
+		echo "Supported architectures: AVX512, AVX2, NEON, PORTABLE"
 		exit 1
 		;;
 	esac
@@ -84,13 +117,19 @@ ARCH=${ARCH-"$(detectarch)"}
 validatecc
 validatethreads
 validatearch
+validatedispatch
 
 STD="-std=c11"
 WFLAGS="-pedantic -Wall -Wextra -Werror"
 WNOFLAGS="-Wno-unused-parameter -Wno-unused-function -Wno-unknown-pragmas"
 WNOFLAGS="$WNOFLAGS -Wno-unused-command-line-argument"
 
+AVX2FLAGS="-mavx2 -mbmi2"
+AVX512FLAGS="-mavx2 -mavx512f -mavx512bw -mavx512vl -mbmi2"
+
 [ "$ARCH" = "AVX2" ] && AVX="-mavx2"
+[ "$ARCH" = "AVX512" ] && AVX="$AVX512FLAGS"
+[ "$ARCH" = "AVX2" ] && [ -n "$(greparch __BMI2__)" ] && AVX="$AVX -mbmi2"
 
 if [ -n "$SANITIZE" ]; then
 	# Use the user-specified comma-separated sanitizers
@@ -102,9 +141,11 @@ else
 fi
 LIBS="-lpthread"
 
-CFLAGS="$STD $LIBS $WFLAGS $WNOFLAGS $AVX -O3 -fPIC"
+BASEFLAGS="$STD $LIBS $WFLAGS $WNOFLAGS -O3 -fPIC"
+CFLAGS="$BASEFLAGS $AVX"
 DBGFLAGS="$STD $LIBS $WFLAGS $WNOFLAGS $SAN $AVX -g3 -DDEBUG -fPIC"
-MACROS="-DTHREADS=$THREADS -D$ARCH"
+BASEMACROS="-DTHREADS=$THREADS"
+MACROS="$BASEMACROS -D$ARCH"
 
 if (command -v "python3-config" >/dev/null 2>&1) ; then
 	PYTHON3_INCLUDES="$(python3-config --includes)"
@@ -116,6 +157,7 @@ fi
 
 echo "Compiler: $CC"
 echo "Selected architecture: $ARCH"
+echo "Runtime dispatch: ${DISPATCH:-no}"
 echo "Number of threads: $THREADS"
 echo "Sanitizer options (debug build only): $SAN"
 echo "Python3 development libraries: $PYTHON3"
@@ -129,6 +171,12 @@ echo "DBGFLAGS = $DBGFLAGS";
 echo "";
 echo "MACROS = $MACROS"
 echo "";
+echo "DISPATCH = $DISPATCH"
+echo "BASEFLAGS = $BASEFLAGS"
+echo "BASEMACROS = $BASEMACROS"
+echo "AVX2FLAGS = $AVX2FLAGS"
+echo "AVX512FLAGS = $AVX512FLAGS"
+echo "";
 echo "PYTHON3_INCLUDES = $PYTHON3_INCLUDES"
 echo "CC = $CC"
 } > config.mk
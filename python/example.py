@@ -13,8 +13,9 @@ import nissy_python_module as nissy
 # Choose the solver you prefer
 solver = "h48h0k4"
 
-# Load the pruning table from file
-data = bytearray(open("tables/" + solver, "rb").read())
+# Load the pruning table from file. The file is mapped to memory rather
+# than copied, and the same data can be used by many threads at once.
+data = nissy.loaddata("tables/" + solver)
 
 # If you have not generated the table yet, you can do so:
 # data = nissy.gendata("h48h0k4")
@@ -1,6 +1,10 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "../src/nissy.h"
 
@@ -56,6 +60,36 @@ string_result_free(long long err, char *result)
 	return check_error(err) ? ret : NULL;
 }
 
+/* Split the newline-terminated solutions written by nissy_solve() */
+static PyObject *
+solutions_list(char *solutions)
+{
+	Py_ssize_t i, j, k, n;
+	PyObject *list, *item;
+
+	for (i = 0, n = 0; solutions[i] != 0; i++)
+		n += solutions[i] == '\n';
+
+	list = PyList_New(n);
+	if (list == NULL)
+		return NULL;
+	for (i = 0, j = 0, k = 0; solutions[i] != 0; i++) {
+		if (solutions[i] != '\n')
+			continue;
+		solutions[i] = 0;
+		item = PyUnicode_FromString(&solutions[k]);
+		if (item == NULL) {
+			Py_DECREF(list);
+			return NULL;
+		}
+		PyList_SET_ITEM(list, j, item);
+		j++;
+		k = i+1;
+	}
+
+	return list;
+}
+
 static PyObject *
 long_result(long long result)
 {
@@ -258,6 +292,7 @@ gendata(PyObject *self, PyObject *args)
 	long long size, err;
 	const char *solver;
 	char *buf;
+	PyObject *data;
 
 	if (!PyArg_ParseTuple(args, "s", &solver))
 		return NULL;
@@ -266,16 +301,81 @@ gendata(PyObject *self, PyObject *args)
 	if (!check_error(size))
 		return NULL;
 
-	buf = PyMem_Malloc(size);
+	/* Generate the data directly in the returned object, without copies */
+	data = PyByteArray_FromStringAndSize(NULL, size);
+	if (data == NULL)
+		return NULL;
+	buf = PyByteArray_AsString(data);
 
 	Py_BEGIN_ALLOW_THREADS
 	err = nissy_gendata(solver, size, buf);
 	Py_END_ALLOW_THREADS
 
-	if (check_error(err))
-		return PyByteArray_FromStringAndSize(buf, size);
-	else
+	if (check_error(err)) {
+		return data;
+	} else {
+		Py_DECREF(data);
 		return NULL;
+	}
+}
+
+PyDoc_STRVAR(loaddata_doc,
+"loaddata(filename)\n"
+"--\n\n"
+"Maps the data (pruning table) saved in the given file to memory\n"
+"\n"
+"The file is not read into memory, but it is accessed directly by the\n"
+"operating system when needed. The returned object can be shared by\n"
+"multiple threads calling solve() at the same time.\n"
+"\n"
+"Parameters:\n"
+"  - filename: the path of the file containing the data\n"
+"\n"
+"Returns: a read-only mmap.mmap object containing the data\n"
+);
+static PyObject *
+loaddata(PyObject *self, PyObject *args)
+{
+	PyObject *filename, *io, *mmap, *ctor, *file, *margs, *kwargs, *ret;
+
+	if (!PyArg_ParseTuple(args, "O", &filename))
+		return NULL;
+
+	ret = NULL;
+	ctor = file = margs = kwargs = NULL;
+	io = PyImport_ImportModule("io");
+	mmap = PyImport_ImportModule("mmap");
+	if (io == NULL || mmap == NULL)
+		goto loaddata_done;
+
+	file = PyObject_CallMethod(io, "open", "Os", filename, "rb");
+	if (file == NULL)
+		goto loaddata_done;
+
+	/*
+	Equivalent to mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_READ).
+	The mmap object keeps its own copy of the file descriptor, so the
+	file can be closed right away.
+	*/
+	margs = Py_BuildValue("(Ni)",
+	    PyObject_CallMethod(file, "fileno", NULL), 0);
+	kwargs = Py_BuildValue("{sN}",
+	    "access", PyObject_GetAttrString(mmap, "ACCESS_READ"));
+	ctor = PyObject_GetAttrString(mmap, "mmap");
+	if (margs != NULL && kwargs != NULL && ctor != NULL)
+		ret = PyObject_Call(ctor, margs, kwargs);
+
+	Py_XDECREF(PyObject_CallMethod(file, "close", NULL));
+
+loaddata_done:
+	Py_XDECREF(kwargs);
+	Py_XDECREF(margs);
+	Py_XDECREF(ctor);
+	Py_XDECREF(file);
+	Py_XDECREF(mmap);
+	Py_XDECREF(io);
+
+	return ret;
 }
 
 PyDoc_STRVAR(checkdata_doc,
@@ -284,7 +384,8 @@ PyDoc_STRVAR(checkdata_doc,
 "Checks if the data (pruning table) given is valid or not\n"
 "\n"
 "Parameters:\n"
-"  - data: a bytearray containing the data for a solver"
+"  - data: a bytes-like object containing the data for a solver, for\n"
+"    example a bytearray or the value returned by loaddata()\n"
 "\n"
 "Returns: true if the data is valid, false otherwise\n"
 );
@@ -292,17 +393,21 @@ PyObject *
 checkdata(PyObject *self, PyObject *args)
 {
 	long long result;
-	PyByteArrayObject *data;
+	Py_buffer data;
 
-	if (!PyArg_ParseTuple(args, "Y", &data))
+	if (!PyArg_ParseTuple(args, "y*", &data))
 		return NULL;
 
-	result = nissy_checkdata(data->ob_alloc, data->ob_bytes);
+	Py_BEGIN_ALLOW_THREADS
+	result = nissy_checkdata(data.len, data.buf);
+	Py_END_ALLOW_THREADS
+
+	PyBuffer_Release(&data);
 
-	if (check_error(result))
-		return Py_True;
+	if (result == NISSY_OK)
+		Py_RETURN_TRUE;
 	else
-		return Py_False;
+		Py_RETURN_FALSE;
 }
 
 PyDoc_STRVAR(solve_doc,
@@ -310,6 +415,8 @@ PyDoc_STRVAR(solve_doc,
 "--\n\n"
 "Solves the given 'cube' with the given 'solver' and other parameters."
 "See the documentation for libnissy (in nissy.h) for details.\n"
+"The Python interpreter lock is released while solving, so solve() can\n"
+"be called from multiple threads at the same time, sharing the data.\n"
 "\n"
 "Parameters:\n"
 "  - cube: a cube in B32 format\n"
@@ -319,7 +426,8 @@ PyDoc_STRVAR(solve_doc,
 "  - maxsolution: the maximum number of solutions to return\n"
 "  - optimal: the largest number of moves from the shortest solution"
 "(set to -1 to ignore)\n"
-"  - data: a bytearray containing the data for the solver\n"
+"  - data: a bytes-like object containing the data for the solver, for\n"
+"    example a bytearray or the value returned by loaddata()\n"
 "\n"
 "Returns: a list with the solutions found\n"
 );
@@ -328,38 +436,27 @@ solve(PyObject *self, PyObject *args)
 {
 	long long result;
 	unsigned nissflag, minmoves, maxmoves, maxsolutions;
-	int optimal, i, j, k;
+	int optimal;
 	const char *cube, *solver;
 	char solutions[MAX_SOLUTIONS_SIZE];
 	long long stats[NISSY_SIZE_SOLVE_STATS];
-	PyByteArrayObject *data;
-	PyObject *list, *item;
+	Py_buffer data;
 
-	if (!PyArg_ParseTuple(args, "ssIIIIiY", &cube, &solver, &nissflag,
+	if (!PyArg_ParseTuple(args, "ssIIIIiy*", &cube, &solver, &nissflag,
 	    &minmoves, &maxmoves, &maxsolutions, &optimal, &data))
 		return NULL;
 
+	/* Nothing is written if no solve is done, e.g. if maxsolutions is 0 */
+	solutions[0] = '\0';
 	Py_BEGIN_ALLOW_THREADS
 	result = nissy_solve(cube, solver, nissflag, minmoves, maxmoves,
-	    maxsolutions, optimal, data->ob_alloc, data->ob_bytes,
+	    maxsolutions, optimal, data.len, data.buf,
 	    MAX_SOLUTIONS_SIZE, solutions, stats);
 	Py_END_ALLOW_THREADS
 
-	if(!check_error(result)) {
-		return NULL;
-	} else {
-		list = PyList_New(result);
-		for (i = 0, j = 0, k = 0; solutions[i] != 0; i++) {
-			if (solutions[i] != '\n')
-				continue;
-			solutions[i] = 0;
-			item = PyUnicode_FromString(&solutions[k]);
-			PyList_SetItem(list, j, item);
-			j++;
-			k = i+1;
-		}
-		return list;
-	}
+	PyBuffer_Release(&data);
+
+	return check_error(result) ? solutions_list(solutions) : NULL;
 }
 
 PyDoc_STRVAR(countmoves_doc,
@@ -385,6 +482,575 @@ countmoves(PyObject *self, PyObject *args)
 	return long_result(count);
 }
 
+PyDoc_STRVAR(getarch_doc,
+"getarch()\n"
+"--\n\n"
+"Get the name of the architecture-specific backend in use\n"
+"\n"
+"Returns: one of \"AVX512\", \"AVX2\", \"NEON\" or \"PORTABLE\"\n"
+);
+static PyObject *
+getarch(PyObject *self, PyObject *args)
+{
+	long long err;
+	char result[NISSY_SIZE_ARCH];
+
+	err = nissy_getarch(result);
+	return string_result(err, result);
+}
+
+/*
+Batch versions of some of the methods above. They take many cubes at once,
+either as a list of strings or as a bytes-like object containing the cubes
+in B32 format, each padded with zeros to NISSY_SIZE_B32 bytes (this is the
+layout of a numpy array of dtype "S22"). The results are returned in the
+same form as the input, and the work is done with the interpreter lock
+released, optionally on multiple threads.
+*/
+
+#define MAX_BATCH_THREADS 256
+#define BATCH_CHUNK 256
+
+typedef struct {
+	Py_ssize_t n;
+	const char *buf;
+	bool isbuffer;
+	Py_buffer view;
+	char *copy;
+} cubes_t;
+
+typedef struct {
+	Py_ssize_t n;
+	const char *shared;
+	PyObject *seq;
+	const char **each;
+} strings_t;
+
+typedef struct batch batch_t;
+struct batch {
+	long long (*op)(batch_t *, Py_ssize_t, char *);
+	Py_ssize_t n;
+	Py_ssize_t chunk;
+	_Atomic Py_ssize_t next;
+	_Atomic long long error;
+	const char *cubes;
+	const char *others;
+	Py_ssize_t others_step;
+	strings_t *strings;
+	char *results;
+	char **solutions;
+	const char *solver;
+	unsigned nissflag;
+	unsigned minmoves;
+	unsigned maxmoves;
+	unsigned maxsolutions;
+	int optimal;
+	Py_buffer *data;
+};
+
+static bool
+is_error(long long err)
+{
+	return err < 0 && err != NISSY_WARNING_UNSOLVABLE;
+}
+
+static bool
+get_cubes(PyObject *obj, cubes_t *cubes)
+{
+	Py_ssize_t i, len;
+	const char *str;
+	PyObject *seq;
+
+	cubes->copy = NULL;
+	cubes->isbuffer = PyObject_CheckBuffer(obj);
+	if (cubes->isbuffer) {
+		if (PyObject_GetBuffer(obj, &cubes->view, PyBUF_SIMPLE) != 0)
+			return false;
+		if (cubes->view.len % NISSY_SIZE_B32 != 0) {
+			PyErr_Format(PyExc_ValueError, "The size of the buffer "
+			    "must be a multiple of %u", NISSY_SIZE_B32);
+			PyBuffer_Release(&cubes->view);
+			return false;
+		}
+		cubes->n = cubes->view.len / NISSY_SIZE_B32;
+		cubes->buf = cubes->view.buf;
+		return true;
+	}
+
+	seq = PySequence_Fast(obj, "Expected a list of cubes or a buffer");
+	if (seq == NULL)
+		return false;
+
+	/* Copy the strings to a buffer in the same layout as above */
+	cubes->n = PySequence_Fast_GET_SIZE(seq);
+	cubes->copy = PyMem_Calloc(cubes->n + 1, NISSY_SIZE_B32);
+	if (cubes->copy == NULL) {
+		Py_DECREF(seq);
+		PyErr_NoMemory();
+		return false;
+	}
+	for (i = 0; i < cubes->n; i++) {
+		str = PyUnicode_AsUTF8AndSize(
+		    PySequence_Fast_GET_ITEM(seq, i), &len);
+		if (str == NULL) {
+			Py_DECREF(seq);
+			PyMem_Free(cubes->copy);
+			return false;
+		}
+		len = len < NISSY_SIZE_B32 ? len : NISSY_SIZE_B32 - 1;
+		memcpy(cubes->copy + i * NISSY_SIZE_B32, str, len);
+	}
+	cubes->buf = cubes->copy;
+
+	Py_DECREF(seq);
+	return true;
+}
+
+static void
+release_cubes(cubes_t *cubes)
+{
+	if (cubes->isbuffer)
+		PyBuffer_Release(&cubes->view);
+	else
+		PyMem_Free(cubes->copy);
+}
+
+static PyObject *
+cubes_result(const cubes_t *cubes, const char *results)
+{
+	Py_ssize_t i;
+	PyObject *list, *item;
+
+	if (cubes->isbuffer)
+		return PyBytes_FromStringAndSize(
+		    results, cubes->n * NISSY_SIZE_B32);
+
+	list = PyList_New(cubes->n);
+	if (list == NULL)
+		return NULL;
+	for (i = 0; i < cubes->n; i++) {
+		item = PyUnicode_FromString(results + i * NISSY_SIZE_B32);
+		if (item == NULL) {
+			Py_DECREF(list);
+			return NULL;
+		}
+		PyList_SET_ITEM(list, i, item);
+	}
+
+	return list;
+}
+
+/* A single string, used for all cubes, or a list of n strings */
+static bool
+get_strings(PyObject *obj, Py_ssize_t n, strings_t *strings)
+{
+	Py_ssize_t i;
+
+	strings->seq = NULL;
+	strings->each = NULL;
+	if (PyUnicode_Check(obj)) {
+		strings->shared = PyUnicode_AsUTF8(obj);
+		return strings->shared != NULL;
+	}
+
+	strings->seq = PySequence_Fast(obj, "Expected a string or a list");
+	if (strings->seq == NULL)
+		return false;
+	if (PySequence_Fast_GET_SIZE(strings->seq) != n) {
+		PyErr_SetString(PyExc_ValueError,
+		    "The lists must have the same length");
+		goto get_strings_error;
+	}
+
+	/* The strings are owned by the list, which we keep a reference to */
+	strings->each = PyMem_Malloc((n + 1) * sizeof(const char *));
+	if (strings->each == NULL) {
+		PyErr_NoMemory();
+		goto get_strings_error;
+	}
+	for (i = 0; i < n; i++) {
+		strings->each[i] = PyUnicode_AsUTF8(
+		    PySequence_Fast_GET_ITEM(strings->seq, i));
+		if (strings->each[i] == NULL)
+			goto get_strings_error;
+	}
+
+	return true;
+
+get_strings_error:
+	PyMem_Free(strings->each);
+	Py_DECREF(strings->seq);
+	return false;
+}
+
+static void
+release_strings(strings_t *strings)
+{
+	PyMem_Free(strings->each);
+	Py_XDECREF(strings->seq);
+}
+
+static const char *
+string_at(const strings_t *strings, Py_ssize_t i)
+{
+	return strings->each == NULL ? strings->shared : strings->each[i];
+}
+
+static void *
+batch_thread(void *arg)
+{
+	batch_t *batch;
+	Py_ssize_t i, j;
+	long long err;
+	char *buf;
+
+	batch = arg;
+	buf = batch->solutions == NULL ? NULL : malloc(MAX_SOLUTIONS_SIZE);
+	if (batch->solutions != NULL && buf == NULL) {
+		atomic_store(&batch->error, NISSY_ERROR_UNKNOWN);
+		return NULL;
+	}
+
+	while ((i = atomic_fetch_add(&batch->next, batch->chunk)) < batch->n) {
+		for (j = i; j < i + batch->chunk && j < batch->n; j++) {
+			err = batch->op(batch, j, buf);
+			if (is_error(err))
+				atomic_store(&batch->error, err);
+		}
+	}
+
+	free(buf);
+	return NULL;
+}
+
+/* Must be called without holding the interpreter lock */
+static long long
+batch_run(batch_t *batch, unsigned threads)
+{
+	unsigned i, started;
+	pthread_t thread[MAX_BATCH_THREADS];
+
+	atomic_init(&batch->next, 0);
+	atomic_init(&batch->error, NISSY_OK);
+
+	if (threads > MAX_BATCH_THREADS)
+		threads = MAX_BATCH_THREADS;
+	for (started = 0; started + 1 < threads; started++)
+		if (pthread_create(&thread[started], NULL, batch_thread, batch))
+			break;
+
+	/* The calling thread works too */
+	batch_thread(batch);
+	for (i = 0; i < started; i++)
+		pthread_join(thread[i], NULL);
+
+	return atomic_load(&batch->error);
+}
+
+static bool
+check_threads(int threads)
+{
+	if (threads > 0)
+		return true;
+
+	PyErr_SetString(PyExc_ValueError, "The number of threads must be positive");
+	return false;
+}
+
+static long long
+batch_compose(batch_t *batch, Py_ssize_t i, char *buf)
+{
+	return nissy_compose(batch->cubes + i * NISSY_SIZE_B32,
+	    batch->others + i * batch->others_step,
+	    batch->results + i * NISSY_SIZE_B32);
+}
+
+static long long
+batch_inverse(batch_t *batch, Py_ssize_t i, char *buf)
+{
+	return nissy_inverse(batch->cubes + i * NISSY_SIZE_B32,
+	    batch->results + i * NISSY_SIZE_B32);
+}
+
+static long long
+batch_applymoves(batch_t *batch, Py_ssize_t i, char *buf)
+{
+	return nissy_applymoves(batch->cubes + i * NISSY_SIZE_B32,
+	    string_at(batch->strings, i), batch->results + i * NISSY_SIZE_B32);
+}
+
+static long long
+batch_solve(batch_t *batch, Py_ssize_t i, char *buf)
+{
+	long long err, stats[NISSY_SIZE_SOLVE_STATS];
+
+	/* See solve() */
+	buf[0] = '\0';
+	err = nissy_solve(batch->cubes + i * NISSY_SIZE_B32, batch->solver,
+	    batch->nissflag, batch->minmoves, batch->maxmoves,
+	    batch->maxsolutions, batch->optimal, batch->data->len,
+	    batch->data->buf, MAX_SOLUTIONS_SIZE, buf, stats);
+
+	if (!is_error(err)) {
+		batch->solutions[i] = strdup(buf);
+		if (batch->solutions[i] == NULL)
+			return NISSY_ERROR_UNKNOWN;
+	}
+
+	return err;
+}
+
+/* Common part of the batch methods that return a cube for each cube */
+static PyObject *
+batch_cubes(batch_t *batch, cubes_t *cubes, unsigned threads)
+{
+	long long err;
+	PyObject *ret;
+
+	batch->n = cubes->n;
+	batch->chunk = BATCH_CHUNK;
+	batch->cubes = cubes->buf;
+	batch->solutions = NULL;
+	batch->results = PyMem_Calloc(cubes->n + 1, NISSY_SIZE_B32);
+	if (batch->results == NULL)
+		return PyErr_NoMemory();
+
+	Py_BEGIN_ALLOW_THREADS
+	err = batch_run(batch, threads);
+	Py_END_ALLOW_THREADS
+
+	ret = check_error(err) ? cubes_result(cubes, batch->results) : NULL;
+	PyMem_Free(batch->results);
+
+	return ret;
+}
+
+PyDoc_STRVAR(compose_many_doc,
+"compose_many(cubes, permutations, threads=1)\n"
+"--\n\n"
+"Apply each of the 'permutations' on the corresponding cube.\n"
+"\n"
+"Parameters:\n"
+"  - cubes: a list of cubes in B32 format, or a bytes-like object\n"
+"    containing the cubes in B32 format, each padded with zeros to 22 bytes\n"
+"  - permutations: a single cube, applied to all 'cubes', or as many cubes\n"
+"    as 'cubes', in any of the forms above\n"
+"  - threads: the number of threads to use\n"
+"\n"
+"Returns: the resulting cubes, as a list or as a bytes object, depending\n"
+"on the type of 'cubes'\n"
+);
+static PyObject *
+compose_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+	static char *kwlist[] = { "cubes", "permutations", "threads", NULL };
+
+	int threads;
+	cubes_t cubes, perms;
+	batch_t batch;
+	PyObject *cubesobj, *permsobj, *ret;
+
+	threads = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i", kwlist,
+	    &cubesobj, &permsobj, &threads) || !check_threads(threads))
+		return NULL;
+
+	/* A single permutation is read as a list of one cube */
+	if (PyUnicode_Check(permsobj))
+		permsobj = Py_BuildValue("[O]", permsobj);
+	else
+		Py_INCREF(permsobj);
+	if (permsobj == NULL)
+		return NULL;
+
+	ret = NULL;
+	if (!get_cubes(cubesobj, &cubes))
+		goto compose_many_done;
+	if (!get_cubes(permsobj, &perms)) {
+		release_cubes(&cubes);
+		goto compose_many_done;
+	}
+
+	if (perms.n != cubes.n && perms.n != 1) {
+		PyErr_SetString(PyExc_ValueError,
+		    "The number of cubes and permutations must be the same");
+	} else {
+		batch.op = batch_compose;
+		batch.others = perms.buf;
+		batch.others_step = perms.n == 1 ? 0 : NISSY_SIZE_B32;
+		ret = batch_cubes(&batch, &cubes, threads);
+	}
+
+	release_cubes(&perms);
+	release_cubes(&cubes);
+
+compose_many_done:
+	Py_DECREF(permsobj);
+	return ret;
+}
+
+PyDoc_STRVAR(inverse_many_doc,
+"inverse_many(cubes, threads=1)\n"
+"--\n\n"
+"Invert each of the 'cubes'.\n"
+"\n"
+"Parameters:\n"
+"  - cubes: a list of cubes in B32 format, or a bytes-like object\n"
+"    containing the cubes in B32 format, each padded with zeros to 22 bytes\n"
+"  - threads: the number of threads to use\n"
+"\n"
+"Returns: the inverse cubes, as a list or as a bytes object, depending\n"
+"on the type of 'cubes'\n"
+);
+static PyObject *
+inverse_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+	static char *kwlist[] = { "cubes", "threads", NULL };
+
+	int threads;
+	cubes_t cubes;
+	batch_t batch;
+	PyObject *cubesobj, *ret;
+
+	threads = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", kwlist,
+	    &cubesobj, &threads) || !check_threads(threads))
+		return NULL;
+
+	if (!get_cubes(cubesobj, &cubes))
+		return NULL;
+
+	batch.op = batch_inverse;
+	ret = batch_cubes(&batch, &cubes, threads);
+
+	release_cubes(&cubes);
+	return ret;
+}
+
+PyDoc_STRVAR(applymoves_many_doc,
+"applymoves_many(cubes, moves, threads=1)\n"
+"--\n\n"
+"Apply 'moves' to each of the 'cubes'.\n"
+"\n"
+"Parameters:\n"
+"  - cubes: a list of cubes in B32 format, or a bytes-like object\n"
+"    containing the cubes in B32 format, each padded with zeros to 22 bytes\n"
+"  - moves: the moves to apply on all cubes, or a list of moves with the\n"
+"    same length as 'cubes'\n"
+"  - threads: the number of threads to use\n"
+"\n"
+"Returns: the resulting cubes, as a list or as a bytes object, depending\n"
+"on the type of 'cubes'\n"
+);
+static PyObject *
+applymoves_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+	static char *kwlist[] = { "cubes", "moves", "threads", NULL };
+
+	int threads;
+	cubes_t cubes;
+	strings_t moves;
+	batch_t batch;
+	PyObject *cubesobj, *movesobj, *ret;
+
+	threads = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i", kwlist,
+	    &cubesobj, &movesobj, &threads) || !check_threads(threads))
+		return NULL;
+
+	if (!get_cubes(cubesobj, &cubes))
+		return NULL;
+
+	ret = NULL;
+	if (get_strings(movesobj, cubes.n, &moves)) {
+		batch.op = batch_applymoves;
+		batch.strings = &moves;
+		ret = batch_cubes(&batch, &cubes, threads);
+		release_strings(&moves);
+	}
+
+	release_cubes(&cubes);
+	return ret;
+}
+
+PyDoc_STRVAR(solve_many_doc,
+"solve_many(cubes, solver, nissflag, minmoves, maxmoves, maxsolutions, "
+"optimal, data, threads=1)\n"
+"--\n\n"
+"Solves each of the 'cubes', like solve(). Each cube is solved by a\n"
+"single one of the given 'threads', but libnissy may use more threads\n"
+"for each solve.\n"
+"\n"
+"Parameters:\n"
+"  - cubes: a list of cubes in B32 format, or a bytes-like object\n"
+"    containing the cubes in B32 format, each padded with zeros to 22 bytes\n"
+"  - threads: the number of cubes to solve at the same time\n"
+"  - the other parameters are the same as for solve()\n"
+"\n"
+"Returns: a list containing the list of solutions for each cube\n"
+);
+static PyObject *
+solve_many(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+	static char *kwlist[] = { "cubes", "solver", "nissflag", "minmoves",
+	    "maxmoves", "maxsolutions", "optimal", "data", "threads", NULL };
+
+	int threads;
+	long long err;
+	Py_ssize_t i;
+	cubes_t cubes;
+	Py_buffer data;
+	batch_t batch;
+	PyObject *cubesobj, *ret, *item;
+
+	threads = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OsIIIIiy*|i", kwlist,
+	    &cubesobj, &batch.solver, &batch.nissflag, &batch.minmoves,
+	    &batch.maxmoves, &batch.maxsolutions, &batch.optimal, &data,
+	    &threads))
+		return NULL;
+
+	ret = NULL;
+	if (!check_threads(threads) || !get_cubes(cubesobj, &cubes))
+		goto solve_many_release_data;
+
+	batch.op = batch_solve;
+	batch.n = cubes.n;
+	batch.chunk = 1;
+	batch.cubes = cubes.buf;
+	batch.data = &data;
+	batch.solutions = PyMem_Calloc(cubes.n + 1, sizeof(char *));
+	if (batch.solutions == NULL) {
+		PyErr_NoMemory();
+		goto solve_many_release_cubes;
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	err = batch_run(&batch, threads);
+	Py_END_ALLOW_THREADS
+
+	if (check_error(err) && (ret = PyList_New(cubes.n)) != NULL) {
+		for (i = 0; i < cubes.n; i++) {
+			item = solutions_list(batch.solutions[i]);
+			if (item == NULL) {
+				Py_CLEAR(ret);
+				break;
+			}
+			PyList_SET_ITEM(ret, i, item);
+		}
+	}
+
+	for (i = 0; i < cubes.n; i++)
+		free(batch.solutions[i]);
+	PyMem_Free(batch.solutions);
+
+solve_many_release_cubes:
+	release_cubes(&cubes);
+solve_many_release_data:
+	PyBuffer_Release(&data);
+	return ret;
+}
+
 static PyMethodDef nissy_methods[] = {
 	{ "compose", compose, METH_VARARGS, compose_doc },
 	{ "inverse", inverse, METH_VARARGS, inverse_doc },
@@ -394,9 +1060,19 @@ static PyMethodDef nissy_methods[] = {
 	{ "getcube", getcube, METH_VARARGS, getcube_doc },
 	{ "datasize", datasize, METH_VARARGS, datasize_doc },
 	{ "gendata", gendata, METH_VARARGS, gendata_doc },
+	{ "loaddata", loaddata, METH_VARARGS, loaddata_doc },
 	{ "checkdata", checkdata, METH_VARARGS, checkdata_doc },
 	{ "solve", solve, METH_VARARGS, solve_doc },
 	{ "countmoves", countmoves, METH_VARARGS, countmoves_doc },
+	{ "getarch", getarch, METH_NOARGS, getarch_doc },
+	{ "compose_many", (PyCFunction)(void (*)(void))compose_many,
+	    METH_VARARGS | METH_KEYWORDS, compose_many_doc },
+	{ "inverse_many", (PyCFunction)(void (*)(void))inverse_many,
+	    METH_VARARGS | METH_KEYWORDS, inverse_many_doc },
+	{ "applymoves_many", (PyCFunction)(void (*)(void))applymoves_many,
+	    METH_VARARGS | METH_KEYWORDS, applymoves_many_doc },
+	{ "solve_many", (PyCFunction)(void (*)(void))solve_many,
+	    METH_VARARGS | METH_KEYWORDS, solve_many_doc },
 	{ NULL, NULL, 0, NULL }
 };
 
@@ -1,17 +1,30 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <inttypes.h>
 #include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #include "../src/nissy.h"
 
 #define PRINTCUBE_BUFFER_SIZE UINT64_C(1024)
 #define SOLUTIONS_BUFFER_SIZE UINT64_C(500000)
 #define MAX_PATH_LENGTH       UINT64_C(10000)
+#define MAX_SOLVER_LENGTH     100
+#define MAX_DATA              20
+#define MAX_LINE_ARGS         100
+#define MAX_SOLVE_THREADS     64
+#define SOLVE_QUEUE_SIZE      (2 * MAX_SOLVE_THREADS)
 
 #define FLAG_CUBE         "-cube"
 #define FLAG_PERM         "-perm"
@@ -28,6 +41,10 @@
 #define FLAG_MAXMOVES     "-M"
 #define FLAG_OPTIMAL      "-O"
 #define FLAG_MAXSOLUTIONS "-n"
+#define FLAG_SOCKET       "-socket"
+#define FLAG_FILE         "-file"
+#define FLAG_THREADS      "-threads"
+#define FLAG_CUBE_THREADS "-cubethreads"
 
 #define INFO_CUBEFORMAT(cube) cube " must be given in B32 format."
 #define INFO_MOVESFORMAT "The accepted moves are U, D, R, L, F and B, " \
@@ -54,6 +71,11 @@ typedef struct {
 	unsigned maxmoves;
 	unsigned optimal;
 	unsigned maxsolutions;
+	char *str_socket;
+	char *str_file;
+	unsigned threads;
+	unsigned cubethreads;
+	FILE *out;
 } args_t;
 
 static int64_t compose_exec(args_t *);
@@ -67,7 +89,10 @@ static int64_t datasize_exec(args_t *);
 static int64_t gendata_exec(args_t *);
 static int64_t solve_exec(args_t *);
 static int64_t solve_scramble_exec(args_t *);
+static int64_t solve_file_exec(args_t *);
 static int64_t countmoves_exec(args_t *);
+static int64_t arch_exec(args_t *);
+static int64_t server_exec(args_t *);
 static int64_t help_exec(args_t *);
 
 static int parse_args(int, char **, args_t *);
@@ -88,6 +113,10 @@ static bool set_minmoves(int, char **, args_t *);
 static bool set_maxmoves(int, char **, args_t *);
 static bool set_optimal(int, char **, args_t *);
 static bool set_maxsolutions(int, char **, args_t *);
+static bool set_str_socket(int, char **, args_t *);
+static bool set_str_file(int, char **, args_t *);
+static bool set_threads(int, char **, args_t *);
+static bool set_cubethreads(int, char **, args_t *);
 static bool set_id(int, char **, args_t *);
 
 static uint64_t rand64(void);
@@ -113,6 +142,10 @@ struct {
 	OPTION(FLAG_MAXMOVES, 1, set_maxmoves),
 	OPTION(FLAG_OPTIMAL, 1, set_optimal),
 	OPTION(FLAG_MAXSOLUTIONS, 1, set_maxsolutions),
+	OPTION(FLAG_SOCKET, 1, set_str_socket),
+	OPTION(FLAG_FILE, 1, set_str_file),
+	OPTION(FLAG_THREADS, 1, set_threads),
+	OPTION(FLAG_CUBE_THREADS, 1, set_cubethreads),
 	OPTION(NULL, 0, NULL)
 };
  
@@ -209,6 +242,26 @@ struct {
 		INFO_MOVESFORMAT,
 		solve_scramble_exec
 	),
+	COMMAND(
+		"solve_file",
+		"solve_file " FLAG_SOLVER " SOLVER"
+		"[" FLAG_MINMOVES " n] [" FLAG_MAXMOVES " N] "
+		"[" FLAG_THREADS " T] [" FLAG_CUBE_THREADS " C] "
+		"[" FLAG_FILE " FILE]",
+		"Solve the cubes or scrambles in FILE, one per line, using "
+		"SOLVER and using at least n and at most N moves. If FILE is "
+		"not given, read from standard input. T cubes are solved at "
+		"the same time (default: 1), each of them with C threads "
+		"(default: 1 if T is larger than 1, otherwise the number of "
+		"threads chosen when building the library, which is also the "
+		"maximum). For each solution, "
+		"print a line with the input line number, the length of the "
+		"solution, the number of nodes visited, the time in seconds "
+		"and the solution, separated by tabs. The lines are printed as "
+		"soon as the cube is solved, so they may be out of order. "
+		INFO_CUBEFORMAT("Each cube") " " INFO_MOVESFORMAT,
+		solve_file_exec
+	),
 	COMMAND(
 		"countmoves",
 		"countmoves " FLAG_MOVES " MOVES",
@@ -216,6 +269,25 @@ struct {
 		INFO_MOVESFORMAT,
 		countmoves_exec
 	),
+	COMMAND(
+		"arch",
+		"arch",
+		"Print the name of the architecture-specific backend in use.",
+		arch_exec
+	),
+	COMMAND(
+		"server",
+		"server [" FLAG_SOLVER " SOLVERS] [" FLAG_SOCKET " PATH]",
+		"Run the shell as a server: read commands from standard input, "
+		"one per line and with the same syntax as on the command line, "
+		"and write the output of each of them followed by an empty line. "
+		"The data for the solvers is read from file only once and kept "
+		"in memory. SOLVERS is a comma-separated list of solvers whose "
+		"data is loaded at start. If PATH is given, commands are "
+		"read from the connections to a Unix domain socket created at "
+		"PATH instead, and each connection is served by its own thread.",
+		server_exec
+	),
 	COMMAND(
 		"help",
 		"help [" FLAG_COMMAND " COMMAND]",
@@ -233,6 +305,29 @@ char *tablepaths[] = {
 	NULL
 };
 
+/* Data kept in memory in server mode, see get_data() */
+static bool keepdata = false;
+static pthread_mutex_t datamutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dataloaded = PTHREAD_COND_INITIALIZER;
+static int ndata = 0;
+static struct {
+	char solver[MAX_SOLVER_LENGTH];
+	char *buf;
+	int64_t size;
+	bool loading;
+} data[MAX_DATA];
+
+/*
+The number of threads used for each solve is global, see nissy_setthreads().
+The commands that depend on it hold threadslock for reading, while
+solve_file holds it for writing when it uses a different number of threads,
+so that in server mode it does not change the threads used by the commands
+of the other connections. The shell does not change the number of threads
+anywhere else, so outside of solve_file it is the default of the library,
+which is its maximum.
+*/
+static pthread_rwlock_t threadslock = PTHREAD_RWLOCK_INITIALIZER;
+
 static uint64_t
 rand64(void)
 {
@@ -252,7 +347,7 @@ compose_exec(args_t *args)
 
 	ret = nissy_compose(args->cube, args->cube_perm, result);
 	if (ret == NISSY_OK || ret == NISSY_WARNING_UNSOLVABLE)
-		printf("%s\n", result);
+		fprintf(args->out, "%s\n", result);
 
 	return ret;
 }
@@ -265,7 +360,7 @@ inverse_exec(args_t *args)
 
 	ret = nissy_inverse(args->cube, result);
 	if (ret == NISSY_OK || ret == NISSY_WARNING_UNSOLVABLE)
-		printf("%s\n", result);
+		fprintf(args->out, "%s\n", result);
 
 	return ret;
 }
@@ -278,7 +373,7 @@ applymoves_exec(args_t *args)
 
 	ret = nissy_applymoves(args->cube, args->str_moves, result);
 	if (ret == NISSY_OK || ret == NISSY_WARNING_UNSOLVABLE)
-		printf("%s\n", result);
+		fprintf(args->out, "%s\n", result);
 
 	return ret;
 }
@@ -291,7 +386,7 @@ applytrans_exec(args_t *args)
 
 	ret = nissy_applytrans(args->cube, args->str_trans, result);
 	if (ret == NISSY_OK || ret == NISSY_WARNING_UNSOLVABLE)
-		printf("%s\n", result);
+		fprintf(args->out, "%s\n", result);
 
 	return ret;
 }
@@ -312,7 +407,7 @@ convert_exec(args_t *args)
 	ret = nissy_convert(args->str_format_in, args->str_format_out,
 	    args->str_cube, PRINTCUBE_BUFFER_SIZE, result);
 	if (ret == NISSY_OK || ret == NISSY_WARNING_UNSOLVABLE)
-		printf("%s\n", result);
+		fprintf(args->out, "%s\n", result);
 
 	return ret;
 }
@@ -329,7 +424,7 @@ randomcube_exec(args_t *args)
 	co = rand64();
 	ret = nissy_getcube(ep, eo, cp, co, "fix", result);
 	if (ret == NISSY_OK || ret == NISSY_WARNING_UNSOLVABLE)
-		printf("%s\n", result);
+		fprintf(args->out, "%s\n", result);
 
 	return ret;
 }
@@ -342,7 +437,7 @@ datasize_exec(args_t *args)
 	ret = nissy_datasize(args->str_solver);
 	if (ret < 0)
 		fprintf(stderr, "Unknown error (make sure solver is valid)\n");
-	printf("%" PRId64 "\n", ret);
+	fprintf(args->out, "%" PRId64 "\n", ret);
 
 	return ret;
 }
@@ -381,26 +476,33 @@ gendata_exec(args_t *args)
 		return -3;
 	}
 
-	buf = malloc(size);
+	if (nissy_allocdata(size, &buf) < 0) {
+		fprintf(stderr, "Error: could not allocate %" PRId64
+		    " bytes for the data\n", size);
+		fclose(file);
+		return -4;
+	}
 
+	pthread_rwlock_rdlock(&threadslock);
 	ret = nissy_gendata(args->str_solver, size, buf);
+	pthread_rwlock_unlock(&threadslock);
 	if (ret < 0) {
 		fprintf(stderr, "Unknown error in generating data\n");
 		fclose(file);
-		free(buf);
+		nissy_freedata(size, buf);
 		return -4;
 	}
 	if (ret != size) {
 		fprintf(stderr, "Unknown error: unexpected data size "
 		    "got %" PRId64 ", expected %" PRId64 ")\n", ret, size);
 		fclose(file);
-		free(buf);
+		nissy_freedata(size, buf);
 		return -5;
 	}
 
 	written = fwrite(buf, size, 1, file);
 	fclose(file);
-	free(buf);
+	nissy_freedata(size, buf);
 
 	if (written != 1) {
 		fprintf(stderr,
@@ -415,19 +517,14 @@ gendata_exec(args_t *args)
 	return 0;
 }
 
-static int64_t
-solve_exec(args_t *args)
+static char *
+read_data(args_t *args, int64_t *size)
 {
 	int i;
-	uint8_t nissflag;
 	FILE *file;
-	char *buf, solutions[SOLUTIONS_BUFFER_SIZE], path[MAX_PATH_LENGTH];
-	long long stats[NISSY_SIZE_SOLVE_STATS];
-	int64_t ret, gendata_ret, size;
+	char *buf, path[MAX_PATH_LENGTH];
 	size_t read;
 
-	nissflag = NISSY_NISSFLAG_NORMAL; /* TODO: parse str_nisstype */
-
 	for (i = 0; tablepaths[i] != NULL; i++) {
 		strcpy(path, tablepaths[i]);
 		strcat(path, args->str_solver);
@@ -440,9 +537,8 @@ solve_exec(args_t *args)
 		fprintf(stderr,
 		    "Cannot read data file, "
 		    "generating it (this can take a while)\n");
-		gendata_ret = gendata_exec(args);
-		if (gendata_ret)
-			return gendata_ret;
+		if (gendata_exec(args))
+			return NULL;
 	}
 
 	/* Ugh, this is not elegant TODO */
@@ -458,19 +554,112 @@ solve_exec(args_t *args)
 
 	if (tablepaths[i] == NULL) {
 		fprintf(stderr, "Error: data file not found\n");
-		fclose(file);
-		return -1;
+		return NULL;
 	}
 
-	size = nissy_datasize(args->str_solver);
-	buf = malloc(size);
-	read = fread(buf, size, 1, file);
+	*size = nissy_datasize(args->str_solver);
+	if (*size <= 0 || nissy_allocdata(*size, &buf) < 0)
+		buf = NULL;
+	read = buf == NULL ? 0 : fread(buf, *size, 1, file);
 	fclose(file);
 	if (read != 1) {
-  		fprintf(stderr, "Error reading data from file: "
+		fprintf(stderr, "Error reading data from file: "
 		    "fread() returned %zu instead of 1 when attempting to"
-		    "read %" PRId64 " bytes from file %s\n", read, size, path);
-		return -2;
+		    "read %" PRId64 " bytes from file %s\n", read, *size, path);
+		nissy_freedata(*size, buf);
+		return NULL;
+	}
+	nissy_warmup(*size, buf);
+
+	return buf;
+}
+
+/*
+Get the data for the solver. Normally this is read from file every time,
+but in server mode the data is read only once and then kept in memory.
+The data is read without holding datamutex, because it may have to be
+generated first; the other threads that need the same data wait for it,
+while those that need other data are not blocked.
+*/
+static char *
+get_data(args_t *args, int64_t *size)
+{
+	int i;
+	char *buf;
+	int64_t bufsize;
+
+	if (!keepdata)
+		return read_data(args, size);
+
+	pthread_mutex_lock(&datamutex);
+
+	for (i = 0; i < ndata; i++)
+		if (!strcmp(data[i].solver, args->str_solver))
+			break;
+
+	if (i == ndata) {
+		if (ndata == MAX_DATA) {
+			fprintf(stderr, "Error: cannot keep more than %d data "
+			    "tables in memory\n", MAX_DATA);
+			pthread_mutex_unlock(&datamutex);
+			return NULL;
+		}
+		strncpy(data[i].solver, args->str_solver,
+		    MAX_SOLVER_LENGTH - 1);
+		data[i].buf = NULL;
+		data[i].loading = false;
+		ndata++;
+	}
+
+	while (data[i].loading)
+		pthread_cond_wait(&dataloaded, &datamutex);
+
+	/* Not loaded yet, or the last attempt failed */
+	if (data[i].buf == NULL) {
+		data[i].loading = true;
+		pthread_mutex_unlock(&datamutex);
+		buf = read_data(args, &bufsize);
+		pthread_mutex_lock(&datamutex);
+		if (buf != NULL) {
+			fprintf(stderr, "Data for %s loaded\n",
+			    args->str_solver);
+			data[i].size = bufsize;
+		}
+		data[i].buf = buf;
+		data[i].loading = false;
+		pthread_cond_broadcast(&dataloaded);
+	}
+
+	buf = data[i].buf;
+	*size = data[i].size;
+
+	pthread_mutex_unlock(&datamutex);
+
+	return buf;
+}
+
+static void
+release_data(char *buf, int64_t size)
+{
+	if (!keepdata)
+		nissy_freedata(size, buf);
+}
+
+static int64_t
+solve_exec(args_t *args)
+{
+	uint8_t nissflag;
+	char *buf, solutions[SOLUTIONS_BUFFER_SIZE];
+	long long stats[NISSY_SIZE_SOLVE_STATS];
+	int64_t ret, size;
+
+	nissflag = NISSY_NISSFLAG_NORMAL; /* TODO: parse str_nisstype */
+
+	pthread_rwlock_rdlock(&threadslock);
+	buf = get_data(args, &size);
+	if (buf == NULL) {
+		pthread_rwlock_unlock(&threadslock);
+		return -1;
 	}
 
 	ret = nissy_solve(
@@ -478,12 +667,13 @@ solve_exec(args_t *args)
 	    args->maxmoves, args->maxsolutions, args->optimal,
 	    size, buf, SOLUTIONS_BUFFER_SIZE, solutions, stats);
 
-	free(buf);
+	release_data(buf, size);
+	pthread_rwlock_unlock(&threadslock);
 
 	if (ret == NISSY_OK || ret == NISSY_WARNING_UNSOLVABLE)
 		fprintf(stderr, "No solutions found\n");
 	else
-		printf("%s", solutions);
+		fprintf(args->out, "%s", solutions);
 
 	return 0;
 }
@@ -496,6 +686,200 @@ solve_scramble_exec(args_t *args)
 	return solve_exec(args);
 }
 
+/*
+The lines to be solved by solve_file are read by the main thread and put
+in a queue of bounded size, so that memory usage does not depend on the
+size of the input. The solver threads take them from the queue.
+*/
+typedef struct {
+	args_t *args;
+	char *data;
+	int64_t size;
+	pthread_mutex_t mutex;
+	pthread_cond_t notempty;
+	pthread_cond_t notfull;
+	char *lines[SOLVE_QUEUE_SIZE];
+	uint64_t linenumbers[SOLVE_QUEUE_SIZE];
+	int first;
+	int count;
+	bool done;
+} solve_queue_t;
+
+static void
+solve_line(solve_queue_t *queue, uint64_t n, char *line, char *solutions)
+{
+	char cube[NISSY_SIZE_B32], *sol, *next;
+	long long ret, stats[NISSY_SIZE_SOLVE_STATS];
+	double t;
+	struct timespec start, end;
+
+	line[strcspn(line, "\r\n")] = '\0';
+	if (line[0] == '\0')
+		return;
+
+	/* Each line is either a scramble or a cube in B32 format */
+	if (nissy_applymoves(NISSY_SOLVED_CUBE, line, cube) < 0) {
+		strncpy(cube, line, NISSY_SIZE_B32 - 1);
+		cube[NISSY_SIZE_B32 - 1] = '\0';
+	}
+
+	stats[0] = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ret = nissy_solve(cube, queue->args->str_solver, NISSY_NISSFLAG_NORMAL,
+	    queue->args->minmoves, queue->args->maxmoves,
+	    queue->args->maxsolutions, queue->args->optimal,
+	    queue->size, queue->data, SOLUTIONS_BUFFER_SIZE, solutions, stats);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	t = (end.tv_sec - start.tv_sec) + 1e-9 * (end.tv_nsec - start.tv_nsec);
+
+	flockfile(queue->args->out);
+	if (ret < 0 && ret != NISSY_WARNING_UNSOLVABLE) {
+		fprintf(queue->args->out, "%" PRIu64 "\t-\t%lld\t%.6f\t"
+		    "Error %lld\n", n, stats[0], t, ret);
+	} else if (ret <= 0) {
+		fprintf(queue->args->out, "%" PRIu64 "\t-\t%lld\t%.6f\t"
+		    "No solution found\n", n, stats[0], t);
+	}
+	for (sol = solutions; ret > 0 && *sol != '\0'; sol = next + 1) {
+		next = strchr(sol, '\n');
+		*next = '\0';
+		fprintf(queue->args->out, "%" PRIu64 "\t%lld\t%lld\t%.6f\t%s\n",
+		    n, nissy_countmoves(sol), stats[0], t, sol);
+	}
+	fflush(queue->args->out);
+	funlockfile(queue->args->out);
+}
+
+static void *
+solve_file_thread(void *arg)
+{
+	solve_queue_t *queue;
+	char *line, *solutions;
+	uint64_t n;
+
+	queue = arg;
+	solutions = malloc(SOLUTIONS_BUFFER_SIZE);
+	if (solutions == NULL) {
+		fprintf(stderr, "Error: cannot allocate solutions buffer\n");
+		return NULL;
+	}
+
+	while (true) {
+		pthread_mutex_lock(&queue->mutex);
+		while (queue->count == 0 && !queue->done)
+			pthread_cond_wait(&queue->notempty, &queue->mutex);
+		if (queue->count == 0) {
+			pthread_mutex_unlock(&queue->mutex);
+			break;
+		}
+		line = queue->lines[queue->first];
+		n = queue->linenumbers[queue->first];
+		queue->first = (queue->first + 1) % SOLVE_QUEUE_SIZE;
+		queue->count--;
+		pthread_cond_signal(&queue->notfull);
+		pthread_mutex_unlock(&queue->mutex);
+
+		solve_line(queue, n, line, solutions);
+		free(line);
+	}
+
+	free(solutions);
+	return NULL;
+}
+
+static int64_t
+solve_file_exec(args_t *args)
+{
+	unsigned i, started, cubethreads;
+	int64_t ret;
+	uint64_t n;
+	size_t linesize;
+	char *line;
+	FILE *in;
+	pthread_t thread[MAX_SOLVE_THREADS];
+	solve_queue_t queue = {
+		.args = args,
+		.mutex = PTHREAD_MUTEX_INITIALIZER,
+		.notempty = PTHREAD_COND_INITIALIZER,
+		.notfull = PTHREAD_COND_INITIALIZER,
+		.first = 0,
+		.count = 0,
+		.done = false,
+	};
+
+	/* Solving more cubes at the same time uses 1 thread each by default */
+	cubethreads = args->cubethreads > 0 ? args->cubethreads :
+	    args->threads > 1 ? 1 : 0;
+	if (cubethreads > 0)
+		pthread_rwlock_wrlock(&threadslock);
+	else
+		pthread_rwlock_rdlock(&threadslock);
+
+	queue.data = get_data(args, &queue.size);
+	if (queue.data == NULL) {
+		ret = -1;
+		goto solve_file_unlock;
+	}
+
+	if (cubethreads > 0 && nissy_setthreads(cubethreads) < 0) {
+		fprintf(stderr, "Error: cannot use %u threads per cube\n",
+		    cubethreads);
+		ret = -4;
+		goto solve_file_release;
+	}
+
+	in = args->str_file[0] == '\0' ? stdin : fopen(args->str_file, "r");
+	if (in == NULL) {
+		fprintf(stderr, "Error: cannot open file %s\n", args->str_file);
+		ret = -2;
+		goto solve_file_release;
+	}
+
+	for (started = 0; started < args->threads; started++)
+		if (pthread_create(&thread[started], NULL,
+		    solve_file_thread, &queue))
+			break;
+
+	for (n = 1, line = NULL, linesize = 0;
+	    started > 0 && getline(&line, &linesize, in) != -1; n++) {
+		pthread_mutex_lock(&queue.mutex);
+		while (queue.count == SOLVE_QUEUE_SIZE)
+			pthread_cond_wait(&queue.notfull, &queue.mutex);
+		i = (queue.first + queue.count) % SOLVE_QUEUE_SIZE;
+		queue.lines[i] = line;
+		queue.linenumbers[i] = n;
+		queue.count++;
+		pthread_cond_signal(&queue.notempty);
+		pthread_mutex_unlock(&queue.mutex);
+
+		/* The line is now owned by the solver thread */
+		line = NULL;
+		linesize = 0;
+	}
+	free(line);
+
+	pthread_mutex_lock(&queue.mutex);
+	queue.done = true;
+	pthread_cond_broadcast(&queue.notempty);
+	pthread_mutex_unlock(&queue.mutex);
+
+	for (i = 0; i < started; i++)
+		pthread_join(thread[i], NULL);
+
+	if (in != stdin)
+		fclose(in);
+	ret = started > 0 ? 0 : -3;
+
+solve_file_release:
+	release_data(queue.data, queue.size);
+	if (cubethreads > 0)
+		nissy_setthreads(UINT_MAX);
+solve_file_unlock:
+	pthread_rwlock_unlock(&threadslock);
+
+	return ret;
+}
+
 static int64_t
 countmoves_exec(args_t *args)
 {
@@ -504,33 +888,229 @@ countmoves_exec(args_t *args)
 	count = nissy_countmoves(args->str_moves);
 
 	if (count >= 0)
-		printf("%lld\n", count);
+		fprintf(args->out, "%lld\n", count);
 
 	return count >= 0 ? 0 : count;
 }
 
+static int64_t
+arch_exec(args_t *args)
+{
+	int64_t ret;
+	char result[NISSY_SIZE_ARCH];
+
+	ret = nissy_getarch(result);
+	if (ret == NISSY_OK)
+		fprintf(args->out, "%s\n", result);
+
+	return ret;
+}
+
+/*
+Split a line into arguments separated by spaces. An argument can be
+enclosed in double quotes, for example -moves "R U F". The line is
+modified in place.
+*/
+static int
+split_line(char *line, char *argv[static MAX_LINE_ARGS])
+{
+	int argc;
+	char *c;
+
+	for (argc = 0, c = line; argc < MAX_LINE_ARGS; argc++) {
+		while (*c == ' ' || *c == '\t' || *c == '\n' || *c == '\r')
+			c++;
+		if (*c == '\0')
+			break;
+		if (*c == '"') {
+			argv[argc] = ++c;
+			while (*c != '"' && *c != '\0')
+				c++;
+		} else {
+			argv[argc] = c;
+			while (*c != ' ' && *c != '\t' && *c != '\n' &&
+			    *c != '\r' && *c != '\0')
+				c++;
+		}
+		if (*c != '\0')
+			*c++ = '\0';
+	}
+
+	return argc;
+}
+
+static void
+server_line(char *line, FILE *out)
+{
+	int argc;
+	int64_t ret;
+	char *argv[MAX_LINE_ARGS];
+	args_t args;
+
+	argc = split_line(line, argv);
+	if (argc == 0)
+		return;
+
+	if (parse_args(argc, argv, &args)) {
+		fprintf(out, "Error: invalid command\n");
+	} else if (commands[args.command_index].exec == server_exec) {
+		fprintf(out, "Error: already running as a server\n");
+	} else {
+		args.out = out;
+		ret = commands[args.command_index].exec(&args);
+		if (ret != 0)
+			fprintf(out, "Error: command returned %" PRId64 "\n", ret);
+	}
+
+	/* An empty line marks the end of the output */
+	fprintf(out, "\n");
+	fflush(out);
+}
+
+static void
+server_stream(FILE *in, FILE *out)
+{
+	char *line;
+	size_t size;
+
+	for (line = NULL, size = 0; getline(&line, &size, in) != -1; )
+		server_line(line, out);
+
+	free(line);
+}
+
+static void *
+server_connection(void *arg)
+{
+	int fd;
+	FILE *in, *out;
+
+	fd = *(int *)arg;
+	free(arg);
+
+	/* Separate streams, because reads and writes cannot be mixed */
+	in = fdopen(fd, "r");
+	out = fdopen(dup(fd), "w");
+	if (in != NULL && out != NULL)
+		server_stream(in, out);
+	else
+		fprintf(stderr, "Error opening connection: %s\n",
+		    strerror(errno));
+
+	if (out != NULL)
+		fclose(out);
+	if (in != NULL)
+		fclose(in);
+	else
+		close(fd);
+
+	return NULL;
+}
+
+static int64_t
+server_socket(const char *path)
+{
+	int sock, *fd;
+	struct sockaddr_un addr;
+	pthread_t thread;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "Error: socket path %s is too long\n", path);
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path);
+
+	sock = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(path);
+	if (sock == -1 || bind(sock, (struct sockaddr *)&addr, sizeof(addr))
+	    || listen(sock, SOMAXCONN)) {
+		fprintf(stderr, "Error creating socket %s: %s\n",
+		    path, strerror(errno));
+		return -1;
+	}
+
+	/* A client closing its connection early must not stop the server */
+	signal(SIGPIPE, SIG_IGN);
+
+	fprintf(stderr, "Listening on %s\n", path);
+	while (true) {
+		if ((fd = malloc(sizeof(int))) == NULL) {
+			fprintf(stderr, "Error: cannot allocate memory for "
+			    "a new connection\n");
+			close(sock);
+			return -1;
+		}
+		if ((*fd = accept(sock, NULL, NULL)) == -1) {
+			fprintf(stderr, "Error accepting connection: %s\n",
+			    strerror(errno));
+			free(fd);
+			continue;
+		}
+		if (pthread_create(&thread, NULL, server_connection, fd)) {
+			fprintf(stderr, "Error creating thread\n");
+			close(*fd);
+			free(fd);
+			continue;
+		}
+		pthread_detach(thread);
+	}
+
+	return 0;
+}
+
+static int64_t
+server_exec(args_t *args)
+{
+	char *solvers, *solver;
+	int64_t size;
+
+	keepdata = true;
+
+	/* Load the data for the given solvers before accepting commands */
+	for (solvers = args->str_solver;
+	    (solver = strtok_r(solvers, ",", &solvers)) != NULL; ) {
+		args->str_solver = solver;
+		if (get_data(args, &size) == NULL)
+			return -1;
+	}
+
+	if (args->str_socket[0] != '\0')
+		return server_socket(args->str_socket);
+
+	server_stream(stdin, stdout);
+
+	return 0;
+}
+
 static int64_t
 help_exec(args_t *args)
 {
 	int i;
 
 	if (args->str_command == NULL || args->str_command[0] == '\0') {
-		printf("This is a rudimentary shell for the H48 library.\n");
-		printf("Available commands and usage:\n\n");
+		fprintf(args->out,
+		    "This is a rudimentary shell for the H48 library.\n");
+		fprintf(args->out, "Available commands and usage:\n\n");
 		for (i = 0; commands[i].name != NULL; i++)
-			printf("%-15s%s\n", commands[i].name, commands[i].syn);
-		printf("\nUse 'help -command COMMAND' for more information.\n");
+			fprintf(args->out, "%-15s%s\n",
+			    commands[i].name, commands[i].syn);
+		fprintf(args->out,
+		    "\nUse 'help -command COMMAND' for more information.\n");
 	} else {
 		for (i = 0; commands[i].name != NULL; i++)
 			if (!strcmp(args->str_command, commands[i].name))
 				break;
 		if (commands[i].name == NULL) {
-			printf("Unknown command %s\n", args->str_command);
+			fprintf(args->out,
+			    "Unknown command %s\n", args->str_command);
 			return 1;
 		}
-		printf("Command %s\n\n", commands[i].name);
-		printf("Synopsis: %s\n\n", commands[i].syn);
-		printf("Description: %s\n", commands[i].desc);
+		fprintf(args->out, "Command %s\n\n", commands[i].name);
+		fprintf(args->out, "Synopsis: %s\n\n", commands[i].syn);
+		fprintf(args->out, "Description: %s\n", commands[i].desc);
 	}
 
 	return 0;
@@ -557,6 +1137,11 @@ parse_args(int argc, char **argv, args_t *args)
 		.maxmoves = 20,
 		.optimal = -1,
 		.maxsolutions = 1,
+		.str_socket = "",
+		.str_file = "",
+		.threads = 1,
+		.cubethreads = 0,
+		.out = stdout,
 	};
 
 	if (argc == 0) {
@@ -728,6 +1313,36 @@ set_maxsolutions(int argc, char **argv, args_t *args)
 	return parse_uint(argv[0], &args->maxsolutions);
 }
 
+static bool
+set_str_socket(int argc, char **argv, args_t *args)
+{
+	args->str_socket = argv[0];
+
+	return true;
+}
+
+static bool
+set_str_file(int argc, char **argv, args_t *args)
+{
+	args->str_file = argv[0];
+
+	return true;
+}
+
+static bool
+set_threads(int argc, char **argv, args_t *args)
+{
+	return parse_uint(argv[0], &args->threads) &&
+	    args->threads > 0 && args->threads <= MAX_SOLVE_THREADS;
+}
+
+static bool
+set_cubethreads(int argc, char **argv, args_t *args)
+{
+	return parse_uint(argv[0], &args->cubethreads) &&
+	    args->cubethreads > 0;
+}
+
 void
 log_stderr(const char *str, ...)
 {
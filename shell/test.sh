@@ -9,7 +9,21 @@ for cin in "$TESTDIR"/*.in; do
 	c=$(echo "$cin" | sed 's/\.in//')
 	cout="$c.out"
 	printf "%s: " "$c"
-	(cat "$cin" | xargs "$SHELLBIN") > $TESTOUT 2> $TESTERR
+	# If there is a .stdin file, it is given as standard input
+	cstdin="$c.stdin"
+	if [ -f "$cstdin" ]; then
+		eval "$SHELLBIN $(cat "$cin")" < "$cstdin" \
+		    > $TESTOUT 2> $TESTERR
+	else
+		(cat "$cin" | xargs "$SHELLBIN") > $TESTOUT 2> $TESTERR
+	fi
+	# If there is a .filter file, the output is passed through the
+	# command it contains, for example to remove the timings
+	cfilter="$c.filter"
+	if [ -f "$cfilter" ]; then
+		eval "$(cat "$cfilter")" < $TESTOUT > $TESTOUT.tmp
+		mv $TESTOUT.tmp $TESTOUT
+	fi
 	if diff "$cout" "$TESTOUT"; then
 		printf "OK\n"
 	else
@@ -1,4 +1,19 @@
-#if defined(AVX2)
+#if defined(AVX512)
+
+#define ARCH_NAME "AVX512"
+
+#include <immintrin.h>
+
+typedef __m256i cube_t;
+
+#if !defined(TEST_H)
+#include "common.h"
+#include "avx512.h"
+#endif
+
+#elif defined(AVX2)
+
+#define ARCH_NAME "AVX2"
 
 #include <immintrin.h>
 
@@ -11,6 +26,8 @@ typedef __m256i cube_t;
 
 #elif defined(NEON)
 
+#define ARCH_NAME "NEON"
+
 #include <stdlib.h>
 #include <arm_neon.h>
 
@@ -26,11 +43,14 @@ typedef struct {
 
 #else
 
+#define ARCH_NAME "PORTABLE"
+
 #include <stdlib.h>
 
+/* See portable.h for the layout of the pieces */
 typedef struct {
-	uint8_t corner[8];
-	uint8_t edge[12];
+	uint64_t corner;
+	uint64_t edge[2];
 } cube_t;
 
 #if !defined(TEST_H)
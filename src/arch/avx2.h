@@ -38,6 +38,12 @@ equal(cube_t c1, cube_t c2)
 	return mask == ~0;
 }
 
+STATIC_INLINE cube_t
+loadcube(const uint8_t buf[static 32])
+{
+	return _mm256_loadu_si256((const __m256i_u *)buf);
+}
+
 STATIC_INLINE cube_t
 invertco(cube_t c)
 {
@@ -54,6 +60,22 @@ invertco(cube_t c)
         return ret;
 }
 
+STATIC_INLINE cube_t
+invertco_if(cube_t c, bool b)
+{
+	cube_t co, shleft, shright, summed, newco, mask, flip;
+
+	mask = _mm256_set1_epi8(-(int8_t)b);
+	co = _mm256_and_si256(c, CO2_AVX2);
+	shleft = _mm256_slli_epi32(co, 1);
+	shright = _mm256_srli_epi32(co, 1);
+	summed = _mm256_or_si256(shleft, shright);
+	newco = _mm256_and_si256(summed, CO2_AVX2);
+	flip = _mm256_and_si256(_mm256_xor_si256(co, newco), mask);
+
+	return _mm256_xor_si256(c, flip);
+}
+
 STATIC_INLINE cube_t
 compose_epcpeo(cube_t c1, cube_t c2)
 {
@@ -114,6 +136,13 @@ compose(cube_t c1, cube_t c2)
 	return s;
 }
 
+STATIC_INLINE void
+compose_pair(cube_t a1, cube_t b1, cube_t a2, cube_t b2, cube_t ret[static 2])
+{
+	ret[0] = compose(a1, b1);
+	ret[1] = compose(a2, b2);
+}
+
 STATIC_INLINE cube_t
 cleanaftershuffle(cube_t c)
 {
@@ -217,32 +246,15 @@ coord_eo(cube_t c)
 STATIC_INLINE int64_t
 coord_esep(cube_t c)
 {
-	cube_t ep;
-	int64_t e, mem[4], i, j, jj, k, l, ret1, ret2, bit1, bit2, is1;
-
-	ep = _mm256_and_si256(c, EP_AVX2);
-	_mm256_storeu_si256((__m256i *)mem, ep);
-
-	mem[3] <<= 8;
-	ret1 = ret2 = 0;
-	k = l = 4;
-	for (i = 0, j = 0; i < 12; i++, mem[i/8 + 2] >>= 8) {
-		e = mem[i/8 + 2];
-
-		bit1 = (e & ESEPBIT_1) >> 2;
-		bit2 = (e & ESEPBIT_2) >> 3;
-		is1 = (1 - bit2) * bit1;
-
-		ret1 += bit2 * binomial[11-i][k];
-		k -= bit2;
+	uint32_t slice1, slice2;
 
-		jj = j < 8;
-		ret2 += jj * is1 * binomial[7-(j*jj)][l];
-		l -= is1;
-		j += (1-bit2);
-	}
+	/* Move ESEPBIT_2 and ESEPBIT_1 to the highest bit of each byte */
+	slice2 = (uint32_t)_mm256_movemask_epi8(_mm256_slli_epi32(c, 4));
+	slice1 = (uint32_t)_mm256_movemask_epi8(_mm256_slli_epi32(c, 5));
+	slice2 = (slice2 >> 16) & UINT32_C(0xFFF);
+	slice1 = (slice1 >> 16) & UINT32_C(0xFFF) & ~slice2;
 
-	return ret1 * 70 + ret2;
+	return coord_esep_masks(slice1, slice2);
 }
 
 STATIC_INLINE void
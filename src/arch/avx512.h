@@ -0,0 +1,292 @@
+/*
+The AVX512 backend uses the same cube layout as the AVX2 one, so a cube
+fits in a 256-bit register. The AVX512BW and AVX512VL extensions are used
+to replace some sequences of AVX2 instructions with masked or ternary-logic
+ones, and to compose two pairs of cubes at once in a 512-bit register.
+
+Since corners and edges are in different 128-bit lanes, the in-lane byte
+shuffle is already a full permutation of the pieces, so AVX512VBMI is not
+needed.
+*/
+
+#define CO2_AVX512 _mm256_set_epi64x(0, 0, 0, INT64_C(0x6060606060606060))
+#define COCW_AVX512 _mm256_set_epi64x(0, 0, 0, INT64_C(0x2020202020202020))
+#define CP_AVX512 _mm256_set_epi64x(0, 0, 0, INT64_C(0x0707070707070707))
+#define EO_AVX512 \
+    _mm256_set_epi64x(INT64_C(0x10101010), INT64_C(0x1010101010101010), 0, 0)
+#define ORIENT_AVX512 _mm256_or_si256(EO_AVX512, CO2_AVX512)
+
+/* Bytes of a cube that contain a piece (8 corners and 12 edges) */
+#define PIECES_AVX512 ((__mmask32)UINT32_C(0x0FFF00FF))
+#define PIECES_PAIR_AVX512 ((__mmask64)UINT64_C(0x0FFF00FF0FFF00FF))
+
+#define CO2_PAIR_AVX512 _mm512_broadcast_i64x4(CO2_AVX512)
+#define COCW_PAIR_AVX512 _mm512_broadcast_i64x4(COCW_AVX512)
+#define EO_PAIR_AVX512 _mm512_broadcast_i64x4(EO_AVX512)
+
+/* Truth tables for _mm256_ternarylogic_epi32(a, b, c, ...) */
+#define TERNLOG_OR_AND 0xA8     /* (a | b) & c */
+#define TERNLOG_ANDNOT_OR 0xBA  /* (a & ~b) | c */
+#define TERNLOG_XOR_AND 0x78    /* a ^ (b & c) */
+#define TERNLOG_SELECT 0xD8     /* (a & ~c) | (b & c) */
+
+#define STATIC_CUBE(c_ufr, c_ubl, c_dfl, c_dbr, c_ufl, c_ubr, c_dfr, c_dbl, \
+    e_uf, e_ub, e_db, e_df, e_ur, e_ul, e_dl, e_dr, e_fr, e_fl, e_bl, e_br) \
+    _mm256_set_epi8(0, 0, 0, 0, e_br, e_bl, e_fl, e_fr, \
+        e_dr, e_dl, e_ul, e_ur, e_df, e_db, e_ub, e_uf, \
+        0, 0, 0, 0, 0, 0, 0, 0, \
+        c_dbl, c_dfr, c_ubr, c_ufl, c_dbr, c_dfl, c_ubl, c_ufr)
+#define ZERO_CUBE _mm256_set_epi64x(0, 0, 0, 0)
+#define SOLVED_CUBE STATIC_CUBE( \
+    0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11)
+
+STATIC void
+pieces(cube_t *cube, uint8_t c[static 8], uint8_t e[static 12])
+{
+	uint8_t aux[32];
+
+	_mm256_storeu_si256((__m256i_u *)aux, *cube);
+	memcpy(c, aux, 8);
+	memcpy(e, aux+16, 12);
+}
+
+STATIC_INLINE bool
+equal(cube_t c1, cube_t c2)
+{
+	return _mm256_cmpneq_epi8_mask(c1, c2) == 0;
+}
+
+STATIC_INLINE cube_t
+loadcube(const uint8_t buf[static 32])
+{
+	return _mm256_loadu_si256((const __m256i_u *)buf);
+}
+
+STATIC_INLINE cube_t
+invertco(cube_t c)
+{
+	cube_t co, shleft, shright, newco;
+
+	co = _mm256_and_si256(c, CO2_AVX512);
+	shleft = _mm256_slli_epi32(co, 1);
+	shright = _mm256_srli_epi32(co, 1);
+	newco = _mm256_ternarylogic_epi32(
+	    shleft, shright, CO2_AVX512, TERNLOG_OR_AND);
+
+	return _mm256_ternarylogic_epi32(
+	    c, CO2_AVX512, newco, TERNLOG_ANDNOT_OR);
+}
+
+STATIC_INLINE cube_t
+invertco_if(cube_t c, bool b)
+{
+	__mmask32 mask;
+
+	mask = (__mmask32)(-(uint32_t)b);
+
+	return _mm256_mask_mov_epi8(c, mask, invertco(c));
+}
+
+STATIC_INLINE cube_t
+compose_epcpeo(cube_t c1, cube_t c2)
+{
+	cube_t s;
+
+	/* Permute and clean unused bits */
+	s = _mm256_maskz_shuffle_epi8(PIECES_AVX512, c1, c2);
+
+	/* Change EO */
+	return _mm256_ternarylogic_epi32(s, c2, EO_AVX512, TERNLOG_XOR_AND);
+}
+
+STATIC_INLINE cube_t
+compose_edges(cube_t c1, cube_t c2)
+{
+	return compose_epcpeo(c1, c2);
+}
+
+STATIC_INLINE cube_t
+compose_corners(cube_t c1, cube_t c2)
+{
+	return compose(c1, c2);
+}
+
+STATIC_INLINE cube_t
+compose(cube_t c1, cube_t c2)
+{
+	cube_t s, co1, co2, aux, auy1, auy2, auz1;
+
+	s = compose_epcpeo(c1, c2);
+
+	/* Change CO */
+	co1 = _mm256_and_si256(s, CO2_AVX512);
+	co2 = _mm256_and_si256(c2, CO2_AVX512);
+	aux = _mm256_add_epi8(co1, co2);
+	auy1 = _mm256_add_epi8(aux, COCW_AVX512);
+	auy2 = _mm256_srli_epi32(auy1, 2);
+	auz1 = _mm256_add_epi8(aux, auy2);
+
+	/* Put together */
+	return _mm256_ternarylogic_epi32(s, auz1, CO2_AVX512, TERNLOG_SELECT);
+}
+
+STATIC_INLINE void
+compose_pair(cube_t a1, cube_t b1, cube_t a2, cube_t b2, cube_t ret[static 2])
+{
+	__m512i c1, c2, s, co1, co2, aux, auy1, auy2, auz1;
+
+	c1 = _mm512_inserti64x4(_mm512_castsi256_si512(a1), a2, 1);
+	c2 = _mm512_inserti64x4(_mm512_castsi256_si512(b1), b2, 1);
+
+	/* Same as compose(), on both halves of the register */
+	s = _mm512_maskz_shuffle_epi8(PIECES_PAIR_AVX512, c1, c2);
+	s = _mm512_ternarylogic_epi32(s, c2, EO_PAIR_AVX512, TERNLOG_XOR_AND);
+	co1 = _mm512_and_si512(s, CO2_PAIR_AVX512);
+	co2 = _mm512_and_si512(c2, CO2_PAIR_AVX512);
+	aux = _mm512_add_epi8(co1, co2);
+	auy1 = _mm512_add_epi8(aux, COCW_PAIR_AVX512);
+	auy2 = _mm512_srli_epi32(auy1, 2);
+	auz1 = _mm512_add_epi8(aux, auy2);
+	s = _mm512_ternarylogic_epi32(
+	    s, auz1, CO2_PAIR_AVX512, TERNLOG_SELECT);
+
+	ret[0] = _mm512_castsi512_si256(s);
+	ret[1] = _mm512_extracti64x4_epi64(s, 1);
+}
+
+STATIC_INLINE cube_t
+cleanaftershuffle(cube_t c)
+{
+	return _mm256_maskz_mov_epi8(PIECES_AVX512, c);
+}
+
+STATIC_INLINE cube_t
+inverse(cube_t c)
+{
+	/* Same method as in the AVX2 version, see avx2.h */
+	cube_t v3, vi, vo, vp, ret;
+
+	v3 = _mm256_shuffle_epi8(c, c);
+	v3 = _mm256_shuffle_epi8(v3, c);
+	vi = _mm256_shuffle_epi8(v3, v3);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, v3);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, c);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, v3);
+	vi = _mm256_shuffle_epi8(vi, vi);
+	vi = _mm256_shuffle_epi8(vi, c);
+
+	vo = _mm256_and_si256(c, ORIENT_AVX512);
+	vo = _mm256_maskz_shuffle_epi8(PIECES_AVX512, vo, vi);
+	vp = _mm256_andnot_si256(ORIENT_AVX512, vi);
+	ret = _mm256_or_si256(vp, vo);
+	ret = cleanaftershuffle(ret);
+
+	return invertco(ret);
+}
+
+STATIC_INLINE int64_t
+coord_co(cube_t c)
+{
+	cube_t co;
+	int64_t mem[4], ret, i, p;
+
+	co = _mm256_and_si256(c, CO2_AVX512);
+	_mm256_storeu_si256((__m256i *)mem, co);
+
+	mem[0] >>= 5;
+	for (i = 0, ret = 0, p = 1; i < 7; i++, mem[0] >>= 8, p *= 3)
+		ret += (mem[0] & 3) * p;
+
+	return ret;
+}
+
+STATIC_INLINE int64_t
+coord_csep(cube_t c)
+{
+	__mmask32 mask;
+
+	mask = _mm256_test_epi8_mask(c, _mm256_set1_epi8(CSEPBIT));
+
+	return mask & 0x7F;
+}
+
+STATIC_INLINE int64_t
+coord_cocsep(cube_t c)
+{
+	return (coord_co(c) << 7) + coord_csep(c);
+}
+
+STATIC_INLINE int64_t
+coord_eo(cube_t c)
+{
+	__mmask32 mask;
+
+	mask = _mm256_test_epi8_mask(c, EO_AVX512);
+
+	return mask >> 17;
+}
+
+STATIC_INLINE int64_t
+coord_esep(cube_t c)
+{
+	uint32_t slice1, slice2;
+
+	slice2 = _mm256_test_epi8_mask(c, _mm256_set1_epi8(ESEPBIT_2)) >> 16;
+	slice1 = _mm256_test_epi8_mask(c, _mm256_set1_epi8(ESEPBIT_1)) >> 16;
+	slice2 &= UINT32_C(0xFFF);
+	slice1 &= UINT32_C(0xFFF) & ~slice2;
+
+	return coord_esep_masks(slice1, slice2);
+}
+
+STATIC_INLINE void
+copy_corners(cube_t *dest, cube_t src)
+{
+	*dest = _mm256_blend_epi32(*dest, src, 0x0F);
+}
+
+STATIC_INLINE void
+copy_edges(cube_t *dest, cube_t src)
+{
+	*dest = _mm256_blend_epi32(*dest, src, 0xF0);
+}
+
+STATIC_INLINE void
+set_eo(cube_t *cube, int64_t eo)
+{
+	int64_t eo12;
+	__m256i veo;
+
+	/* The i-th bit of eo12 is the orientation of the i-th edge */
+	eo12 = (eo << 1) + (_mm_popcnt_u64(eo) % 2);
+	veo = _mm256_maskz_set1_epi8((__mmask32)(eo12 << 16), EOBIT);
+
+	*cube = _mm256_andnot_si256(EO_AVX512, *cube);
+	*cube = _mm256_or_si256(*cube, veo);
+}
+
+STATIC_INLINE cube_t
+invcoord_esep(int64_t esep)
+{
+	cube_t eee, ret;
+	uint8_t mem[32] = {0};
+
+	invcoord_esep_array(esep % 70, esep / 70, mem+16);
+
+	ret = SOLVED_CUBE;
+	eee = _mm256_loadu_si256((__m256i_u *)&mem);
+	copy_edges(&ret, eee);
+
+	return ret;
+}
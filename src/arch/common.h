@@ -1,9 +1,13 @@
 STATIC void pieces(cube_t *, uint8_t [static 8], uint8_t [static 12]);
 STATIC_INLINE bool equal(cube_t, cube_t);
+STATIC_INLINE cube_t loadcube(const uint8_t [static 32]);
 STATIC_INLINE cube_t invertco(cube_t);
+STATIC_INLINE cube_t invertco_if(cube_t, bool);
 STATIC_INLINE cube_t compose_edges(cube_t, cube_t);
 STATIC_INLINE cube_t compose_corners(cube_t, cube_t);
 STATIC_INLINE cube_t compose(cube_t, cube_t);
+STATIC_INLINE void compose_pair(
+    cube_t, cube_t, cube_t, cube_t, cube_t [static 2]);
 STATIC_INLINE cube_t inverse(cube_t);
 
 STATIC_INLINE int64_t coord_co(cube_t);
@@ -17,30 +21,87 @@ STATIC_INLINE void copy_edges(cube_t *, cube_t);
 STATIC_INLINE void set_eo(cube_t *, int64_t);
 STATIC_INLINE cube_t invcoord_esep(int64_t);
 
+STATIC_INLINE void prefetch(const void *);
+STATIC_INLINE uint32_t compress_bits(uint32_t, uint32_t);
+STATIC_INLINE uint32_t deposit_bits(uint32_t, uint32_t);
+STATIC_INLINE int64_t coord_esep_masks(uint32_t, uint32_t);
 STATIC_INLINE void invcoord_esep_array(int64_t, int64_t, uint8_t[static 12]);
 
+/* Start loading the memory at p into the cache, if the compiler allows it */
+STATIC_INLINE void
+prefetch(const void *p)
+{
+#if defined(__GNUC__)
+	__builtin_prefetch(p);
+#else
+	(void)p;
+#endif
+}
+
+/* Same as the BMI2 instruction pext, with a fallback */
+STATIC_INLINE uint32_t
+compress_bits(uint32_t x, uint32_t mask)
+{
+#if defined(__BMI2__) && (defined(AVX2) || defined(AVX512))
+	return _pext_u32(x, mask);
+#else
+	uint32_t ret, bit, low;
+
+	for (ret = 0, bit = 1; mask != 0; mask &= mask - 1, bit <<= 1) {
+		low = mask & -mask;
+		ret |= (x & low) ? bit : 0;
+	}
+
+	return ret;
+#endif
+}
+
+/* Same as the BMI2 instruction pdep, with a fallback */
+STATIC_INLINE uint32_t
+deposit_bits(uint32_t x, uint32_t mask)
+{
+#if defined(__BMI2__) && (defined(AVX2) || defined(AVX512))
+	return _pdep_u32(x, mask);
+#else
+	uint32_t ret, bit, low;
+
+	for (ret = 0, bit = 1; mask != 0; mask &= mask - 1, bit <<= 1) {
+		low = mask & -mask;
+		ret |= (x & bit) ? low : 0;
+	}
+
+	return ret;
+#endif
+}
+
+/*
+The esep coordinate of a cube whose E-slice edges are in the positions
+marked in the 12-bit mask slice2, and whose S-slice edges are in the
+positions marked in slice1 (see the esep tables in constants.h).
+*/
+STATIC_INLINE int64_t
+coord_esep_masks(uint32_t slice1, uint32_t slice2)
+{
+	uint32_t slice1_in8;
+
+	slice1_in8 = compress_bits(slice1, ~slice2 & UINT32_C(0xFFF));
+
+	return esep_rank12[slice2] * COMB_8_4 + esep_rank8[slice1_in8];
+}
+
 STATIC_INLINE void
 invcoord_esep_array(int64_t set1, int64_t set2, uint8_t mem[static 12])
 {
-	int64_t bit1, bit2, i, j, jj, k, l, s, v, w, is1;
-	uint8_t slice[3] = {0};
-
-	for (i = 0, j = 0, k = 4, l = 4; i < 12; i++)
-	{
-		v = binomial[11 - i][k];
-		jj = j < 8;
-		w = jj * binomial[7 - (j * jj)][l];
-		bit2 = set2 >= v;
-		bit1 = set1 >= w;
-		is1 = (1 - bit2) * bit1;
-
-		set2 -= bit2 * v;
-		k -= bit2;
-		set1 -= is1 * w;
-		l -= is1;
-		j += (1 - bit2);
-		s = 2 * bit2 + (1 - bit2) * bit1;
-
-		mem[i] = (slice[s]++) | (uint8_t)(s << 2);
+	uint32_t slice1, slice2, next, s, i;
+
+	slice2 = esep_unrank12[set2];
+	slice1 = deposit_bits(esep_unrank8[set1], ~slice2 & UINT32_C(0xFFF));
+
+	/* The s-th byte of next is the next free piece of slice s */
+	next = UINT32_C(0x080400);
+	for (i = 0; i < 12; i++) {
+		s = 2 * ((slice2 >> i) & 1) + ((slice1 >> i) & 1);
+		mem[i] = (uint8_t)(next >> (8 * s));
+		next += UINT32_C(1) << (8 * s);
 	}
 }
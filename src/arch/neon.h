@@ -59,6 +59,17 @@ equal(cube_t c1, cube_t c2)
 	return vgetq_lane_u64(cmp_result, 0) == ~0ULL && vgetq_lane_u64(cmp_result, 1) == ~0ULL;
 }
 
+STATIC_INLINE cube_t
+loadcube(const uint8_t buf[static 32])
+{
+	cube_t ret;
+
+	ret.corner = vld1_u8(buf);
+	ret.edge = vld1q_u8(buf + 16);
+
+	return ret;
+}
+
 STATIC_INLINE cube_t
 invertco(cube_t c)
 {
@@ -77,6 +88,25 @@ invertco(cube_t c)
 	return ret;
 }
 
+STATIC_INLINE cube_t
+invertco_if(cube_t c, bool b)
+{
+	cube_t ret;
+	uint8x8_t co, shleft, shright, summed, newco, mask, flip;
+
+	mask = vdup_n_u8((uint8_t)(-(int8_t)b));
+	co = vand_u8(c.corner, CO2_NEON);
+	shleft = vshl_n_u8(co, 1);
+	shright = vshr_n_u8(co, 1);
+	summed = vorr_u8(shleft, shright);
+	newco = vand_u8(summed, CO2_NEON);
+	flip = vand_u8(veor_u8(co, newco), mask);
+	ret.corner = veor_u8(c.corner, flip);
+	ret.edge = c.edge;
+
+	return ret;
+}
+
 STATIC_INLINE cube_t
 compose_edges(cube_t c1, cube_t c2)
 {
@@ -151,6 +181,13 @@ compose(cube_t c1, cube_t c2)
 	return ret;
 }
 
+STATIC_INLINE void
+compose_pair(cube_t a1, cube_t b1, cube_t a2, cube_t b2, cube_t ret[static 2])
+{
+	ret[0] = compose(a1, b1);
+	ret[1] = compose(a2, b2);
+}
+
 STATIC_INLINE cube_t
 inverse(cube_t cube)
 {
@@ -250,28 +287,18 @@ coord_eo(cube_t c)
 STATIC_INLINE int64_t
 coord_esep(cube_t c)
 {
-	int64_t i, j, jj, k, l, ret1, ret2, bit1, bit2, is1;
+	uint32_t i, slice1, slice2;
 
 	// Temp array to store the NEON vector
 	uint8_t mem[16];
 	vst1q_u8(mem, c.edge);
 
-	for (i = 0, j = 0, k = 4, l = 4, ret1 = 0, ret2 = 0; i < 12; i++)
-	{
-		bit1 = (mem[i] & ESEPBIT_1) >> 2;
-		bit2 = (mem[i] & ESEPBIT_2) >> 3;
-		is1 = (1 - bit2) * bit1;
-
-		ret1 += bit2 * binomial[11 - i][k];
-		k -= bit2;
-
-		jj = j < 8;
-		ret2 += jj * is1 * binomial[7 - (j * jj)][l];
-		l -= is1;
-		j += (1 - bit2);
+	for (i = 0, slice1 = 0, slice2 = 0; i < 12; i++) {
+		slice2 |= (uint32_t)((mem[i] & ESEPBIT_2) >> 3) << i;
+		slice1 |= (uint32_t)((mem[i] & ESEPBIT_1) >> 2) << i;
 	}
 
-	return ret1 * 70 + ret2;
+	return coord_esep_masks(slice1 & ~slice2, slice2);
 }
 
 STATIC_INLINE void
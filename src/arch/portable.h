@@ -1,88 +1,197 @@
+/*
+The portable backend packs the pieces in 64-bit words, so that most
+operations can work on all of them at once using only integer arithmetic
+(SWAR, "SIMD within a register"). The i-th corner is byte i of the corner
+word, and the i-th edge is byte i%8 of edge[i/8]; the 4 most significant
+bytes of edge[1] are unused and always zero. Pieces are always accessed
+with shifts, so this does not depend on the endianness of the machine.
+
+The orientation arithmetic never carries from one byte to the next,
+because each piece only uses the 7 least significant bits of its byte.
+*/
+
+#define BYTES_PORTABLE(b0, b1, b2, b3, b4, b5, b6, b7) ( \
+    (uint64_t)(b0) | (uint64_t)(b1) << 8 | (uint64_t)(b2) << 16 | \
+    (uint64_t)(b3) << 24 | (uint64_t)(b4) << 32 | (uint64_t)(b5) << 40 | \
+    (uint64_t)(b6) << 48 | (uint64_t)(b7) << 56)
+
+/* Repeat a byte 8 times, or only in the 7 or 4 least significant bytes */
+#define REPEAT_PORTABLE(b) (UINT64_C(0x0101010101010101) * (b))
+#define REPEAT7_PORTABLE(b) (UINT64_C(0x0001010101010101) * (b))
+#define REPEAT4_PORTABLE(b) (UINT64_C(0x0000000001010101) * (b))
+
 #define STATIC_CUBE(c_ufr, c_ubl, c_dfl, c_dbr, c_ufl, c_ubr, c_dfr, c_dbl, \
     e_uf, e_ub, e_db, e_df, e_ur, e_ul, e_dl, e_dr, e_fr, e_fl, e_bl, e_br) \
     ((cube_t) { \
-        .corner = { c_ufr, c_ubl, c_dfl, c_dbr, c_ufl, c_ubr, c_dfr, c_dbl }, \
-        .edge = { e_uf, e_ub, e_db, e_df, e_ur, e_ul, \
-                  e_dl, e_dr, e_fr, e_fl, e_bl, e_br } })
+        .corner = BYTES_PORTABLE(c_ufr, c_ubl, c_dfl, c_dbr, \
+                                 c_ufl, c_ubr, c_dfr, c_dbl), \
+        .edge = { BYTES_PORTABLE(e_uf, e_ub, e_db, e_df, \
+                                 e_ur, e_ul, e_dl, e_dr), \
+                  BYTES_PORTABLE(e_fr, e_fl, e_bl, e_br, 0, 0, 0, 0) } })
 #define ZERO_CUBE STATIC_CUBE( \
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0)
 #define SOLVED_CUBE STATIC_CUBE( \
     0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11)
 
-STATIC void
-pieces(cube_t *cube, uint8_t c[static 8], uint8_t e[static 12])
+STATIC_INLINE uint64_t loadbytes_portable(const uint8_t *, uint8_t);
+STATIC_INLINE void storebytes_portable(uint64_t, uint8_t *, uint8_t);
+STATIC_INLINE uint8_t getbyte_portable(uint64_t, uint8_t);
+STATIC_INLINE uint64_t gather_portable(uint64_t, uint64_t, uint64_t, uint8_t);
+STATIC_INLINE uint32_t packbits_portable(uint64_t);
+STATIC_INLINE uint64_t spreadbits_portable(uint32_t);
+STATIC_INLINE uint64_t invertco_word_portable(uint64_t);
+
+STATIC_INLINE uint64_t
+loadbytes_portable(const uint8_t *buf, uint8_t n)
 {
-	memcpy(c, cube->corner, 8);
-	memcpy(e, cube->edge, 12);
+	uint8_t i;
+	uint64_t ret;
+
+	for (i = 0, ret = 0; i < n; i++)
+		ret |= (uint64_t)buf[i] << (8 * i);
+
+	return ret;
 }
 
-STATIC_INLINE bool
-equal(cube_t c1, cube_t c2)
+STATIC_INLINE void
+storebytes_portable(uint64_t w, uint8_t *buf, uint8_t n)
 {
 	uint8_t i;
-	bool ret;
 
-	ret = true;
-	for (i = 0; i < 8; i++)
-		ret = ret && c1.corner[i] == c2.corner[i];
-	for (i = 0; i < 12; i++)
-		ret = ret && c1.edge[i] == c2.edge[i];
+	for (i = 0; i < n; i++)
+		buf[i] = getbyte_portable(w, i);
+}
+
+STATIC_INLINE uint8_t
+getbyte_portable(uint64_t w, uint8_t i)
+{
+	return (uint8_t)(w >> (8 * i));
+}
+
+/*
+Byte i of the result, for i < n, is the byte of the 16-byte word (lo, hi)
+whose index is the permutation part of byte i of perm.
+*/
+STATIC_INLINE uint64_t
+gather_portable(uint64_t lo, uint64_t hi, uint64_t perm, uint8_t n)
+{
+	uint8_t i, b[16];
+	uint64_t ret;
+
+	storebytes_portable(lo, b, 8);
+	storebytes_portable(hi, b + 8, 8);
+	for (i = 0, ret = 0; i < n; i++)
+		ret |= (uint64_t)b[getbyte_portable(perm, i) & PBITS] << (8 * i);
 
 	return ret;
 }
 
+/*
+Gather the least significant bit of each byte of w in the low 8 bits of
+the result. The other bits of w must be zero. The multiplication moves
+the bit of byte i to bit 56+i without any carry, see for example
+https://graphics.stanford.edu/~seander/bithacks.html
+*/
+STATIC_INLINE uint32_t
+packbits_portable(uint64_t w)
+{
+	return (uint32_t)((w * UINT64_C(0x0102040810204080)) >> 56);
+}
+
+/* The inverse of packbits_portable() for the low 8 bits of x */
+STATIC_INLINE uint64_t
+spreadbits_portable(uint32_t x)
+{
+	uint64_t w;
+
+	/* Byte i is either 0 or 1 << i, and adding 0x7F sets bit 7 if not 0 */
+	w = REPEAT_PORTABLE(x & 0xFF) & UINT64_C(0x8040201008040201);
+	w = (w + REPEAT_PORTABLE(0x7F)) & REPEAT_PORTABLE(0x80);
+
+	return w >> 7;
+}
+
+STATIC_INLINE uint64_t
+invertco_word_portable(uint64_t w)
+{
+	uint64_t orien;
+
+	orien = ((w << 1) | (w >> 1)) & REPEAT_PORTABLE(COBITS_2);
+
+	return (w & ~REPEAT_PORTABLE(COBITS_2)) | orien;
+}
+
+STATIC void
+pieces(cube_t *cube, uint8_t c[static 8], uint8_t e[static 12])
+{
+	storebytes_portable(cube->corner, c, 8);
+	storebytes_portable(cube->edge[0], e, 8);
+	storebytes_portable(cube->edge[1], e + 8, 4);
+}
+
+STATIC_INLINE bool
+equal(cube_t c1, cube_t c2)
+{
+	return ((c1.corner ^ c2.corner) |
+	    (c1.edge[0] ^ c2.edge[0]) | (c1.edge[1] ^ c2.edge[1])) == 0;
+}
+
 STATIC_INLINE cube_t
-invertco(cube_t c)
+loadcube(const uint8_t buf[static 32])
 {
-	uint8_t i, piece, orien;
 	cube_t ret;
 
-	ret = c;
-	for (i = 0; i < 8; i++) {
-		piece = c.corner[i];
-		orien = ((piece << 1) | (piece >> 1)) & COBITS_2;
-		ret.corner[i] = (piece & PBITS) | orien;
-	}
+	ret.corner = loadbytes_portable(buf, 8);
+	ret.edge[0] = loadbytes_portable(buf + 16, 8);
+	ret.edge[1] = loadbytes_portable(buf + 24, 4);
 
 	return ret;
 }
 
-STATIC_INLINE void
-compose_edges_inplace(cube_t c1, cube_t c2, cube_t *ret)
+STATIC_INLINE cube_t
+invertco(cube_t c)
 {
-	uint8_t i, piece1, piece2, p, orien;
+	c.corner = invertco_word_portable(c.corner);
 
-	for (i = 0; i < 12; i++) {
-		piece2 = c2.edge[i];
-		p = piece2 & PBITS;
-		piece1 = c1.edge[p];
-		orien = (piece2 ^ piece1) & EOBIT;
-		ret->edge[i] = (piece1 & PBITS) | orien;
-	}
+	return c;
 }
 
-STATIC_INLINE void
-compose_corners_inplace(cube_t c1, cube_t c2, cube_t *ret)
+STATIC_INLINE cube_t
+invertco_if(cube_t c, bool b)
 {
-	uint8_t i, piece1, piece2, p, orien, aux, auy;
+	uint64_t mask;
 
-	for (i = 0; i < 8; i++) {
-		piece2 = c2.corner[i];
-		p = piece2 & PBITS;
-		piece1 = c1.corner[p];
-		aux = (piece2 & COBITS) + (piece1 & COBITS);
-		auy = (aux + CTWIST_CW) >> 2;
-		orien = (aux + auy) & COBITS_2;
-		ret->corner[i] = (piece1 & PBITS) | orien;
-	}
+	mask = -(uint64_t)b;
+	c.corner ^= (c.corner ^ invertco_word_portable(c.corner)) & mask;
+
+	return c;
 }
 
+/*
+The edges are composed one at a time, as before the pieces were packed in
+words: this measured faster than gathering them with gather_portable() and
+fixing the orientation of the whole word. Only the edges of c1 are read at
+random positions, so only they are unpacked.
+*/
 STATIC_INLINE cube_t
 compose_edges(cube_t c1, cube_t c2)
 {
-	cube_t ret = ZERO_CUBE;
+	uint8_t i, piece1, piece2, p, orien, e1[12];
+	cube_t ret;
+
+	storebytes_portable(c1.edge[0], e1, 8);
+	storebytes_portable(c1.edge[1], e1 + 8, 4);
 
-	compose_edges_inplace(c1, c2, &ret);
+	ret.corner = 0;
+	ret.edge[0] = ret.edge[1] = 0;
+	for (i = 0; i < 12; i++) {
+		piece2 = getbyte_portable(c2.edge[i / 8], i % 8);
+		p = piece2 & PBITS;
+		piece1 = e1[p];
+		orien = (piece2 ^ piece1) & EOBIT;
+		ret.edge[i / 8] |=
+		    (uint64_t)((piece1 & PBITS) | orien) << (8 * (i % 8));
+	}
 
 	return ret;
 }
@@ -90,9 +199,17 @@ compose_edges(cube_t c1, cube_t c2)
 STATIC_INLINE cube_t
 compose_corners(cube_t c1, cube_t c2)
 {
+	uint64_t piece1, aux, auy, orien;
 	cube_t ret = ZERO_CUBE;
 
-	compose_corners_inplace(c1, c2, &ret);
+	piece1 = gather_portable(c1.corner, 0, c2.corner, 8);
+
+	/* Same as compose() in avx2.h, see there for an explanation */
+	aux = (c2.corner & REPEAT_PORTABLE(COBITS)) +
+	    (piece1 & REPEAT_PORTABLE(COBITS));
+	auy = (aux + REPEAT_PORTABLE(CTWIST_CW)) >> 2;
+	orien = (aux + auy) & REPEAT_PORTABLE(COBITS_2);
+	ret.corner = (piece1 & REPEAT_PORTABLE(PBITS)) | orien;
 
 	return ret;
 }
@@ -100,45 +217,63 @@ compose_corners(cube_t c1, cube_t c2)
 STATIC_INLINE cube_t
 compose(cube_t c1, cube_t c2)
 {
-	cube_t ret = ZERO_CUBE;
+	cube_t ret;
 
-	compose_edges_inplace(c1, c2, &ret);
-	compose_corners_inplace(c1, c2, &ret);
+	ret = compose_edges(c1, c2);
+	ret.corner = compose_corners(c1, c2).corner;
 
 	return ret;
 }
 
-cube_t
+STATIC_INLINE void
+compose_pair(cube_t a1, cube_t b1, cube_t a2, cube_t b2, cube_t ret[static 2])
+{
+	ret[0] = compose(a1, b1);
+	ret[1] = compose(a2, b2);
+}
+
+STATIC_INLINE cube_t
 inverse(cube_t cube)
 {
-	uint8_t i, piece, orien;
+	uint8_t i, piece, c[8], e[12];
+	uint64_t corner;
 	cube_t ret;
 
+	/*
+	Scattering the pieces cannot be done with shifts without long
+	dependency chains, so we use byte arrays for the permutation.
+	*/
 	for (i = 0; i < 12; i++) {
-		piece = cube.edge[i];
-		orien = piece & EOBIT;
-		ret.edge[piece & PBITS] = i | orien;
+		piece = getbyte_portable(cube.edge[i >> 3], i & 7);
+		e[piece & PBITS] = i | (piece & EOBIT);
 	}
 
+	corner = invertco_word_portable(cube.corner);
 	for (i = 0; i < 8; i++) {
-		piece = cube.corner[i];
-		orien = ((piece << 1) | (piece >> 1)) & COBITS_2;
-		ret.corner[piece & PBITS] = i | orien;
+		piece = getbyte_portable(corner, i);
+		c[piece & PBITS] = i | (piece & COBITS_2);
 	}
 
+	ret.corner = loadbytes_portable(c, 8);
+	ret.edge[0] = loadbytes_portable(e, 8);
+	ret.edge[1] = loadbytes_portable(e + 8, 4);
+
 	return ret;
 }
 
 STATIC_INLINE int64_t
 coord_co(cube_t c)
 {
-	int i, p;
-	int64_t ret;
+	uint64_t w;
 
-	for (ret = 0, i = 0, p = 1; i < 7; i++, p *= 3)
-		ret += p * (c.corner[i] >> COSHIFT);
+	/* Evaluate sum(co[i] * 3^i) pairing up 8, 16 and 32-bit lanes */
+	w = (c.corner >> COSHIFT) & REPEAT7_PORTABLE(3);
+	w = (w & UINT64_C(0x00FF00FF00FF00FF)) +
+	    3 * ((w >> 8) & UINT64_C(0x00FF00FF00FF00FF));
+	w = (w & UINT64_C(0x0000FFFF0000FFFF)) +
+	    9 * ((w >> 16) & UINT64_C(0x0000FFFF0000FFFF));
 
-	return ret;
+	return (int64_t)((w & UINT64_C(0xFFFFFFFF)) + 81 * (w >> 32));
 }
 
 /*
@@ -151,13 +286,7 @@ of space, but we are not going to use this coordinate in large tables.
 STATIC_INLINE int64_t
 coord_csep(cube_t c)
 {
-	int i, p;
-	int64_t ret;
-
-	for (ret = 0, i = 0, p = 1; i < 7; i++, p *= 2)
-		ret += p * ((c.corner[i] & CSEPBIT) >> 2);
-
-	return ret;
+	return packbits_portable((c.corner >> 2) & REPEAT7_PORTABLE(1));
 }
 
 STATIC_INLINE int64_t
@@ -169,13 +298,13 @@ coord_cocsep(cube_t c)
 STATIC_INLINE int64_t
 coord_eo(cube_t c)
 {
-	int i, p;
-	int64_t ret;
+	uint32_t eo;
 
-	for (ret = 0, i = 1, p = 1; i < 12; i++, p *= 2)
-		ret += p * (c.edge[i] >> EOSHIFT);
+	eo = packbits_portable((c.edge[0] >> EOSHIFT) & REPEAT_PORTABLE(1));
+	eo |= packbits_portable((c.edge[1] >> EOSHIFT) & REPEAT4_PORTABLE(1))
+	    << 8;
 
-	return ret;
+	return eo >> 1;
 }
 
 /*
@@ -185,67 +314,56 @@ It can be seen as the composition of two "subset index" coordinates.
 STATIC_INLINE int64_t
 coord_esep(cube_t c)
 {
-	int64_t i, j, jj, k, l, ret1, ret2, bit1, bit2, is1;
-
-	for (i = 0, j = 0, k = 4, l = 4, ret1 = 0, ret2 = 0; i < 12; i++) {
-		/* Simple version:
-		if (c.edge[i] & ESEPBIT_2) {
-			ret1 += binomial[11-i][k--];
-		} else {
-			if (c.edge[i] & ESEPBIT_1)
-				ret2 += binomial[7-j][l--];
-			j++;
-		}
-		*/
-
-		bit1 = (c.edge[i] & ESEPBIT_1) >> 2;
-		bit2 = (c.edge[i] & ESEPBIT_2) >> 3;
-		is1 = (1 - bit2) * bit1;
-
-		ret1 += bit2 * binomial[11-i][k];
-		k -= bit2;
-
-		jj = j < 8;
-		ret2 += jj * is1 * binomial[7-(j*jj)][l];
-		l -= is1;
-		j += (1-bit2);
-	}
+	uint32_t slice1, slice2;
+
+	slice2 = packbits_portable((c.edge[0] >> 3) & REPEAT_PORTABLE(1)) |
+	    packbits_portable((c.edge[1] >> 3) & REPEAT4_PORTABLE(1)) << 8;
+	slice1 = packbits_portable((c.edge[0] >> 2) & REPEAT_PORTABLE(1)) |
+	    packbits_portable((c.edge[1] >> 2) & REPEAT4_PORTABLE(1)) << 8;
 
-	return ret1 * 70 + ret2;
+	return coord_esep_masks(slice1 & ~slice2, slice2);
 }
 
 STATIC_INLINE void
 copy_corners(cube_t *dest, cube_t src)
 {
-	memcpy(&dest->corner, src.corner, sizeof(src.corner));
+	dest->corner = src.corner;
 }
 
 STATIC_INLINE void
 copy_edges(cube_t *dest, cube_t src)
 {
-	memcpy(&dest->edge, src.edge, sizeof(src.edge));
+	dest->edge[0] = src.edge[0];
+	dest->edge[1] = src.edge[1];
 }
 
 STATIC_INLINE void
 set_eo(cube_t *cube, int64_t eo)
 {
-	uint8_t i, sum, flip;
+	uint32_t eo12, parity, shift;
 
-	for (sum = 0, i = 1; i < 12; i++, eo >>= 1) {
-		flip = eo % 2;
-		sum += flip;
-		cube->edge[i] = (cube->edge[i] & ~EOBIT) | (EOBIT * flip);
-	}
-	cube->edge[0] = (cube->edge[0] & ~EOBIT) | (EOBIT * (sum % 2));
+	/* The i-th bit of eo12 is the orientation of the i-th edge */
+	for (parity = (uint32_t)eo, shift = 16; shift > 0; shift >>= 1)
+		parity ^= parity >> shift;
+	eo12 = ((uint32_t)eo << 1) | (parity & 1);
+
+	cube->edge[0] = (cube->edge[0] & ~REPEAT_PORTABLE(EOBIT)) |
+	    (spreadbits_portable(eo12) << EOSHIFT);
+	cube->edge[1] = (cube->edge[1] & ~REPEAT4_PORTABLE(EOBIT)) |
+	    (spreadbits_portable(eo12 >> 8) << EOSHIFT);
 }
 
 STATIC_INLINE cube_t
 invcoord_esep(int64_t esep)
 {
+	uint8_t mem[12];
 	cube_t ret;
 
+	invcoord_esep_array(esep % 70, esep / 70, mem);
+
 	ret = SOLVED_CUBE;
-	invcoord_esep_array(esep % 70, esep / 70, ret.edge);
+	ret.edge[0] = loadbytes_portable(mem, 8);
+	ret.edge[1] = loadbytes_portable(mem + 8, 4);
 
 	return ret;
 }
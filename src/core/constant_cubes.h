@@ -227,3 +227,297 @@
     37, 39, 38, 36, 67, 65, 64, 66, 11, 10, 9, 8, 17, 18, 19, 16, 20, 23, 22, 21)
 #define TRANS_CUBE_BLm_INVERSE STATIC_CUBE( \
     38, 37, 39, 36, 67, 64, 66, 65, 23, 20, 21, 22, 24, 27, 26, 25, 3, 2, 1, 0)
+
+/*
+The same transformation cubes as above, as arrays indexed by transformation.
+Each cube is stored as 32 bytes, with the corners in the first 8 and the
+edges starting at byte 16, so that it can be loaded with loadcube() by any
+architecture without branching on the transformation.
+*/
+#define CUBE_BYTES(c_ufr, c_ubl, c_dfl, c_dbr, c_ufl, c_ubr, c_dfr, c_dbl, \
+    e_uf, e_ub, e_db, e_df, e_ur, e_ul, e_dl, e_dr, e_fr, e_fl, e_bl, e_br) \
+    { c_ufr, c_ubl, c_dfl, c_dbr, c_ufl, c_ubr, c_dfr, c_dbl, \
+      0, 0, 0, 0, 0, 0, 0, 0, \
+      e_uf, e_ub, e_db, e_df, e_ur, e_ul, e_dl, e_dr, \
+      e_fr, e_fl, e_bl, e_br, 0, 0, 0, 0 }
+
+_Alignas(32) STATIC const uint8_t trans_cube_table[48][32] = {
+	[TRANS_UFr] = CUBE_BYTES(
+	    0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11),
+	[TRANS_ULr] = CUBE_BYTES(
+	    4, 5, 7, 6, 1, 0, 2, 3, 5, 4, 7, 6, 0, 1, 2, 3, 25, 26, 27, 24),
+	[TRANS_UBr] = CUBE_BYTES(
+	    1, 0, 3, 2, 5, 4, 7, 6, 1, 0, 3, 2, 5, 4, 7, 6, 10, 11, 8, 9),
+	[TRANS_URr] = CUBE_BYTES(
+	    5, 4, 6, 7, 0, 1, 3, 2, 4, 5, 6, 7, 1, 0, 3, 2, 27, 24, 25, 26),
+	[TRANS_DFr] = CUBE_BYTES(
+	    2, 3, 0, 1, 6, 7, 4, 5, 3, 2, 1, 0, 6, 7, 4, 5, 9, 8, 11, 10),
+	[TRANS_DLr] = CUBE_BYTES(
+	    7, 6, 4, 5, 2, 3, 1, 0, 6, 7, 4, 5, 2, 3, 0, 1, 26, 25, 24, 27),
+	[TRANS_DBr] = CUBE_BYTES(
+	    3, 2, 1, 0, 7, 6, 5, 4, 2, 3, 0, 1, 7, 6, 5, 4, 11, 10, 9, 8),
+	[TRANS_DRr] = CUBE_BYTES(
+	    6, 7, 5, 4, 3, 2, 0, 1, 7, 6, 5, 4, 3, 2, 1, 0, 24, 27, 26, 25),
+	[TRANS_RUr] = CUBE_BYTES(
+	    64, 67, 65, 66, 37, 38, 36, 39, 20, 23, 22, 21, 24, 27, 26, 25, 0, 1, 2, 3),
+	[TRANS_RFr] = CUBE_BYTES(
+	    38, 37, 36, 39, 64, 67, 66, 65, 24, 27, 26, 25, 23, 20, 21, 22, 19, 16, 17, 18),
+	[TRANS_RDr] = CUBE_BYTES(
+	    67, 64, 66, 65, 38, 37, 39, 36, 23, 20, 21, 22, 27, 24, 25, 26, 2, 3, 0, 1),
+	[TRANS_RBr] = CUBE_BYTES(
+	    37, 38, 39, 36, 67, 64, 65, 66, 27, 24, 25, 26, 20, 23, 22, 21, 17, 18, 19, 16),
+	[TRANS_LUr] = CUBE_BYTES(
+	    65, 66, 64, 67, 36, 39, 37, 38, 21, 22, 23, 20, 26, 25, 24, 27, 1, 0, 3, 2),
+	[TRANS_LFr] = CUBE_BYTES(
+	    36, 39, 38, 37, 66, 65, 64, 67, 25, 26, 27, 24, 21, 22, 23, 20, 16, 19, 18, 17),
+	[TRANS_LDr] = CUBE_BYTES(
+	    66, 65, 67, 64, 39, 36, 38, 37, 22, 21, 20, 23, 25, 26, 27, 24, 3, 2, 1, 0),
+	[TRANS_LBr] = CUBE_BYTES(
+	    39, 36, 37, 38, 65, 66, 67, 64, 26, 25, 24, 27, 22, 21, 20, 23, 18, 17, 16, 19),
+	[TRANS_FUr] = CUBE_BYTES(
+	    68, 70, 69, 71, 32, 34, 33, 35, 16, 19, 18, 17, 9, 8, 11, 10, 5, 4, 7, 6),
+	[TRANS_FRr] = CUBE_BYTES(
+	    32, 34, 35, 33, 70, 68, 69, 71, 8, 9, 10, 11, 16, 19, 18, 17, 20, 23, 22, 21),
+	[TRANS_FDr] = CUBE_BYTES(
+	    70, 68, 71, 69, 34, 32, 35, 33, 19, 16, 17, 18, 8, 9, 10, 11, 7, 6, 5, 4),
+	[TRANS_FLr] = CUBE_BYTES(
+	    34, 32, 33, 35, 68, 70, 71, 69, 9, 8, 11, 10, 19, 16, 17, 18, 22, 21, 20, 23),
+	[TRANS_BUr] = CUBE_BYTES(
+	    69, 71, 68, 70, 33, 35, 32, 34, 17, 18, 19, 16, 11, 10, 9, 8, 4, 5, 6, 7),
+	[TRANS_BRr] = CUBE_BYTES(
+	    35, 33, 32, 34, 69, 71, 70, 68, 11, 10, 9, 8, 18, 17, 16, 19, 23, 20, 21, 22),
+	[TRANS_BDr] = CUBE_BYTES(
+	    71, 69, 70, 68, 35, 33, 34, 32, 18, 17, 16, 19, 10, 11, 8, 9, 6, 7, 4, 5),
+	[TRANS_BLr] = CUBE_BYTES(
+	    33, 35, 34, 32, 71, 69, 68, 70, 10, 11, 8, 9, 17, 18, 19, 16, 21, 22, 23, 20),
+	[TRANS_UFm] = CUBE_BYTES(
+	    4, 5, 6, 7, 0, 1, 2, 3, 0, 1, 2, 3, 5, 4, 7, 6, 9, 8, 11, 10),
+	[TRANS_ULm] = CUBE_BYTES(
+	    0, 1, 3, 2, 5, 4, 6, 7, 4, 5, 6, 7, 0, 1, 2, 3, 24, 27, 26, 25),
+	[TRANS_UBm] = CUBE_BYTES(
+	    5, 4, 7, 6, 1, 0, 3, 2, 1, 0, 3, 2, 4, 5, 6, 7, 11, 10, 9, 8),
+	[TRANS_URm] = CUBE_BYTES(
+	    1, 0, 2, 3, 4, 5, 7, 6, 5, 4, 7, 6, 1, 0, 3, 2, 26, 25, 24, 27),
+	[TRANS_DFm] = CUBE_BYTES(
+	    6, 7, 4, 5, 2, 3, 0, 1, 3, 2, 1, 0, 7, 6, 5, 4, 8, 9, 10, 11),
+	[TRANS_DLm] = CUBE_BYTES(
+	    3, 2, 0, 1, 6, 7, 5, 4, 7, 6, 5, 4, 2, 3, 0, 1, 27, 24, 25, 26),
+	[TRANS_DBm] = CUBE_BYTES(
+	    7, 6, 5, 4, 3, 2, 1, 0, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9),
+	[TRANS_DRm] = CUBE_BYTES(
+	    2, 3, 1, 0, 7, 6, 4, 5, 6, 7, 4, 5, 3, 2, 1, 0, 25, 26, 27, 24),
+	[TRANS_RUm] = CUBE_BYTES(
+	    68, 71, 69, 70, 33, 34, 32, 35, 21, 22, 23, 20, 25, 26, 27, 24, 0, 1, 2, 3),
+	[TRANS_RFm] = CUBE_BYTES(
+	    34, 33, 32, 35, 68, 71, 70, 69, 25, 26, 27, 24, 22, 21, 20, 23, 19, 16, 17, 18),
+	[TRANS_RDm] = CUBE_BYTES(
+	    71, 68, 70, 69, 34, 33, 35, 32, 22, 21, 20, 23, 26, 25, 24, 27, 2, 3, 0, 1),
+	[TRANS_RBm] = CUBE_BYTES(
+	    33, 34, 35, 32, 71, 68, 69, 70, 26, 25, 24, 27, 21, 22, 23, 20, 17, 18, 19, 16),
+	[TRANS_LUm] = CUBE_BYTES(
+	    69, 70, 68, 71, 32, 35, 33, 34, 20, 23, 22, 21, 27, 24, 25, 26, 1, 0, 3, 2),
+	[TRANS_LFm] = CUBE_BYTES(
+	    32, 35, 34, 33, 70, 69, 68, 71, 24, 27, 26, 25, 20, 23, 22, 21, 16, 19, 18, 17),
+	[TRANS_LDm] = CUBE_BYTES(
+	    70, 69, 71, 68, 35, 32, 34, 33, 23, 20, 21, 22, 24, 27, 26, 25, 3, 2, 1, 0),
+	[TRANS_LBm] = CUBE_BYTES(
+	    35, 32, 33, 34, 69, 70, 71, 68, 27, 24, 25, 26, 23, 20, 21, 22, 18, 17, 16, 19),
+	[TRANS_FUm] = CUBE_BYTES(
+	    64, 66, 65, 67, 36, 38, 37, 39, 16, 19, 18, 17, 8, 9, 10, 11, 4, 5, 6, 7),
+	[TRANS_FRm] = CUBE_BYTES(
+	    36, 38, 39, 37, 66, 64, 65, 67, 9, 8, 11, 10, 16, 19, 18, 17, 21, 22, 23, 20),
+	[TRANS_FDm] = CUBE_BYTES(
+	    66, 64, 67, 65, 38, 36, 39, 37, 19, 16, 17, 18, 9, 8, 11, 10, 6, 7, 4, 5),
+	[TRANS_FLm] = CUBE_BYTES(
+	    38, 36, 37, 39, 64, 66, 67, 65, 8, 9, 10, 11, 19, 16, 17, 18, 23, 20, 21, 22),
+	[TRANS_BUm] = CUBE_BYTES(
+	    65, 67, 64, 66, 37, 39, 36, 38, 17, 18, 19, 16, 10, 11, 8, 9, 5, 4, 7, 6),
+	[TRANS_BRm] = CUBE_BYTES(
+	    39, 37, 36, 38, 65, 67, 66, 64, 10, 11, 8, 9, 18, 17, 16, 19, 22, 21, 20, 23),
+	[TRANS_BDm] = CUBE_BYTES(
+	    67, 65, 66, 64, 39, 37, 38, 36, 18, 17, 16, 19, 11, 10, 9, 8, 7, 6, 5, 4),
+	[TRANS_BLm] = CUBE_BYTES(
+	    37, 39, 38, 36, 67, 65, 64, 66, 11, 10, 9, 8, 17, 18, 19, 16, 20, 23, 22, 21),
+};
+
+_Alignas(32) STATIC const uint8_t trans_cube_inverse_table[48][32] = {
+	[TRANS_UFr] = CUBE_BYTES(
+	    0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11),
+	[TRANS_ULr] = CUBE_BYTES(
+	    5, 4, 6, 7, 0, 1, 3, 2, 4, 5, 6, 7, 1, 0, 3, 2, 27, 24, 25, 26),
+	[TRANS_UBr] = CUBE_BYTES(
+	    1, 0, 3, 2, 5, 4, 7, 6, 1, 0, 3, 2, 5, 4, 7, 6, 10, 11, 8, 9),
+	[TRANS_URr] = CUBE_BYTES(
+	    4, 5, 7, 6, 1, 0, 2, 3, 5, 4, 7, 6, 0, 1, 2, 3, 25, 26, 27, 24),
+	[TRANS_DFr] = CUBE_BYTES(
+	    2, 3, 0, 1, 6, 7, 4, 5, 3, 2, 1, 0, 6, 7, 4, 5, 9, 8, 11, 10),
+	[TRANS_DLr] = CUBE_BYTES(
+	    7, 6, 4, 5, 2, 3, 1, 0, 6, 7, 4, 5, 2, 3, 0, 1, 26, 25, 24, 27),
+	[TRANS_DBr] = CUBE_BYTES(
+	    3, 2, 1, 0, 7, 6, 5, 4, 2, 3, 0, 1, 7, 6, 5, 4, 11, 10, 9, 8),
+	[TRANS_DRr] = CUBE_BYTES(
+	    6, 7, 5, 4, 3, 2, 0, 1, 7, 6, 5, 4, 3, 2, 1, 0, 24, 27, 26, 25),
+	[TRANS_RUr] = CUBE_BYTES(
+	    32, 34, 35, 33, 70, 68, 69, 71, 8, 9, 10, 11, 16, 19, 18, 17, 20, 23, 22, 21),
+	[TRANS_RFr] = CUBE_BYTES(
+	    36, 39, 38, 37, 66, 65, 64, 67, 25, 26, 27, 24, 21, 22, 23, 20, 16, 19, 18, 17),
+	[TRANS_RDr] = CUBE_BYTES(
+	    33, 35, 34, 32, 71, 69, 68, 70, 10, 11, 8, 9, 17, 18, 19, 16, 21, 22, 23, 20),
+	[TRANS_RBr] = CUBE_BYTES(
+	    37, 38, 39, 36, 67, 64, 65, 66, 27, 24, 25, 26, 20, 23, 22, 21, 17, 18, 19, 16),
+	[TRANS_LUr] = CUBE_BYTES(
+	    34, 32, 33, 35, 68, 70, 71, 69, 9, 8, 11, 10, 19, 16, 17, 18, 22, 21, 20, 23),
+	[TRANS_LFr] = CUBE_BYTES(
+	    38, 37, 36, 39, 64, 67, 66, 65, 24, 27, 26, 25, 23, 20, 21, 22, 19, 16, 17, 18),
+	[TRANS_LDr] = CUBE_BYTES(
+	    35, 33, 32, 34, 69, 71, 70, 68, 11, 10, 9, 8, 18, 17, 16, 19, 23, 20, 21, 22),
+	[TRANS_LBr] = CUBE_BYTES(
+	    39, 36, 37, 38, 65, 66, 67, 64, 26, 25, 24, 27, 22, 21, 20, 23, 18, 17, 16, 19),
+	[TRANS_FUr] = CUBE_BYTES(
+	    68, 70, 69, 71, 32, 34, 33, 35, 16, 19, 18, 17, 9, 8, 11, 10, 5, 4, 7, 6),
+	[TRANS_FRr] = CUBE_BYTES(
+	    64, 67, 65, 66, 37, 38, 36, 39, 20, 23, 22, 21, 24, 27, 26, 25, 0, 1, 2, 3),
+	[TRANS_FDr] = CUBE_BYTES(
+	    69, 71, 68, 70, 33, 35, 32, 34, 17, 18, 19, 16, 11, 10, 9, 8, 4, 5, 6, 7),
+	[TRANS_FLr] = CUBE_BYTES(
+	    65, 66, 64, 67, 36, 39, 37, 38, 21, 22, 23, 20, 26, 25, 24, 27, 1, 0, 3, 2),
+	[TRANS_BUr] = CUBE_BYTES(
+	    70, 68, 71, 69, 34, 32, 35, 33, 19, 16, 17, 18, 8, 9, 10, 11, 7, 6, 5, 4),
+	[TRANS_BRr] = CUBE_BYTES(
+	    66, 65, 67, 64, 39, 36, 38, 37, 22, 21, 20, 23, 25, 26, 27, 24, 3, 2, 1, 0),
+	[TRANS_BDr] = CUBE_BYTES(
+	    71, 69, 70, 68, 35, 33, 34, 32, 18, 17, 16, 19, 10, 11, 8, 9, 6, 7, 4, 5),
+	[TRANS_BLr] = CUBE_BYTES(
+	    67, 64, 66, 65, 38, 37, 39, 36, 23, 20, 21, 22, 27, 24, 25, 26, 2, 3, 0, 1),
+	[TRANS_UFm] = CUBE_BYTES(
+	    4, 5, 6, 7, 0, 1, 2, 3, 0, 1, 2, 3, 5, 4, 7, 6, 9, 8, 11, 10),
+	[TRANS_ULm] = CUBE_BYTES(
+	    0, 1, 3, 2, 5, 4, 6, 7, 4, 5, 6, 7, 0, 1, 2, 3, 24, 27, 26, 25),
+	[TRANS_UBm] = CUBE_BYTES(
+	    5, 4, 7, 6, 1, 0, 3, 2, 1, 0, 3, 2, 4, 5, 6, 7, 11, 10, 9, 8),
+	[TRANS_URm] = CUBE_BYTES(
+	    1, 0, 2, 3, 4, 5, 7, 6, 5, 4, 7, 6, 1, 0, 3, 2, 26, 25, 24, 27),
+	[TRANS_DFm] = CUBE_BYTES(
+	    6, 7, 4, 5, 2, 3, 0, 1, 3, 2, 1, 0, 7, 6, 5, 4, 8, 9, 10, 11),
+	[TRANS_DLm] = CUBE_BYTES(
+	    2, 3, 1, 0, 7, 6, 4, 5, 6, 7, 4, 5, 3, 2, 1, 0, 25, 26, 27, 24),
+	[TRANS_DBm] = CUBE_BYTES(
+	    7, 6, 5, 4, 3, 2, 1, 0, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9),
+	[TRANS_DRm] = CUBE_BYTES(
+	    3, 2, 0, 1, 6, 7, 5, 4, 7, 6, 5, 4, 2, 3, 0, 1, 27, 24, 25, 26),
+	[TRANS_RUm] = CUBE_BYTES(
+	    70, 68, 69, 71, 32, 34, 35, 33, 8, 9, 10, 11, 19, 16, 17, 18, 23, 20, 21, 22),
+	[TRANS_RFm] = CUBE_BYTES(
+	    66, 65, 64, 67, 36, 39, 38, 37, 25, 26, 27, 24, 22, 21, 20, 23, 19, 16, 17, 18),
+	[TRANS_RDm] = CUBE_BYTES(
+	    71, 69, 68, 70, 33, 35, 34, 32, 10, 11, 8, 9, 18, 17, 16, 19, 22, 21, 20, 23),
+	[TRANS_RBm] = CUBE_BYTES(
+	    67, 64, 65, 66, 37, 38, 39, 36, 27, 24, 25, 26, 23, 20, 21, 22, 18, 17, 16, 19),
+	[TRANS_LUm] = CUBE_BYTES(
+	    68, 70, 71, 69, 34, 32, 33, 35, 9, 8, 11, 10, 16, 19, 18, 17, 21, 22, 23, 20),
+	[TRANS_LFm] = CUBE_BYTES(
+	    64, 67, 66, 65, 38, 37, 36, 39, 24, 27, 26, 25, 20, 23, 22, 21, 16, 19, 18, 17),
+	[TRANS_LDm] = CUBE_BYTES(
+	    69, 71, 70, 68, 35, 33, 32, 34, 11, 10, 9, 8, 17, 18, 19, 16, 20, 23, 22, 21),
+	[TRANS_LBm] = CUBE_BYTES(
+	    65, 66, 67, 64, 39, 36, 37, 38, 26, 25, 24, 27, 21, 22, 23, 20, 17, 18, 19, 16),
+	[TRANS_FUm] = CUBE_BYTES(
+	    32, 34, 33, 35, 68, 70, 69, 71, 16, 19, 18, 17, 8, 9, 10, 11, 4, 5, 6, 7),
+	[TRANS_FRm] = CUBE_BYTES(
+	    37, 38, 36, 39, 64, 67, 65, 66, 20, 23, 22, 21, 27, 24, 25, 26, 1, 0, 3, 2),
+	[TRANS_FDm] = CUBE_BYTES(
+	    33, 35, 32, 34, 69, 71, 68, 70, 17, 18, 19, 16, 10, 11, 8, 9, 5, 4, 7, 6),
+	[TRANS_FLm] = CUBE_BYTES(
+	    36, 39, 37, 38, 65, 66, 64, 67, 21, 22, 23, 20, 25, 26, 27, 24, 0, 1, 2, 3),
+	[TRANS_BUm] = CUBE_BYTES(
+	    34, 32, 35, 33, 70, 68, 71, 69, 19, 16, 17, 18, 9, 8, 11, 10, 6, 7, 4, 5),
+	[TRANS_BRm] = CUBE_BYTES(
+	    39, 36, 38, 37, 66, 65, 67, 64, 22, 21, 20, 23, 26, 25, 24, 27, 2, 3, 0, 1),
+	[TRANS_BDm] = CUBE_BYTES(
+	    35, 33, 34, 32, 71, 69, 70, 68, 18, 17, 16, 19, 11, 10, 9, 8, 7, 6, 5, 4),
+	[TRANS_BLm] = CUBE_BYTES(
+	    38, 37, 39, 36, 67, 64, 66, 65, 23, 20, 21, 22, 24, 27, 26, 25, 3, 2, 1, 0),
+};
+
+/*
+The move cubes as arrays indexed by move, in the same format as the
+transformation cubes above. The premove table contains, for each move,
+the cube of its inverse, so that premove(c, m) = compose(premove[m], c).
+*/
+_Alignas(32) STATIC const uint8_t move_cube_table[18][32] = {
+	[MOVE_U] = CUBE_BYTES(
+	    5, 4, 2, 3, 0, 1, 6, 7, 4, 5, 2, 3, 1, 0, 6, 7, 8, 9, 10, 11),
+	[MOVE_U2] = CUBE_BYTES(
+	    1, 0, 2, 3, 5, 4, 6, 7, 1, 0, 2, 3, 5, 4, 6, 7, 8, 9, 10, 11),
+	[MOVE_U3] = CUBE_BYTES(
+	    4, 5, 2, 3, 1, 0, 6, 7, 5, 4, 2, 3, 0, 1, 6, 7, 8, 9, 10, 11),
+	[MOVE_D] = CUBE_BYTES(
+	    0, 1, 7, 6, 4, 5, 2, 3, 0, 1, 7, 6, 4, 5, 2, 3, 8, 9, 10, 11),
+	[MOVE_D2] = CUBE_BYTES(
+	    0, 1, 3, 2, 4, 5, 7, 6, 0, 1, 3, 2, 4, 5, 7, 6, 8, 9, 10, 11),
+	[MOVE_D3] = CUBE_BYTES(
+	    0, 1, 6, 7, 4, 5, 3, 2, 0, 1, 6, 7, 4, 5, 3, 2, 8, 9, 10, 11),
+	[MOVE_R] = CUBE_BYTES(
+	    70, 1, 2, 69, 4, 32, 35, 7, 0, 1, 2, 3, 8, 5, 6, 11, 7, 9, 10, 4),
+	[MOVE_R2] = CUBE_BYTES(
+	    3, 1, 2, 0, 4, 6, 5, 7, 0, 1, 2, 3, 7, 5, 6, 4, 11, 9, 10, 8),
+	[MOVE_R3] = CUBE_BYTES(
+	    69, 1, 2, 70, 4, 35, 32, 7, 0, 1, 2, 3, 11, 5, 6, 8, 4, 9, 10, 7),
+	[MOVE_L] = CUBE_BYTES(
+	    0, 71, 68, 3, 33, 5, 6, 34, 0, 1, 2, 3, 4, 10, 9, 7, 8, 5, 6, 11),
+	[MOVE_L2] = CUBE_BYTES(
+	    0, 2, 1, 3, 7, 5, 6, 4, 0, 1, 2, 3, 4, 6, 5, 7, 8, 10, 9, 11),
+	[MOVE_L3] = CUBE_BYTES(
+	    0, 68, 71, 3, 34, 5, 6, 33, 0, 1, 2, 3, 4, 9, 10, 7, 8, 6, 5, 11),
+	[MOVE_F] = CUBE_BYTES(
+	    36, 1, 38, 3, 66, 5, 64, 7, 25, 1, 2, 24, 4, 5, 6, 7, 16, 19, 10, 11),
+	[MOVE_F2] = CUBE_BYTES(
+	    2, 1, 0, 3, 6, 5, 4, 7, 3, 1, 2, 0, 4, 5, 6, 7, 9, 8, 10, 11),
+	[MOVE_F3] = CUBE_BYTES(
+	    38, 1, 36, 3, 64, 5, 66, 7, 24, 1, 2, 25, 4, 5, 6, 7, 19, 16, 10, 11),
+	[MOVE_B] = CUBE_BYTES(
+	    0, 37, 2, 39, 4, 67, 6, 65, 0, 27, 26, 3, 4, 5, 6, 7, 8, 9, 17, 18),
+	[MOVE_B2] = CUBE_BYTES(
+	    0, 3, 2, 1, 4, 7, 6, 5, 0, 2, 1, 3, 4, 5, 6, 7, 8, 9, 11, 10),
+	[MOVE_B3] = CUBE_BYTES(
+	    0, 39, 2, 37, 4, 65, 6, 67, 0, 26, 27, 3, 4, 5, 6, 7, 8, 9, 18, 17),
+};
+
+_Alignas(32) STATIC const uint8_t premove_cube_table[18][32] = {
+	[MOVE_U] = CUBE_BYTES(
+	    4, 5, 2, 3, 1, 0, 6, 7, 5, 4, 2, 3, 0, 1, 6, 7, 8, 9, 10, 11),
+	[MOVE_U2] = CUBE_BYTES(
+	    1, 0, 2, 3, 5, 4, 6, 7, 1, 0, 2, 3, 5, 4, 6, 7, 8, 9, 10, 11),
+	[MOVE_U3] = CUBE_BYTES(
+	    5, 4, 2, 3, 0, 1, 6, 7, 4, 5, 2, 3, 1, 0, 6, 7, 8, 9, 10, 11),
+	[MOVE_D] = CUBE_BYTES(
+	    0, 1, 6, 7, 4, 5, 3, 2, 0, 1, 6, 7, 4, 5, 3, 2, 8, 9, 10, 11),
+	[MOVE_D2] = CUBE_BYTES(
+	    0, 1, 3, 2, 4, 5, 7, 6, 0, 1, 3, 2, 4, 5, 7, 6, 8, 9, 10, 11),
+	[MOVE_D3] = CUBE_BYTES(
+	    0, 1, 7, 6, 4, 5, 2, 3, 0, 1, 7, 6, 4, 5, 2, 3, 8, 9, 10, 11),
+	[MOVE_R] = CUBE_BYTES(
+	    69, 1, 2, 70, 4, 35, 32, 7, 0, 1, 2, 3, 11, 5, 6, 8, 4, 9, 10, 7),
+	[MOVE_R2] = CUBE_BYTES(
+	    3, 1, 2, 0, 4, 6, 5, 7, 0, 1, 2, 3, 7, 5, 6, 4, 11, 9, 10, 8),
+	[MOVE_R3] = CUBE_BYTES(
+	    70, 1, 2, 69, 4, 32, 35, 7, 0, 1, 2, 3, 8, 5, 6, 11, 7, 9, 10, 4),
+	[MOVE_L] = CUBE_BYTES(
+	    0, 68, 71, 3, 34, 5, 6, 33, 0, 1, 2, 3, 4, 9, 10, 7, 8, 6, 5, 11),
+	[MOVE_L2] = CUBE_BYTES(
+	    0, 2, 1, 3, 7, 5, 6, 4, 0, 1, 2, 3, 4, 6, 5, 7, 8, 10, 9, 11),
+	[MOVE_L3] = CUBE_BYTES(
+	    0, 71, 68, 3, 33, 5, 6, 34, 0, 1, 2, 3, 4, 10, 9, 7, 8, 5, 6, 11),
+	[MOVE_F] = CUBE_BYTES(
+	    38, 1, 36, 3, 64, 5, 66, 7, 24, 1, 2, 25, 4, 5, 6, 7, 19, 16, 10, 11),
+	[MOVE_F2] = CUBE_BYTES(
+	    2, 1, 0, 3, 6, 5, 4, 7, 3, 1, 2, 0, 4, 5, 6, 7, 9, 8, 10, 11),
+	[MOVE_F3] = CUBE_BYTES(
+	    36, 1, 38, 3, 66, 5, 64, 7, 25, 1, 2, 24, 4, 5, 6, 7, 16, 19, 10, 11),
+	[MOVE_B] = CUBE_BYTES(
+	    0, 39, 2, 37, 4, 65, 6, 67, 0, 26, 27, 3, 4, 5, 6, 7, 8, 9, 18, 17),
+	[MOVE_B2] = CUBE_BYTES(
+	    0, 3, 2, 1, 4, 7, 6, 5, 0, 2, 1, 3, 4, 5, 6, 7, 8, 9, 11, 10),
+	[MOVE_B3] = CUBE_BYTES(
+	    0, 37, 2, 39, 4, 67, 6, 65, 0, 27, 26, 3, 4, 5, 6, 7, 8, 9, 17, 18),
+};
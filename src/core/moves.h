@@ -2,14 +2,19 @@
 #define PREMOVE(M, c) compose(MOVE_CUBE_ ## M, c)
 
 STATIC_INLINE bool allowednextmove(uint8_t *, uint8_t);
+STATIC uint32_t allowednextmove_h48(uint8_t *, uint8_t, uint8_t);
 
 STATIC_INLINE uint8_t inverse_trans(uint8_t);
+STATIC_INLINE uint8_t compose_trans(uint8_t, uint8_t);
+STATIC_INLINE uint8_t transform_move(uint8_t, uint8_t);
 STATIC_INLINE uint8_t movebase(uint8_t);
 STATIC_INLINE uint8_t moveaxis(uint8_t);
 STATIC_INLINE uint32_t disable_moves(uint32_t, uint8_t);
 
 STATIC cube_t move(cube_t, uint8_t);
 STATIC cube_t premove(cube_t, uint8_t);
+STATIC_INLINE void expand_moves(cube_t, uint32_t, cube_t [static 18]);
+STATIC_INLINE void expand_premoves(cube_t, uint32_t, cube_t [static 18]);
 STATIC uint8_t inverse_move(uint8_t);
 STATIC void invertmoves(uint8_t *, uint8_t, uint8_t *);
 
@@ -60,6 +65,34 @@ allowednextmove(uint8_t *moves, uint8_t n)
 	return axis[1] != axis[2] || base[0] != base[2];
 }
 
+STATIC uint32_t
+allowednextmove_h48(uint8_t *moves, uint8_t n, uint8_t h48branch)
+{
+	uint32_t result = MM_ALLMOVES;
+	if (h48branch & MM_NORMALBRANCH)
+		result &= MM_NOHALFTURNS;
+	if (n < 1)
+		return result;
+
+	uint8_t base1 = movebase(moves[n-1]);
+	uint8_t axis1 = moveaxis(moves[n-1]);
+
+	result = disable_moves(result, base1 * 3);
+	if (base1 % 2)
+		result = disable_moves(result, (base1 - 1) * 3);
+
+	if (n == 1)
+		return result;
+
+	uint8_t base2 = movebase(moves[n-2]);
+	uint8_t axis2 = moveaxis(moves[n-2]);
+
+	if(axis1 == axis2)
+		result = disable_moves(result, base2 * 3);
+
+	return result;
+}
+
 STATIC_INLINE uint32_t 
 disable_moves(uint32_t current_result, uint8_t base_index)
 {
@@ -72,6 +105,18 @@ inverse_trans(uint8_t t)
 	return inverse_trans_table[t];
 }
 
+STATIC_INLINE uint8_t
+compose_trans(uint8_t t1, uint8_t t2)
+{
+	return compose_trans_table[t1][t2];
+}
+
+STATIC_INLINE uint8_t
+transform_move(uint8_t m, uint8_t t)
+{
+	return transform_move_table[t][m];
+}
+
 STATIC_INLINE uint8_t
 movebase(uint8_t move)
 {
@@ -177,6 +222,36 @@ premove(cube_t c, uint8_t m)
 	}
 }
 
+/*
+Apply (expand_moves) or premove (expand_premoves) each move in the mask
+allowed to the cube c, all at once. The cube obtained with move m is stored
+in ret[m], while the entries corresponding to moves that are not allowed
+are unspecified. The move cubes are read from a table, so unlike calling
+move() or premove() 18 times, there is no dispatch on the move. Moves are
+composed two at a time, which some architectures can do in parallel.
+*/
+STATIC_INLINE void
+expand_moves(cube_t c, uint32_t allowed, cube_t ret[static 18])
+{
+	uint8_t m;
+
+	for (m = 0; m < 18; m += 2)
+		if (allowed & (UINT32_C(3) << m))
+			compose_pair(c, loadcube(move_cube_table[m]),
+			    c, loadcube(move_cube_table[m+1]), ret + m);
+}
+
+STATIC_INLINE void
+expand_premoves(cube_t c, uint32_t allowed, cube_t ret[static 18])
+{
+	uint8_t m;
+
+	for (m = 0; m < 18; m += 2)
+		if (allowed & (UINT32_C(3) << m))
+			compose_pair(loadcube(premove_cube_table[m]), c,
+			    loadcube(premove_cube_table[m+1]), c, ret + m);
+}
+
 STATIC uint8_t
 inverse_move(uint8_t m)
 {
@@ -0,0 +1,413 @@
+/*
+Runtime dispatch between the architecture-specific builds of the library.
+
+When the library is configured with DISPATCH="yes" (see configure.sh),
+nissy.c is compiled once for each of the AVX512, AVX2 and PORTABLE
+backends, with the exported symbols renamed as explained in dispatch.h.
+This file provides the public functions, which forward to the build
+that matches the CPU the library is running on. The backend is chosen on
+the first call, using the cpuid instruction.
+
+For testing purposes, the environment variable NISSY_ARCH can be set to
+the name of a backend to use it instead of the detected one. The value is
+ignored if the backend is not supported by the CPU.
+*/
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Declare the renamed functions of each backend */
+
+#define DISPATCH_DECLARE_EXTRA \
+    long long nissy_datainfo( \
+        uint64_t, const char *, void (*)(const char *, ...)); \
+    size_t gendata_h48_derive(uint8_t, const void *, void *); \
+    int parse_h48_solver(const char *, uint8_t [static 1], uint8_t [static 1]);
+
+#define BACKEND avx512
+#include "dispatch.h"
+#include "nissy.h"
+DISPATCH_DECLARE_EXTRA
+#undef BACKEND
+
+#define BACKEND avx2
+#include "dispatch.h"
+#include "nissy.h"
+DISPATCH_DECLARE_EXTRA
+#undef BACKEND
+
+#define BACKEND portable
+#include "dispatch.h"
+#include "nissy.h"
+DISPATCH_DECLARE_EXTRA
+#undef BACKEND
+
+#include "dispatch.h"
+#include "nissy.h"
+
+typedef struct {
+	const char *name;
+	bool (*supported)(void);
+	long long (*compose)(const char *, const char *, char *);
+	long long (*inverse)(const char *, char *);
+	long long (*applymoves)(const char *, const char *, char *);
+	long long (*applytrans)(const char *, const char *, char *);
+	long long (*convert)(
+	    const char *, const char *, const char *, unsigned, char *);
+	long long (*getcube)(
+	    long long, long long, long long, long long, const char *, char *);
+	long long (*datasize)(const char *);
+	long long (*datainfo)(
+	    uint64_t, const char *, void (*)(const char *, ...));
+	long long (*gendata)(const char *, unsigned long long, char *);
+	long long (*checkdata)(unsigned long long, const char *);
+	long long (*solve)(const char *, const char *, unsigned, unsigned,
+	    unsigned, unsigned, int, unsigned long long, const char *,
+	    unsigned, char *, long long *);
+	long long (*countmoves)(const char *);
+	long long (*setthreads)(unsigned);
+	long long (*setinterleave)(unsigned);
+	long long (*setnuma)(unsigned);
+	long long (*allocdata)(unsigned long long, char **);
+	long long (*freedata)(unsigned long long, char *);
+	long long (*warmup)(unsigned long long, const char *);
+	long long (*setcache)(unsigned long long, unsigned);
+	long long (*cachestats)(long long *);
+	long long (*setlogger)(void (*)(const char *, ...));
+	long long (*getarch)(char *);
+	size_t (*gendata_h48_derive)(uint8_t, const void *, void *);
+	int (*parse_h48_solver)(const char *, uint8_t *, uint8_t *);
+} backend_t;
+
+#define DISPATCH_BACKEND(b, NAME, SUPPORTED) { \
+    .name = NAME, \
+    .supported = SUPPORTED, \
+    .compose = DISPATCH_RENAME(b, nissy_compose), \
+    .inverse = DISPATCH_RENAME(b, nissy_inverse), \
+    .applymoves = DISPATCH_RENAME(b, nissy_applymoves), \
+    .applytrans = DISPATCH_RENAME(b, nissy_applytrans), \
+    .convert = DISPATCH_RENAME(b, nissy_convert), \
+    .getcube = DISPATCH_RENAME(b, nissy_getcube), \
+    .datasize = DISPATCH_RENAME(b, nissy_datasize), \
+    .datainfo = DISPATCH_RENAME(b, nissy_datainfo), \
+    .gendata = DISPATCH_RENAME(b, nissy_gendata), \
+    .checkdata = DISPATCH_RENAME(b, nissy_checkdata), \
+    .solve = DISPATCH_RENAME(b, nissy_solve), \
+    .countmoves = DISPATCH_RENAME(b, nissy_countmoves), \
+    .setthreads = DISPATCH_RENAME(b, nissy_setthreads), \
+    .setinterleave = DISPATCH_RENAME(b, nissy_setinterleave), \
+    .setnuma = DISPATCH_RENAME(b, nissy_setnuma), \
+    .allocdata = DISPATCH_RENAME(b, nissy_allocdata), \
+    .freedata = DISPATCH_RENAME(b, nissy_freedata), \
+    .warmup = DISPATCH_RENAME(b, nissy_warmup), \
+    .setcache = DISPATCH_RENAME(b, nissy_setcache), \
+    .cachestats = DISPATCH_RENAME(b, nissy_cachestats), \
+    .setlogger = DISPATCH_RENAME(b, nissy_setlogger), \
+    .getarch = DISPATCH_RENAME(b, nissy_getarch), \
+    .gendata_h48_derive = DISPATCH_RENAME(b, gendata_h48_derive), \
+    .parse_h48_solver = DISPATCH_RENAME(b, parse_h48_solver) \
+}
+
+size_t gendata_h48_derive(uint8_t, const void *, void *);
+int parse_h48_solver(const char *, uint8_t [static 1], uint8_t [static 1]);
+long long nissy_datainfo(uint64_t, const char *, void (*)(const char *, ...));
+
+static bool supported_avx512(void);
+static bool supported_avx2(void);
+static bool supported_portable(void);
+static const backend_t *getbackend(void);
+
+/* Ordered from the most to the least preferred */
+static const backend_t backends[] = {
+	DISPATCH_BACKEND(avx512, "AVX512", supported_avx512),
+	DISPATCH_BACKEND(avx2, "AVX2", supported_avx2),
+	DISPATCH_BACKEND(portable, "PORTABLE", supported_portable),
+};
+
+#define BACKENDS_COUNT (sizeof(backends) / sizeof(backends[0]))
+
+static bool
+supported_avx512(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx512f") &&
+	    __builtin_cpu_supports("avx512bw") &&
+	    __builtin_cpu_supports("avx512vl") &&
+	    __builtin_cpu_supports("bmi2");
+}
+
+static bool
+supported_avx2(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") &&
+	    __builtin_cpu_supports("bmi2");
+}
+
+static bool
+supported_portable(void)
+{
+	return true;
+}
+
+static const backend_t *
+getbackend(void)
+{
+	static const backend_t *_Atomic selected = NULL;
+
+	size_t i;
+	const char *forced;
+	const backend_t *ret;
+
+	ret = atomic_load(&selected);
+	if (ret != NULL)
+		return ret;
+
+	/* Select the first supported backend, or the forced one */
+	forced = getenv("NISSY_ARCH");
+	for (i = 0, ret = NULL; i < BACKENDS_COUNT; i++) {
+		if (!backends[i].supported())
+			continue;
+		if (ret == NULL)
+			ret = &backends[i];
+		if (forced != NULL && !strcmp(forced, backends[i].name)) {
+			ret = &backends[i];
+			break;
+		}
+	}
+
+	/* Concurrent first calls select the same backend */
+	atomic_store(&selected, ret);
+
+	return ret;
+}
+
+long long
+nissy_compose(
+	const char cube[static NISSY_SIZE_B32],
+	const char permutation[static NISSY_SIZE_B32],
+	char result[static NISSY_SIZE_B32]
+)
+{
+	return getbackend()->compose(cube, permutation, result);
+}
+
+long long
+nissy_inverse(
+	const char cube[static NISSY_SIZE_B32],
+	char result[static NISSY_SIZE_B32]
+)
+{
+	return getbackend()->inverse(cube, result);
+}
+
+long long
+nissy_applymoves(
+	const char cube[static NISSY_SIZE_B32],
+	const char *moves,
+	char result[static NISSY_SIZE_B32]
+)
+{
+	return getbackend()->applymoves(cube, moves, result);
+}
+
+long long
+nissy_applytrans(
+	const char cube[static NISSY_SIZE_B32],
+	const char transformation[static NISSY_SIZE_TRANSFORMATION],
+	char result[static NISSY_SIZE_B32]
+)
+{
+	return getbackend()->applytrans(cube, transformation, result);
+}
+
+long long
+nissy_convert(
+	const char *format_in,
+	const char *format_out,
+	const char *cube_string,
+	unsigned result_size,
+	char result[result_size]
+)
+{
+	return getbackend()->convert(
+	    format_in, format_out, cube_string, result_size, result);
+}
+
+long long
+nissy_getcube(
+	long long ep,
+	long long eo,
+	long long cp,
+	long long co,
+	const char *options,
+	char result[static NISSY_SIZE_B32]
+)
+{
+	return getbackend()->getcube(ep, eo, cp, co, options, result);
+}
+
+long long
+nissy_datasize(
+	const char *solver
+)
+{
+	return getbackend()->datasize(solver);
+}
+
+long long
+nissy_datainfo(
+	uint64_t data_size,
+	const char *data,
+	void (*write)(const char *, ...)
+)
+{
+	return getbackend()->datainfo(data_size, data, write);
+}
+
+long long
+nissy_gendata(
+	const char *solver,
+	unsigned long long data_size,
+	char data[data_size]
+)
+{
+	return getbackend()->gendata(solver, data_size, data);
+}
+
+long long
+nissy_checkdata(
+	unsigned long long data_size,
+	const char data[data_size]
+)
+{
+	return getbackend()->checkdata(data_size, data);
+}
+
+long long
+nissy_solve(
+	const char cube[static NISSY_SIZE_B32],
+	const char *solver,
+	unsigned nissflag,
+	unsigned minmoves,
+	unsigned maxmoves,
+	unsigned maxsolutions,
+	int optimal,
+	unsigned long long data_size,
+	const char data[data_size],
+	unsigned sols_size,
+	char sols[sols_size],
+	long long stats[static NISSY_SIZE_SOLVE_STATS]
+)
+{
+	return getbackend()->solve(cube, solver, nissflag, minmoves, maxmoves,
+	    maxsolutions, optimal, data_size, data, sols_size, sols, stats);
+}
+
+long long
+nissy_countmoves(
+	const char *moves
+)
+{
+	return getbackend()->countmoves(moves);
+}
+
+long long
+nissy_setthreads(
+	unsigned threads
+)
+{
+	return getbackend()->setthreads(threads);
+}
+
+long long
+nissy_setinterleave(
+	unsigned searches
+)
+{
+	return getbackend()->setinterleave(searches);
+}
+
+long long
+nissy_setnuma(
+	unsigned mode
+)
+{
+	return getbackend()->setnuma(mode);
+}
+
+long long
+nissy_allocdata(
+	unsigned long long data_size,
+	char **data
+)
+{
+	return getbackend()->allocdata(data_size, data);
+}
+
+long long
+nissy_freedata(
+	unsigned long long data_size,
+	char *data
+)
+{
+	return getbackend()->freedata(data_size, data);
+}
+
+long long
+nissy_warmup(
+	unsigned long long data_size,
+	const char data[data_size]
+)
+{
+	return getbackend()->warmup(data_size, data);
+}
+
+long long
+nissy_setcache(
+	unsigned long long size,
+	unsigned mode
+)
+{
+	return getbackend()->setcache(size, mode);
+}
+
+long long
+nissy_cachestats(
+	long long stats[static NISSY_SIZE_CACHE_STATS]
+)
+{
+	return getbackend()->cachestats(stats);
+}
+
+long long
+nissy_setlogger(
+	void (*log)(const char *, ...)
+)
+{
+	return getbackend()->setlogger(log);
+}
+
+long long
+nissy_getarch(
+	char result[static NISSY_SIZE_ARCH]
+)
+{
+	return getbackend()->getarch(result);
+}
+
+size_t
+gendata_h48_derive(uint8_t h, const void *fulltable, void *buf)
+{
+	return getbackend()->gendata_h48_derive(h, fulltable, buf);
+}
+
+int
+parse_h48_solver(const char *buf, uint8_t h[static 1], uint8_t k[static 1])
+{
+	return getbackend()->parse_h48_solver(buf, h, k);
+}
@@ -0,0 +1,69 @@
+/*
+When the library is built with runtime dispatch (see configure.sh), the
+file nissy.c is compiled once for each backend, with BACKEND defined as the
+lowercase name of the backend. This header renames the exported symbols
+of each build, for example nissy_solve becomes avx2_nissy_solve; the
+public functions are then provided by dispatch.c.
+
+This header can be included more than once, and it undoes the renaming if
+BACKEND is not defined.
+*/
+
+#define DISPATCH_RENAME(b, f) DISPATCH_RENAME_(b, f)
+#define DISPATCH_RENAME_(b, f) b ## _ ## f
+
+#undef nissy_compose
+#undef nissy_inverse
+#undef nissy_applymoves
+#undef nissy_applytrans
+#undef nissy_convert
+#undef nissy_getcube
+#undef nissy_datasize
+#undef nissy_datainfo
+#undef nissy_gendata
+#undef nissy_checkdata
+#undef nissy_solve
+#undef nissy_countmoves
+#undef nissy_setthreads
+#undef nissy_setinterleave
+#undef nissy_setnuma
+#undef nissy_allocdata
+#undef nissy_freedata
+#undef nissy_warmup
+#undef nissy_setcache
+#undef nissy_cachestats
+#undef nissy_setlogger
+#undef nissy_getarch
+#undef nissy_log
+#undef nissy_threads
+#undef gendata_h48_derive
+#undef parse_h48_solver
+
+#if defined(BACKEND)
+#define nissy_compose DISPATCH_RENAME(BACKEND, nissy_compose)
+#define nissy_inverse DISPATCH_RENAME(BACKEND, nissy_inverse)
+#define nissy_applymoves DISPATCH_RENAME(BACKEND, nissy_applymoves)
+#define nissy_applytrans DISPATCH_RENAME(BACKEND, nissy_applytrans)
+#define nissy_convert DISPATCH_RENAME(BACKEND, nissy_convert)
+#define nissy_getcube DISPATCH_RENAME(BACKEND, nissy_getcube)
+#define nissy_datasize DISPATCH_RENAME(BACKEND, nissy_datasize)
+#define nissy_datainfo DISPATCH_RENAME(BACKEND, nissy_datainfo)
+#define nissy_gendata DISPATCH_RENAME(BACKEND, nissy_gendata)
+#define nissy_checkdata DISPATCH_RENAME(BACKEND, nissy_checkdata)
+#define nissy_solve DISPATCH_RENAME(BACKEND, nissy_solve)
+#define nissy_countmoves DISPATCH_RENAME(BACKEND, nissy_countmoves)
+#define nissy_setthreads DISPATCH_RENAME(BACKEND, nissy_setthreads)
+#define nissy_setinterleave DISPATCH_RENAME(BACKEND, nissy_setinterleave)
+#define nissy_setnuma DISPATCH_RENAME(BACKEND, nissy_setnuma)
+#define nissy_allocdata DISPATCH_RENAME(BACKEND, nissy_allocdata)
+#define nissy_freedata DISPATCH_RENAME(BACKEND, nissy_freedata)
+#define nissy_warmup DISPATCH_RENAME(BACKEND, nissy_warmup)
+#define nissy_setcache DISPATCH_RENAME(BACKEND, nissy_setcache)
+#define nissy_cachestats DISPATCH_RENAME(BACKEND, nissy_cachestats)
+#define nissy_setlogger DISPATCH_RENAME(BACKEND, nissy_setlogger)
+#define nissy_getarch DISPATCH_RENAME(BACKEND, nissy_getarch)
+#define nissy_log DISPATCH_RENAME(BACKEND, nissy_log)
+#define nissy_threads DISPATCH_RENAME(BACKEND, nissy_threads)
+#define gendata_h48_derive DISPATCH_RENAME(BACKEND, gendata_h48_derive)
+#define parse_h48_solver DISPATCH_RENAME(BACKEND, parse_h48_solver)
+#endif
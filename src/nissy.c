@@ -4,8 +4,20 @@
 #include <stdatomic.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <linux/mman.h>
+#endif
+
+#include "dispatch.h"
 #include "nissy.h"
 #include "utils/utils.h"
 #include "arch/arch.h"
@@ -20,7 +32,7 @@ STATIC long long write_result(cube_t, char [static NISSY_SIZE_B32]);
 STATIC size_t my_strnlen(const char *, size_t); 
 
 #define GETCUBE_OPTIONS(S, F) { .option = S, .fix = F }
-struct {
+STATIC struct {
 	char *option;
 	void (*fix)(long long *, long long *, long long *, long long *);
 } getcube_options[] = {
@@ -31,6 +43,7 @@ struct {
 int
 parse_h48_solver(const char *buf, uint8_t h[static 1], uint8_t k[static 1])
 {
+	int i;
 	const char *fullbuf = buf;
 
 	buf += 3;
@@ -57,13 +70,23 @@ parse_h48_solver(const char *buf, uint8_t h[static 1], uint8_t k[static 1])
 
 	*k = atoi(buf);
 
-	return *h < 12 && (*k == 2 || (*k == 4 && *h == 0)) ? 0 : 1;
+	while (*buf >= 0 + '0' && *buf <= 9 + '0')
+		buf++;
+
+	/* The remaining letters select the extra tables, each at most once */
+	for (i = 0; buf[i] != '\0'; i++)
+		if (i == H48_MAXEXTRA || strchr(H48_EXTRATABLES, buf[i]) == NULL
+		    || strchr(buf + i + 1, buf[i]) != NULL)
+			goto parse_h48_solver_error;
+
+	return *h < 12 && (*k == 1 || *k == 2 || *k == 4) ? 0 : 1;
 
 parse_h48_solver_error:
 	*h = 0;
 	*k = 0;
-	LOG("Error parsing solver: must be in \"h48h*k*\" format"
-	    " or \"h48stats\", but got %s\n", fullbuf);
+	LOG("Error parsing solver: must be in \"h48h*k*\" format, optionally"
+	    " followed by some of the letters \"%s\", or \"h48stats\", but"
+	    " got %s\n", H48_EXTRATABLES, fullbuf);
 	return -1;
 }
 
@@ -79,6 +102,10 @@ checkdata(const char *buf, const tableinfo_t *info)
 	} else if (!strncmp(info->solver, "cocsep", 6)) {
 		getdistribution_cocsep(
 		    (uint32_t *)((char *)buf + INFOSIZE), distr);
+	} else if (!strncmp(info->solver, "corners", 7)) {
+		getdistribution_h48corners((uint8_t *)buf + INFOSIZE, distr);
+	} else if (!strncmp(info->solver, "eoesep", 6)) {
+		getdistribution_h48eoesep((uint8_t *)buf + INFOSIZE, distr);
 	} else if (!strncmp(info->solver, "h48", 3)) {
 		getdistribution_h48((uint8_t *)buf + INFOSIZE, distr,
 		    info->h48h, info->bits);
@@ -442,8 +469,11 @@ nissy_gendata(
 	if (!strncmp(solver, "h48", 3)) {
 		p = parse_h48_solver(solver, &arg.h, &arg.k);
 		arg.maxdepth = 20;
+		arg.base = 99; /* Use the default base, see gendata_h48k2() */
 		if (p != 0)
 			return NISSY_ERROR_UNKNOWN;
+		/* The extra tables are listed after the value of k */
+		strcpy(arg.extra, solver + strspn(solver, "h48k0123456789"));
 		return gendata_h48(&arg);
 	} else {
 		LOG("gendata: unknown solver %s\n", solver);
@@ -494,9 +524,12 @@ nissy_solve(
 	long long stats[static NISSY_SIZE_SOLVE_STATS]
 )
 {
+	bool cached;
 	cube_t c;
 	int p;
 	uint8_t h, k;
+	long long ret;
+	cache_key_t key;
 
 	if (solver == NULL) {
 		LOG("Error: 'solver' argument is NULL\n");
@@ -528,13 +561,26 @@ nissy_solve(
 		if (p != 0) {
 			LOG("solve: unknown solver %s\n", solver);
 			return NISSY_ERROR_INVALID_SOLVER;
-		} else {
-			return THREADS > 1 ?
-			    solve_h48_multithread(c, minmoves, maxmoves,
-			        maxsols, data_size, data, sols_size, sols, stats) :
-			    solve_h48(c, minmoves, maxmoves, maxsols,
-			        data_size, data, sols_size, sols, stats);
 		}
+
+		cached = cache_key(c, solver, nissflag, minmoves, maxmoves,
+		    maxsols, optimal, &key);
+		if (cached && cache_get(&key, sols_size, sols, &ret)) {
+			memset(stats, 0,
+			    NISSY_SIZE_SOLVE_STATS * sizeof(long long));
+			return ret;
+		}
+
+		ret = atomic_load(&nissy_threads) > 1 ||
+		    atomic_load(&nissy_interleave) > 1 ?
+		    solve_h48_multithread(c, minmoves, maxmoves,
+		        maxsols, data_size, data, sols_size, sols, stats) :
+		    solve_h48(c, minmoves, maxmoves, maxsols,
+		        data_size, data, sols_size, sols, stats);
+		if (cached)
+			cache_put(&key, ret, sols);
+
+		return ret;
 	} else {
 		LOG("solve: unknown solver '%s'\n", solver);
 		return NISSY_ERROR_INVALID_SOLVER;
@@ -552,6 +598,137 @@ nissy_countmoves(
 	return readmoves(moves, INT_MAX, NULL);
 }
 
+long long
+nissy_setthreads(
+	unsigned threads
+)
+{
+	if (threads == 0) {
+		LOG("setthreads: the number of threads must be positive\n");
+		return NISSY_ERROR_OPTIONS;
+	}
+
+	if (threads > THREADS)
+		threads = THREADS;
+	atomic_store(&nissy_threads, threads);
+
+	return threads;
+}
+
+long long
+nissy_setinterleave(
+	unsigned searches
+)
+{
+	if (searches == 0) {
+		LOG("setinterleave: the number of searches must be positive\n");
+		return NISSY_ERROR_OPTIONS;
+	}
+
+	if (searches > INTERLEAVE_MAX)
+		searches = INTERLEAVE_MAX;
+	atomic_store(&nissy_interleave, searches);
+
+	return searches;
+}
+
+long long
+nissy_setnuma(
+	unsigned mode
+)
+{
+	if (mode != NISSY_NUMA_DEFAULT && mode != NISSY_NUMA_INTERLEAVE &&
+	    mode != NISSY_NUMA_REPLICATE) {
+		LOG("setnuma: unknown mode %u\n", mode);
+		return NISSY_ERROR_OPTIONS;
+	}
+
+	pthread_mutex_lock(&numa_state.mutex);
+	numa_invalidate();
+	atomic_store(&nissy_numa, mode);
+	pthread_mutex_unlock(&numa_state.mutex);
+
+	return NISSY_OK;
+}
+
+long long
+nissy_allocdata(
+	unsigned long long data_size,
+	char **data
+)
+{
+	long long ret;
+
+	if (data == NULL)
+		return NISSY_ERROR_NULL_POINTER;
+
+	if ((ret = pages_alloc(data_size, data)) >= 0)
+		pages_touch(data_size, *data, true);
+
+	return ret;
+}
+
+long long
+nissy_freedata(
+	unsigned long long data_size,
+	char *data
+)
+{
+	if (data != NULL)
+		pages_free(data_size, data);
+
+	return NISSY_OK;
+}
+
+long long
+nissy_warmup(
+	unsigned long long data_size,
+	const char data[data_size]
+)
+{
+	int set, node[NUMA_MAXNODES];
+	const void *replica[NUMA_MAXNODES];
+
+	if (data == NULL)
+		return NISSY_ERROR_NULL_POINTER;
+
+	pages_touch(data_size, data, false);
+	numa_prepare(data_size, data, &set, node, replica);
+	numa_release(set);
+
+	return NISSY_OK;
+}
+
+long long
+nissy_setcache(
+	unsigned long long size,
+	unsigned mode
+)
+{
+	if (mode != NISSY_CACHE_OFF && mode != NISSY_CACHE_SYMMETRY &&
+	    mode != NISSY_CACHE_INVERSE) {
+		LOG("setcache: unknown mode %u\n", mode);
+		return NISSY_ERROR_OPTIONS;
+	}
+
+	cache_set(size, mode);
+
+	return NISSY_OK;
+}
+
+long long
+nissy_cachestats(
+	long long stats[static NISSY_SIZE_CACHE_STATS]
+)
+{
+	if (stats == NULL)
+		return NISSY_ERROR_NULL_POINTER;
+
+	cache_stats(stats);
+
+	return NISSY_OK;
+}
+
 long long
 nissy_setlogger(
 	void (*log)(const char *, ...)
@@ -560,3 +737,15 @@ nissy_setlogger(
 	nissy_log = log;
 	return NISSY_OK;
 }
+
+long long
+nissy_getarch(
+	char result[static NISSY_SIZE_ARCH]
+)
+{
+	if (result == NULL)
+		return NISSY_ERROR_NULL_POINTER;
+
+	strcpy(result, ARCH_NAME);
+	return NISSY_OK;
+}
@@ -25,6 +25,8 @@ for example 'rotation UF' or 'mirrored BL'.
 #define NISSY_SIZE_H48            88U
 #define NISSY_SIZE_TRANSFORMATION 12U
 #define NISSY_SIZE_SOLVE_STATS    10U
+#define NISSY_SIZE_CACHE_STATS    5U
+#define NISSY_SIZE_ARCH           16U
 
 /* Flags for NISS options */
 #define NISSY_NISSFLAG_NORMAL  1U
@@ -35,6 +37,21 @@ for example 'rotation UF' or 'mirrored BL'.
 #define NISSY_NISSFLAG_ALL \
     (NISSY_NISSFLAG_NORMAL | NISSY_NISSFLAG_INVERSE | NISSY_NISSFLAG_MIXED)
 
+/* Placement of the data on NUMA machines, see nissy_setnuma() */
+#define NISSY_NUMA_DEFAULT    0U
+#define NISSY_NUMA_INTERLEAVE 1U
+#define NISSY_NUMA_REPLICATE  2U
+
+/* Kind of pages used for the data, see nissy_allocdata() */
+#define NISSY_HUGEPAGES_NONE        0LL
+#define NISSY_HUGEPAGES_TRANSPARENT 1LL
+#define NISSY_HUGEPAGES_EXPLICIT    2LL
+
+/* Cache of the solutions, see nissy_setcache() */
+#define NISSY_CACHE_OFF      0U
+#define NISSY_CACHE_SYMMETRY 1U
+#define NISSY_CACHE_INVERSE  2U
+
 /* The solved cube in B32 format */
 #define NISSY_SOLVED_CUBE "ABCDEFGH=ABCDEFGHIJKL"
 
@@ -265,7 +282,12 @@ Parameters:
    sols      - The return parameter for the solutions. The solutions are
                separated by a '\n' (newline) and a '\0' (NULL character)
                terminates the list.
-   stats     - An array to store some statistics about the solve.
+   stats     - An array to store some statistics about the solve. For the
+               h48 solvers these are: the number of nodes visited (0), the
+               number of lookups in the fallback table (1), the number of
+               nodes pruned by the corner bound (2), by the h48 table (3) and
+               by each extra table, in the order given in the solver name
+               (4 and following).
 
 Return values:
    NISSY_OK                    - Cube solved succesfully.
@@ -307,6 +329,196 @@ nissy_countmoves(
 	const char *moves
 );
 
+/*
+Set the number of threads used by this library for solving and for
+generating data. The default, and the maximum, is the value of THREADS
+chosen at build time.
+
+Parameters:
+   threads - The number of threads. Values larger than the maximum are
+             replaced by the maximum.
+
+Return values:
+   NISSY_ERROR_OPTIONS - The number of threads is 0.
+   Any value > 0       - The number of threads that will be used.
+*/
+long long
+nissy_setthreads(
+	unsigned threads
+);
+
+/*
+Set the number of searches that each thread of the h48 solvers runs at the
+same time. The thread switches from one search to the next at every
+position, after requesting the table entries that the position needs, so
+that it does not wait for the memory. This is useful when the tables are
+much larger than the CPU cache. The default is 1, which means that the
+searches are not interleaved. With a value larger than 1 the solutions can
+be found in a different order, also when a single thread is used.
+
+Parameters:
+   searches - The number of searches per thread. Values larger than the
+              maximum, which is 8, are replaced by the maximum.
+
+Return values:
+   NISSY_ERROR_OPTIONS - The number of searches is 0.
+   Any value > 0       - The number of searches that will be used.
+*/
+long long
+nissy_setinterleave(
+	unsigned searches
+);
+
+/*
+Choose how the data is placed in memory by the multi-threaded solvers on
+machines with more than one NUMA node (Linux only). This has no effect on
+the results, nor on machines with a single node.
+
+With NISSY_NUMA_DEFAULT the data is used where the caller allocated it.
+With NISSY_NUMA_INTERLEAVE its pages are moved so that they are spread
+evenly across all nodes. With NISSY_NUMA_REPLICATE a copy of the data is
+made on each node, and each solver thread is pinned to the CPUs of a node
+and uses the local copy; this needs one more copy of the data per node.
+
+The data is prepared the first time it is used for solving, and the
+copies are kept as long as the same buffer is passed to the solver. If the
+content of the buffer is changed, this function must be called again. The
+copies are never freed while a solve is using them: if this function is
+called during a solve, the copies of that solve are freed when it ends.
+
+Parameters:
+   mode - One of NISSY_NUMA_DEFAULT, NISSY_NUMA_INTERLEAVE and
+          NISSY_NUMA_REPLICATE.
+
+Return values:
+   NISSY_OK            - The mode was set succesfully.
+   NISSY_ERROR_OPTIONS - The given mode is not valid.
+*/
+long long
+nissy_setnuma(
+	unsigned mode
+);
+
+/*
+Allocate a buffer for the data of a solver, backed by huge pages if
+possible. The pruning tables are read at random positions, and with huge
+pages most of these lookups hit the TLB. Explicit huge pages (reserved for
+example in /proc/sys/vm/nr_hugepages) are used if enough of them are
+available, then transparent huge pages, then normal pages (Linux only; on
+other systems the buffer is allocated with malloc(3)). The pages are
+faulted in using all the threads set with nissy_setthreads().
+
+The buffer must be released with nissy_freedata().
+
+Parameters:
+   data_size - The size of the buffer, for example from nissy_datasize().
+   data      - The return parameter for the address of the buffer.
+
+Return values:
+   NISSY_HUGEPAGES_NONE        - The buffer uses normal pages.
+   NISSY_HUGEPAGES_TRANSPARENT - The buffer uses transparent huge pages, if
+                                 they are enabled in the kernel.
+   NISSY_HUGEPAGES_EXPLICIT    - The buffer uses explicit huge pages.
+   NISSY_ERROR_NULL_POINTER    - The 'data' argument is NULL.
+   NISSY_ERROR_UNKNOWN         - The memory could not be allocated.
+*/
+long long
+nissy_allocdata(
+	unsigned long long data_size,
+	char **data
+);
+
+/*
+Release a buffer allocated with nissy_allocdata().
+
+Parameters:
+   data_size - The size used when allocating the buffer.
+   data      - The buffer.
+
+Return values:
+   NISSY_OK - The buffer was released succesfully.
+*/
+long long
+nissy_freedata(
+	unsigned long long data_size,
+	char *data
+);
+
+/*
+Prepare the data for solving, so that the first solve is not slower than
+the following ones. The pages of the data are read using all the threads
+set with nissy_setthreads(), which for example loads them from disk if
+the data is mapped from a file, and the data is placed according to the
+NUMA mode set with nissy_setnuma().
+
+This function can be called while other solves are running, also with a
+different buffer: the copies of the data made for NISSY_NUMA_REPLICATE are
+not freed while a solve is using them.
+
+Parameters:
+   data_size - The size of the data buffer.
+   data      - The data for the solver.
+
+Return values:
+   NISSY_OK                 - The data is ready.
+   NISSY_ERROR_NULL_POINTER - The 'data' argument is NULL.
+*/
+long long
+nissy_warmup(
+	unsigned long long data_size,
+	const char data[data_size]
+);
+
+/*
+Enable or disable the cache of the solutions found by nissy_solve(). When
+the cache is enabled, a solve with the same options as a previous one, for
+the same cube or for one of its 48 rotations and mirrorings, returns the
+solutions of the previous solve, with the moves transformed accordingly.
+With NISSY_CACHE_INVERSE the solutions of the inverse cube are used too,
+inverted. For a cached solve no node is visited, and all the values in
+the stats array of nissy_solve() are 0. The solves that find maxsols
+solutions are not cached, because a different subset of the solutions
+could be found for a rotation of the same cube.
+
+The cache is shared by all threads. When the memory used by the cached
+solutions goes over the given size, the least recently used ones are
+removed. Calling this function empties the cache and resets its stats.
+
+Parameters:
+   size - The maximum memory used by the cache, in bytes. If it is 0, the
+          cache is disabled.
+   mode - One of NISSY_CACHE_OFF, NISSY_CACHE_SYMMETRY and
+          NISSY_CACHE_INVERSE.
+
+Return values:
+   NISSY_OK            - The cache was set succesfully.
+   NISSY_ERROR_OPTIONS - The given mode is not valid.
+*/
+long long
+nissy_setcache(
+	unsigned long long size,
+	unsigned mode
+);
+
+/*
+Get the statistics of the cache set with nissy_setcache().
+
+Parameters:
+   stats - The return parameter for the statistics: the number of solves
+           found in the cache (0), the number of solves that were not
+           found (1), the number of entries removed to free memory (2),
+           the number of entries in the cache (3) and the memory they use,
+           in bytes (4).
+
+Return values:
+   NISSY_OK                 - The statistics were written succesfully.
+   NISSY_ERROR_NULL_POINTER - The 'stats' argument is NULL.
+*/
+long long
+nissy_cachestats(
+	long long stats[static NISSY_SIZE_CACHE_STATS]
+);
+
 /*
 Set a global logger function used by this library.
 
@@ -322,6 +534,24 @@ nissy_setlogger(
 	void (*logger_function)(const char *, ...)
 );
 
+/*
+Get the name of the architecture-specific backend in use. If the library
+was built with runtime dispatch, this is the backend selected for the CPU
+the library is running on.
+
+Parameters:
+   result - The return parameter for the name of the backend, one of
+            "AVX512", "AVX2", "NEON" or "PORTABLE".
+
+Return values:
+   NISSY_OK                 - The name was written succesfully.
+   NISSY_ERROR_NULL_POINTER - The 'result' argument is NULL.
+*/
+long long
+nissy_getarch(
+	char result[static NISSY_SIZE_ARCH]
+);
+
 
 /* Error codes ***************************************************************/
 
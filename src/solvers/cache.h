@@ -0,0 +1,385 @@
+/*
+Cache of the solutions found by nissy_solve(), see nissy_setcache(). The
+cubes that differ by a rotation or a mirroring have the same solutions, up
+to transforming the moves, and so do a cube and its inverse, up to inverting
+the solutions. So the cache is keyed by a canonical cube: the smallest one
+among the 48 transformations of the cube, and of its inverse if the mode is
+NISSY_CACHE_INVERSE. The solutions are stored transformed for the canonical
+cube, and transformed back for the cube given by the caller, with the
+consecutive moves on the same axis in the order used by the solver.
+
+Only the solves that find fewer than maxsols solutions are cached. The
+others stop at a set of solutions that depends on the order of the search,
+and the set found for the canonical cube, transformed back, is not the one
+found by solving the cube given by the caller.
+
+The entries are kept in a hash table with chaining and in a list from the
+most to the least recently used, which is removed first when the memory
+used by the entries goes over the limit.
+*/
+
+#define CACHE_BUCKETS     4096
+#define CACHE_SOLVER_SIZE 32
+
+typedef struct {
+	uint8_t cube[20];
+	uint8_t trans;
+	bool inverse;
+	char solver[CACHE_SOLVER_SIZE];
+	unsigned nissflag;
+	unsigned minmoves;
+	unsigned maxmoves;
+	unsigned maxsols;
+	int optimal;
+	uint64_t hash;
+} cache_key_t;
+
+typedef struct cache_entry cache_entry_t;
+struct cache_entry {
+	cache_key_t key;
+	long long result;
+	uint64_t size;
+	cache_entry_t *chain;
+	cache_entry_t *newer;
+	cache_entry_t *older;
+	char sols[];
+};
+
+typedef struct {
+	pthread_mutex_t mutex;
+	uint64_t maxsize;
+	uint64_t size;
+	long long entries;
+	long long hits;
+	long long misses;
+	long long evictions;
+	cache_entry_t *bucket[CACHE_BUCKETS];
+	cache_entry_t *newest;
+	cache_entry_t *oldest;
+} cache_state_t;
+
+STATIC _Atomic unsigned nissy_cache = NISSY_CACHE_OFF;
+STATIC cache_state_t cache_state = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+STATIC void cache_canonical(
+    cube_t, bool, uint8_t [static 20], uint8_t *, bool *);
+STATIC bool cache_key(cube_t, const char *, unsigned, unsigned, unsigned,
+    unsigned, int, cache_key_t *);
+STATIC bool cache_convert(const char *, uint64_t, char *, uint8_t, bool);
+STATIC cache_entry_t **cache_find(const cache_key_t *);
+STATIC void cache_remove(cache_entry_t *);
+STATIC bool cache_get(const cache_key_t *, unsigned, char *, long long *);
+STATIC void cache_put(const cache_key_t *, long long, const char *);
+STATIC void cache_set(uint64_t, unsigned);
+STATIC void cache_stats(long long [static NISSY_SIZE_CACHE_STATS]);
+
+/*
+Write in p the pieces of the smallest among the transformations of the
+cube, and of its inverse if useinverse is true, comparing the pieces.
+The canonical cube is transform(c, t), where c is the inverse of the cube
+if inverted is set to true, and the cube otherwise.
+*/
+STATIC void
+cache_canonical(
+	cube_t cube,
+	bool useinverse,
+	uint8_t p[static 20],
+	uint8_t *t,
+	bool *inverted
+)
+{
+	uint8_t i, j, tp[20];
+	cube_t c[2], tc;
+
+	c[0] = cube;
+	c[1] = useinverse ? inverse(cube) : cube;
+	pieces(&cube, p, p + 8);
+	*t = TRANS_UFr;
+	*inverted = false;
+	for (i = 0; i < (useinverse ? 2 : 1); i++) {
+		for (j = 0; j < 48; j++) {
+			tc = transform(c[i], j);
+			pieces(&tc, tp, tp + 8);
+			if (memcmp(tp, p, sizeof(tp)) < 0) {
+				memcpy(p, tp, sizeof(tp));
+				*t = j;
+				*inverted = i == 1;
+			}
+		}
+	}
+}
+
+/*
+Compute the key of a solve. Returns false if the cache is disabled or if
+the solve cannot be cached.
+*/
+STATIC bool
+cache_key(
+	cube_t cube,
+	const char *solver,
+	unsigned nissflag,
+	unsigned minmoves,
+	unsigned maxmoves,
+	unsigned maxsols,
+	int optimal,
+	cache_key_t *key
+)
+{
+	size_t i;
+	unsigned mode;
+
+	mode = atomic_load(&nissy_cache);
+	if (mode == NISSY_CACHE_OFF || strlen(solver) >= CACHE_SOLVER_SIZE)
+		return false;
+
+	memset(key, 0, sizeof(*key));
+	cache_canonical(cube, mode == NISSY_CACHE_INVERSE, key->cube,
+	    &key->trans, &key->inverse);
+	strcpy(key->solver, solver);
+	key->nissflag = nissflag;
+	key->minmoves = minmoves;
+	key->maxmoves = maxmoves;
+	key->maxsols = maxsols;
+	key->optimal = optimal;
+
+	/* FNV-1a hash of the pieces and of the options */
+	key->hash = UINT64_C(14695981039346656037);
+	for (i = 0; i < sizeof(key->cube); i++)
+		key->hash = (key->hash ^ key->cube[i]) *
+		    UINT64_C(1099511628211);
+	for (i = 0; key->solver[i] != '\0'; i++)
+		key->hash = (key->hash ^ (uint8_t)key->solver[i]) *
+		    UINT64_C(1099511628211);
+	key->hash ^= ((uint64_t)minmoves << 8) ^ ((uint64_t)maxmoves << 16) ^
+	    ((uint64_t)maxsols << 24) ^ ((uint64_t)nissflag << 40) ^
+	    ((uint64_t)(unsigned)optimal << 48);
+
+	return true;
+}
+
+/*
+Transform each solution in from, one per line, by t, and invert it if
+invert is true. The consecutive moves on the same axis are sorted, as in
+the solutions found by the solver. Returns false in case of error or if
+the result does not fit in the size of to.
+*/
+STATIC bool
+cache_convert(
+	const char *from,
+	uint64_t size,
+	char *to,
+	uint8_t t,
+	bool invert
+)
+{
+	int i, n;
+	int64_t len;
+	uint8_t moves[MAXLEN], tmoves[MAXLEN];
+	char line[4 * MAXLEN];
+	const char *next;
+
+	for ( ; *from != '\0'; from = next+1) {
+		if ((next = strchr(from, '\n')) == NULL ||
+		    next - from >= (ptrdiff_t)sizeof(line))
+			return false;
+		memcpy(line, from, next - from);
+		line[next - from] = '\0';
+		if ((n = readmoves(line, MAXLEN, moves)) < 0)
+			return false;
+
+		for (i = 0; i < n; i++)
+			tmoves[i] = invert ?
+			    inverse_move(transform_move(moves[n-1-i], t)) :
+			    transform_move(moves[i], t);
+		solve_h48_symmetry_canonical(n, tmoves);
+		if (size < 2)
+			return false;
+		len = n == 0 ? 1 : writemoves(tmoves, n, size - 1, to);
+		if (len <= 0)
+			return false;
+		to[len-1] = '\n';
+		to += len;
+		size -= len;
+	}
+	if (size < 1)
+		return false;
+	*to = '\0';
+
+	return true;
+}
+
+/* The pointer to the entry with the given key, or to its empty slot */
+STATIC cache_entry_t **
+cache_find(const cache_key_t *key)
+{
+	cache_entry_t **e;
+
+	for (e = &cache_state.bucket[key->hash % CACHE_BUCKETS];
+	    *e != NULL; e = &(*e)->chain) {
+		if ((*e)->key.hash == key->hash &&
+		    !memcmp((*e)->key.cube, key->cube, sizeof(key->cube)) &&
+		    !strcmp((*e)->key.solver, key->solver) &&
+		    (*e)->key.nissflag == key->nissflag &&
+		    (*e)->key.minmoves == key->minmoves &&
+		    (*e)->key.maxmoves == key->maxmoves &&
+		    (*e)->key.maxsols == key->maxsols &&
+		    (*e)->key.optimal == key->optimal)
+			break;
+	}
+
+	return e;
+}
+
+/* Unlink an entry from the list of the recently used ones and free it */
+STATIC void
+cache_remove(cache_entry_t *entry)
+{
+	cache_entry_t **e;
+
+	for (e = &cache_state.bucket[entry->key.hash % CACHE_BUCKETS];
+	    *e != entry; e = &(*e)->chain) ;
+	*e = entry->chain;
+
+	if (entry->newer != NULL)
+		entry->newer->older = entry->older;
+	else
+		cache_state.newest = entry->older;
+	if (entry->older != NULL)
+		entry->older->newer = entry->newer;
+	else
+		cache_state.oldest = entry->newer;
+
+	cache_state.size -= entry->size;
+	cache_state.entries--;
+	free(entry);
+}
+
+/*
+Look up the solutions of a solve and write them in sols. Returns true and
+sets result if they are found and they fit in sols_size.
+*/
+STATIC bool
+cache_get(
+	const cache_key_t *key,
+	unsigned sols_size,
+	char *sols,
+	long long *result
+)
+{
+	bool ret;
+	cache_entry_t *entry;
+
+	pthread_mutex_lock(&cache_state.mutex);
+	entry = *cache_find(key);
+	ret = entry != NULL && cache_convert(entry->sols, sols_size, sols,
+	    inverse_trans(key->trans), key->inverse);
+	if (ret) {
+		*result = entry->result;
+		cache_state.hits++;
+
+		/* Move the entry to the front of the list */
+		if (entry->newer != NULL) {
+			entry->newer->older = entry->older;
+			if (entry->older != NULL)
+				entry->older->newer = entry->newer;
+			else
+				cache_state.oldest = entry->newer;
+			entry->newer = NULL;
+			entry->older = cache_state.newest;
+			cache_state.newest->newer = entry;
+			cache_state.newest = entry;
+		}
+	} else {
+		cache_state.misses++;
+	}
+	pthread_mutex_unlock(&cache_state.mutex);
+
+	return ret;
+}
+
+/*
+Store the solutions of a solve, removing the oldest entries if needed.
+The solves cut short by maxsols are not stored, see the comment above.
+*/
+STATIC void
+cache_put(const cache_key_t *key, long long result, const char *sols)
+{
+	uint64_t size, len;
+	char *buf;
+	cache_entry_t *entry, **slot;
+
+	/* A transformed move is at most one character longer */
+	len = 2 * strlen(sols) + 1;
+	if (result < 0 || result >= key->maxsols ||
+	    (buf = malloc(len)) == NULL)
+		return;
+	if (!cache_convert(sols, len, buf, key->trans, key->inverse)) {
+		free(buf);
+		return;
+	}
+
+	size = sizeof(cache_entry_t) + strlen(buf) + 1;
+	if ((entry = malloc(size)) == NULL) {
+		free(buf);
+		return;
+	}
+	entry->key = *key;
+	entry->result = result;
+	entry->size = size;
+	memcpy(entry->sols, buf, strlen(buf) + 1);
+	free(buf);
+
+	pthread_mutex_lock(&cache_state.mutex);
+	if (size > cache_state.maxsize ||
+	    *(slot = cache_find(key)) != NULL) {
+		/* Too large, or stored by another thread in the meantime */
+		pthread_mutex_unlock(&cache_state.mutex);
+		free(entry);
+		return;
+	}
+
+	*slot = entry;
+	entry->chain = NULL;
+	entry->newer = NULL;
+	entry->older = cache_state.newest;
+	if (cache_state.newest != NULL)
+		cache_state.newest->newer = entry;
+	else
+		cache_state.oldest = entry;
+	cache_state.newest = entry;
+	cache_state.size += size;
+	cache_state.entries++;
+
+	while (cache_state.size > cache_state.maxsize) {
+		cache_remove(cache_state.oldest);
+		cache_state.evictions++;
+	}
+	pthread_mutex_unlock(&cache_state.mutex);
+}
+
+/* Empty the cache and set its mode and its maximum size */
+STATIC void
+cache_set(uint64_t maxsize, unsigned mode)
+{
+	pthread_mutex_lock(&cache_state.mutex);
+	while (cache_state.oldest != NULL)
+		cache_remove(cache_state.oldest);
+	cache_state.maxsize = maxsize;
+	cache_state.hits = 0;
+	cache_state.misses = 0;
+	cache_state.evictions = 0;
+	atomic_store(&nissy_cache, maxsize == 0 ? NISSY_CACHE_OFF : mode);
+	pthread_mutex_unlock(&cache_state.mutex);
+}
+
+STATIC void
+cache_stats(long long stats[static NISSY_SIZE_CACHE_STATS])
+{
+	pthread_mutex_lock(&cache_state.mutex);
+	stats[0] = cache_state.hits;
+	stats[1] = cache_state.misses;
+	stats[2] = cache_state.evictions;
+	stats[3] = cache_state.entries;
+	stats[4] = cache_state.size;
+	pthread_mutex_unlock(&cache_state.mutex);
+}
@@ -4,6 +4,13 @@
 STATIC_INLINE int64_t coord_h48(cube_t, const uint32_t *, uint8_t);
 STATIC_INLINE int64_t coord_h48_edges(cube_t, int64_t, uint8_t, uint8_t);
 STATIC_INLINE cube_t invcoord_h48(int64_t, const cube_t *, uint8_t);
+STATIC_INLINE void coord_h48_cdata_many(
+    const cube_t *, uint32_t, const uint32_t *, uint32_t *);
+STATIC_INLINE int64_t coord_h48corners(cube_t, int64_t, uint8_t);
+STATIC_INLINE int64_t coord_h48corners_perm4(const uint8_t [static 4]);
+STATIC cube_t invcoord_h48corners(int64_t, const cube_t *);
+STATIC_INLINE int64_t coord_h48eoesep(cube_t);
+STATIC_INLINE cube_t invcoord_h48eoesep(int64_t);
 
 STATIC_INLINE int64_t
 coord_h48(cube_t c, const uint32_t *cocsepdata, uint8_t h)
@@ -36,6 +43,31 @@ coord_h48_edges(cube_t c, int64_t coclass, uint8_t ttrep, uint8_t h)
 	return (coclass * H48_ESIZE(11) + edges) >> (11 - (int64_t)h);
 }
 
+/*
+Batch version of the first step of coord_h48(), which reads the cocsep
+data, so that a caller can discard some cubes (for example using the corner
+bound contained in the cocsep data) before computing the more expensive
+edge coordinate with coord_h48_edges().
+
+Only the entries c[i] such that the i-th bit of mask is set are used, and
+only the corresponding entries of the output array are written, so up to
+32 cubes can be handled at once.
+*/
+STATIC_INLINE void
+coord_h48_cdata_many(
+	const cube_t *c,
+	uint32_t mask,
+	const uint32_t *cocsepdata,
+	uint32_t *data
+)
+{
+	int i;
+
+	for (i = 0; i < 32 && (mask >> i) != 0; i++)
+		if (mask & (UINT32_C(1) << i))
+			data[i] = cocsepdata[coord_cocsep(c[i])];
+}
+
 /*
 This function does not necessarily return a cube whose coordinate is
 the given value, because it works up to symmetry. This means that the
@@ -62,3 +94,88 @@ invcoord_h48(int64_t i, const cube_t *crep, uint8_t h)
 
 	return ret;
 }
+
+/*
+The coordinate of the full corner table: the cocsep class and the
+permutation of the corners inside each tetrad, after the corners are
+transformed by ttrep. The cocsep class determines in which positions the
+corners of each tetrad are, so this is enough to determine the corners.
+Like the h48 coordinate, it is well defined only up to the self-symmetries
+of the cocsep class.
+*/
+STATIC_INLINE int64_t
+coord_h48corners(cube_t c, int64_t coclass, uint8_t ttrep)
+{
+	uint8_t i, t, n[2], p[2][4], corner[8], edge[12];
+	cube_t d;
+
+	d = transform_corners(c, ttrep);
+	pieces(&d, corner, edge);
+	for (i = 0, n[0] = n[1] = 0; i < 8; i++) {
+		t = (corner[i] & CSEPBIT) >> 2;
+		p[t][n[t]++] = corner[i] & UINT8_C(3);
+	}
+
+	return coclass * H48_CPSIZE + coord_h48corners_perm4(p[0]) * 24 +
+	    coord_h48corners_perm4(p[1]);
+}
+
+/* Same as permtoindex(p, 4), without the checks */
+STATIC_INLINE int64_t
+coord_h48corners_perm4(const uint8_t p[static 4])
+{
+	return 6 * ((p[1] < p[0]) + (p[2] < p[0]) + (p[3] < p[0])) +
+	    2 * ((p[2] < p[1]) + (p[3] < p[1])) + (p[3] < p[2]);
+}
+
+/*
+As for invcoord_h48(), the returned cube has the given coordinate only up
+to symmetry. The edges of the returned cube are solved.
+*/
+STATIC cube_t
+invcoord_h48corners(int64_t i, const cube_t *crep)
+{
+	uint8_t j, t, n[2], p[2][4], corner[8], edge[12];
+	int64_t coclass, cp;
+	cube_t ret;
+
+	coclass = i / H48_CPSIZE;
+	cp = i % H48_CPSIZE;
+	indextoperm(cp / 24, 4, p[0]);
+	indextoperm(cp % 24, 4, p[1]);
+
+	ret = crep[coclass];
+	pieces(&ret, corner, edge);
+	for (j = 0, n[0] = n[1] = 0; j < 8; j++) {
+		t = (corner[j] & CSEPBIT) >> 2;
+		corner[j] = (corner[j] & ~UINT8_C(3)) | p[t][n[t]++];
+	}
+	copy_corners(&ret, cubefromarray(corner, edge));
+	copy_edges(&ret, SOLVED_CUBE);
+
+	return ret;
+}
+
+/*
+The coordinate of the edge table: the slice of the edge in each position,
+as for the h48 coordinate, and the orientation of all edges. It does not
+depend on the corners, so it is not reduced by symmetry and it can be
+computed without the cocsep data.
+*/
+STATIC_INLINE int64_t
+coord_h48eoesep(cube_t c)
+{
+	return (coord_esep(c) << INT64_C(11)) + coord_eo(c);
+}
+
+/* The corners of the returned cube are solved */
+STATIC_INLINE cube_t
+invcoord_h48eoesep(int64_t i)
+{
+	cube_t ret;
+
+	ret = invcoord_esep(i >> INT64_C(11));
+	set_eo(&ret, i & INT64_C(0x7FF));
+
+	return ret;
+}
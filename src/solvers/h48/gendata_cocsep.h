@@ -96,7 +96,7 @@ gendata_cocsep_dfs(cocsep_dfs_arg_t *arg)
 	uint32_t cc, class, ttrep, depth, olddepth, tinv;
 	uint64_t t;
 	int64_t i, j;
-	cube_t d;
+	cube_t d, next[18];
 	cocsep_dfs_arg_t nextarg;
 
 	i = coord_cocsep(arg->cube);
@@ -135,8 +135,9 @@ gendata_cocsep_dfs(cocsep_dfs_arg_t *arg)
 
 	nextarg = *arg;
 	nextarg.depth++;
+	expand_moves(arg->cube, MM_ALLMOVES, next);
 	for (m = 0, cc = 0; m < 18; m++) {
-		nextarg.cube = move(arg->cube, m);
+		nextarg.cube = next[m];
 		cc += gendata_cocsep_dfs(&nextarg);
 	}
 
@@ -0,0 +1,122 @@
+STATIC size_t gendata_h48corners(const gendata_h48_arg_t *, void *);
+STATIC_INLINE int64_t gendata_h48corners_mark(
+    cube_t, uint8_t, const uint32_t *, const uint64_t *, uint8_t *);
+STATIC void getdistribution_h48corners(
+    const uint8_t *, uint64_t [static INFO_DISTRIBUTION_LEN]);
+
+/*
+The full corner table contains, for each position of the corners up to
+symmetry, the number of moves needed to solve them. There is one entry
+of 4 bits for each value of the coordinate computed by coord_h48corners(),
+so the table is smaller than 1MB. Positions whose cocsep class has some
+self-symmetries have more than one coordinate, and all of them are marked,
+as for the h48 tables.
+
+The table is generated with a breadth-first search on a single thread,
+which takes a few seconds. The cocsep table must be already generated, and
+the self-symmetries and the representatives of the cocsep classes must be
+in arg.
+*/
+STATIC size_t
+gendata_h48corners(const gendata_h48_arg_t *arg, void *buf)
+{
+	uint8_t d, m, *table;
+	int64_t i, n, done;
+	uint64_t bufsize;
+	cube_t cube, moved[18];
+	tableinfo_t info;
+
+	if (buf == NULL)
+		goto gendata_h48corners_return_size;
+
+	info = (tableinfo_t) {
+		.solver = "corners data for h48",
+		.type = TABLETYPE_PRUNING,
+		.infosize = INFOSIZE,
+		.fullsize = H48_CORNERS_FULLSIZE,
+		.hash = 0, /* TODO */
+		.entries = H48_CORNERS_COORDMAX,
+		.classes = 0,
+		.h48h = 0,
+		.bits = 4,
+		.base = 0,
+		.maxvalue = 0,
+		.next = 0,
+	};
+
+	table = (uint8_t *)buf + INFOSIZE;
+	memset(table, 0xFF, H48_CORNERS_TABLESIZE);
+
+	done = gendata_h48corners_mark(
+	    SOLVED_CUBE, 0, arg->cocsepdata, arg->selfsim, table);
+	for (d = 1, n = done; n > 0 && done < H48_CORNERS_COORDMAX; d++) {
+		LOG("h48 corners: generating depth %" PRIu8 "\n", d);
+		GENDATA_PHASE_BEGIN("corners_bfs", d);
+		for (i = 0, n = 0; i < H48_CORNERS_COORDMAX; i++) {
+			if (get_h48_pval(table, i, 4) != d-1)
+				continue;
+			cube = invcoord_h48corners(i, arg->crep);
+			expand_moves(cube, MM_ALLMOVES, moved);
+			for (m = 0; m < 18; m++)
+				n += gendata_h48corners_mark(moved[m], d,
+				    arg->cocsepdata, arg->selfsim, table);
+		}
+		GENDATA_PHASE_END(H48_CORNERS_COORDMAX, H48_CORNERS_TABLESIZE);
+		done += n;
+		if (n > 0)
+			info.maxvalue = d;
+		LOG("found %" PRId64 "\n", n);
+	}
+
+	getdistribution_h48corners(table, info.distribution);
+
+	bufsize = arg->buf_size - ((char *)buf - (char *)arg->buf);
+	writetableinfo(&info, bufsize, buf);
+
+gendata_h48corners_return_size:
+	return H48_CORNERS_FULLSIZE;
+}
+
+/* Returns the number of entries that have been set */
+STATIC_INLINE int64_t
+gendata_h48corners_mark(
+	cube_t cube,
+	uint8_t depth,
+	const uint32_t *cocsepdata,
+	const uint64_t *selfsim,
+	uint8_t *table
+)
+{
+	uint8_t t, ttrep;
+	int64_t cocsep, coclass, coord, n;
+	uint64_t s;
+
+	cocsep = coord_cocsep(cube);
+	ttrep = TTREP(cocsepdata[cocsep]);
+	coclass = COCLASS(cocsepdata[cocsep]);
+	for (t = 0, n = 0, s = selfsim[coclass]; t < 48 && s; t++, s >>= 1) {
+		if (!(s & 1))
+			continue;
+		coord = coord_h48corners(
+		    cube, coclass, compose_trans(ttrep, t));
+		if (get_h48_pval(table, coord, 4) > depth) {
+			set_h48_pval(table, coord, 4, depth);
+			n++;
+		}
+	}
+
+	return n;
+}
+
+STATIC void
+getdistribution_h48corners(
+	const uint8_t *table,
+	uint64_t distr[static INFO_DISTRIBUTION_LEN]
+)
+{
+	int64_t i;
+
+	memset(distr, 0, INFO_DISTRIBUTION_LEN * sizeof(uint64_t));
+	for (i = 0; i < H48_CORNERS_COORDMAX; i++)
+		distr[get_h48_pval(table, i, 4)]++;
+}
@@ -0,0 +1,122 @@
+STATIC size_t gendata_h48eoesep(const gendata_h48_arg_t *, void *);
+STATIC_INLINE bool gendata_h48eoesep_backward(const uint8_t *, cube_t, uint8_t);
+STATIC void getdistribution_h48eoesep(
+    const uint8_t *, uint64_t [static INFO_DISTRIBUTION_LEN]);
+
+/*
+The edge table contains, for each value of coord_h48eoesep(), the number
+of moves needed to solve the edge orientation and to bring the edges to
+their slices. It complements the h48 tables with small h, that only use
+part of the edge orientation, and it uses 4 bits per entry (about 35MB).
+
+The table is generated with a breadth-first search on a single thread.
+When more than half of the table has been filled, it is faster to look
+for the positions that are not yet marked and have a neighbor in the
+previous layer than to expand the previous layer.
+*/
+STATIC size_t
+gendata_h48eoesep(const gendata_h48_arg_t *arg, void *buf)
+{
+	bool backward;
+	uint8_t d, m, *table;
+	int64_t i, n, done, coord;
+	uint64_t bufsize;
+	cube_t cube, moved[18];
+	tableinfo_t info;
+
+	if (buf == NULL)
+		goto gendata_h48eoesep_return_size;
+
+	info = (tableinfo_t) {
+		.solver = "eoesep data for h48",
+		.type = TABLETYPE_PRUNING,
+		.infosize = INFOSIZE,
+		.fullsize = H48_EOESEP_FULLSIZE,
+		.hash = 0, /* TODO */
+		.entries = H48_EOESEP_COORDMAX,
+		.classes = 0,
+		.h48h = 0,
+		.bits = 4,
+		.base = 0,
+		.maxvalue = 0,
+		.next = 0,
+	};
+
+	table = (uint8_t *)buf + INFOSIZE;
+	memset(table, 0xFF, H48_EOESEP_TABLESIZE);
+
+	set_h48_pval(table, coord_h48eoesep(SOLVED_CUBE), 4, 0);
+	for (d = 1, n = done = 1; n > 0 && done < H48_EOESEP_COORDMAX; d++) {
+		backward = done > H48_EOESEP_COORDMAX / 2;
+		LOG("h48 eoesep: generating depth %" PRIu8 " (%s)\n",
+		    d, backward ? "backward" : "forward");
+		GENDATA_PHASE_BEGIN("eoesep_bfs", d);
+		for (i = 0, n = 0; i < H48_EOESEP_COORDMAX; i++) {
+			if (backward) {
+				if (get_h48_pval(table, i, 4) != 0xF)
+					continue;
+				cube = invcoord_h48eoesep(i);
+				if (gendata_h48eoesep_backward(table, cube, d)) {
+					set_h48_pval(table, i, 4, d);
+					n++;
+				}
+			} else {
+				if (get_h48_pval(table, i, 4) != d-1)
+					continue;
+				cube = invcoord_h48eoesep(i);
+				expand_moves(cube, MM_ALLMOVES, moved);
+				for (m = 0; m < 18; m++) {
+					coord = coord_h48eoesep(moved[m]);
+					if (get_h48_pval(table, coord, 4) != 0xF)
+						continue;
+					set_h48_pval(table, coord, 4, d);
+					n++;
+				}
+			}
+		}
+		GENDATA_PHASE_END(H48_EOESEP_COORDMAX, H48_EOESEP_TABLESIZE);
+		done += n;
+		if (n > 0)
+			info.maxvalue = d;
+		LOG("found %" PRId64 "\n", n);
+	}
+
+	getdistribution_h48eoesep(table, info.distribution);
+
+	bufsize = arg->buf_size - ((char *)buf - (char *)arg->buf);
+	writetableinfo(&info, bufsize, buf);
+
+gendata_h48eoesep_return_size:
+	return H48_EOESEP_FULLSIZE;
+}
+
+/* Returns true if cube has a neighbor at depth d-1 */
+STATIC_INLINE bool
+gendata_h48eoesep_backward(const uint8_t *table, cube_t cube, uint8_t d)
+{
+	uint8_t m;
+	int64_t coord;
+	cube_t moved[18];
+
+	expand_moves(cube, MM_ALLMOVES, moved);
+	for (m = 0; m < 18; m++) {
+		coord = coord_h48eoesep(moved[m]);
+		if (get_h48_pval(table, coord, 4) == d-1)
+			return true;
+	}
+
+	return false;
+}
+
+STATIC void
+getdistribution_h48eoesep(
+	const uint8_t *table,
+	uint64_t distr[static INFO_DISTRIBUTION_LEN]
+)
+{
+	int64_t i;
+
+	memset(distr, 0, INFO_DISTRIBUTION_LEN * sizeof(uint64_t));
+	for (i = 0; i < H48_EOESEP_COORDMAX; i++)
+		distr[get_h48_pval(table, i, 4)]++;
+}
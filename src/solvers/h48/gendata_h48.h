@@ -3,6 +3,9 @@ STATIC int64_t gendata_h48(gendata_h48_arg_t *);
 STATIC void gendata_h48h0k4(gendata_h48_arg_t *);
 STATIC void gendata_h48k2(gendata_h48_arg_t *);
 STATIC void gendata_h48k2_realcoord(gendata_h48_arg_t *);
+STATIC size_t gendata_h48corners(const gendata_h48_arg_t *, void *);
+STATIC size_t gendata_h48eoesep(const gendata_h48_arg_t *, void *);
+STATIC size_t gendata_h48extra(const gendata_h48_arg_t *, char, void *);
 
 STATIC void * gendata_h48h0k4_runthread(void *);
 STATIC void * gendata_h48k2_runthread(void *);
@@ -11,7 +14,7 @@ STATIC_INLINE void gendata_h48_mark_atomic(gendata_h48_mark_t *);
 STATIC_INLINE void gendata_h48_mark(gendata_h48_mark_t *);
 STATIC_INLINE bool gendata_h48k2_dfs_stop(cube_t, int8_t, h48k2_dfs_arg_t *);
 STATIC void gendata_h48k2_dfs(h48k2_dfs_arg_t *arg);
-STATIC tableinfo_t makeinfo_h48k2(gendata_h48_arg_t *);
+STATIC tableinfo_t makeinfo_h48(gendata_h48_arg_t *);
 STATIC void getdistribution_h48(const uint8_t *,
     uint64_t [static INFO_DISTRIBUTION_LEN], uint8_t, uint8_t);
 
@@ -34,7 +37,7 @@ gendata_h48short(gendata_h48short_arg_t *arg)
 	int64_t coord;
 	uint64_t j;
 	kvpair_t kv;
-	cube_t cube, d;
+	cube_t cube, d[18];
 
 	cube = SOLVED_CUBE;
 	coord = coord_h48(cube, arg->cocsepdata, 11);
@@ -48,10 +51,10 @@ gendata_h48short(gendata_h48short_arg_t *arg)
 			if (kv.val != i)
 				continue;
 			cube = invcoord_h48(kv.key, arg->crep, 11);
+			expand_moves(cube, MM_ALLMOVES, d);
 			for (m = 0; m < 18; m++) {
-				d = move(cube, m);
-				FOREACH_H48SIM(d, arg->cocsepdata, arg->selfsim,
-					coord = coord_h48(d, arg->cocsepdata, 11);
+				FOREACH_H48SIM(d[m], arg->cocsepdata, arg->selfsim,
+				    11, coord,
 					h48map_insertmin(arg->map, coord, i+1);
 				)
 			}
@@ -65,9 +68,10 @@ gendata_h48short(gendata_h48short_arg_t *arg)
 STATIC int64_t
 gendata_h48(gendata_h48_arg_t *arg)
 {
-	uint64_t size, cocsepsize, h48size, fallbacksize;
-	void *cocsepdata_offset;
-	tableinfo_t cocsepinfo, h48info;
+	uint8_t i;
+	uint64_t size, cocsepsize, h48size, fallbacksize, extrasize;
+	void *cocsepdata_offset, *last, *extra;
+	tableinfo_t cocsepinfo, h48info, lastinfo;
 	gendata_h48_arg_t arg_h0k4;
 
 	if (arg == NULL) {
@@ -77,8 +81,10 @@ gendata_h48(gendata_h48_arg_t *arg)
 
 	cocsepsize = COCSEP_FULLSIZE;
 	h48size = INFOSIZE + H48_TABLESIZE(arg->h, arg->k);
-	fallbacksize = arg->k == 2 ? INFOSIZE + H48_TABLESIZE(0, 4) : 0;
-	size = cocsepsize + h48size + fallbacksize;
+	fallbacksize = arg->k != 4 ? INFOSIZE + H48_TABLESIZE(0, 4) : 0;
+	for (i = 0, extrasize = 0; arg->extra[i] != '\0'; i++)
+		extrasize += gendata_h48extra(arg, arg->extra[i], NULL);
+	size = cocsepsize + h48size + fallbacksize + extrasize;
 
 	if (arg->buf == NULL)
 		return size; /* Dry-run */
@@ -90,19 +96,19 @@ gendata_h48(gendata_h48_arg_t *arg)
 		return NISSY_ERROR_BUFFER_SIZE;
 	}
 
+	GENDATA_PHASE_BEGIN("cocsep", -1);
 	gendata_cocsep(arg->buf, arg->selfsim, arg->crep);
+	GENDATA_PHASE_END(COCSEP_TABLESIZE, COCSEP_FULLSIZE);
 
 	cocsepdata_offset = (char *)arg->buf + INFOSIZE;
 	arg->cocsepdata = (uint32_t *)cocsepdata_offset;
 	arg->h48buf = (char *)arg->buf + cocsepsize;
 
-	arg->base = 99; /* TODO: set this somewhere else */
-
 	if (arg->h == 0 && arg->k == 4) {
 		gendata_h48h0k4(arg);
 	} else if ((arg->h == 0 || arg->h == 11) && arg->k == 2) {
 		gendata_h48k2_realcoord(arg);
-	} else if (arg->k == 2) {
+	} else if (arg->k == 1 || arg->k == 2 || arg->k == 4) {
 		gendata_h48k2(arg);
 	} else {
 		LOG("Cannot generate data for h = %" PRIu8 " and k = %" PRIu8
@@ -122,7 +128,7 @@ gendata_h48(gendata_h48_arg_t *arg)
 		return NISSY_ERROR_UNKNOWN;
 	}
 
-	if (arg->k == 2) {
+	if (arg->k != 4) {
 		arg_h0k4 = *arg;
 		arg_h0k4.h = 0;
 		arg_h0k4.k = 4;
@@ -148,16 +154,57 @@ gendata_h48(gendata_h48_arg_t *arg)
 		}
 	}
 
+	/* The extra tables are appended after the others, in order */
+	last = arg->k == 4 ? arg->h48buf : (char *)arg->h48buf + h48size;
+	extra = (char *)arg->buf + size - extrasize;
+	for (i = 0; arg->extra[i] != '\0'; i++) {
+		if (readtableinfo(arg->buf_size, last, &lastinfo) != NISSY_OK) {
+			LOG("gendata_h48: could not read info for the table"
+			    " before the extra table %c\n", arg->extra[i]);
+			return NISSY_ERROR_UNKNOWN;
+		}
+
+		lastinfo.next = (char *)extra - (char *)last;
+		if (writetableinfo(&lastinfo, arg->buf_size, last)
+		    != NISSY_OK) {
+			LOG("gendata_h48: could not write info for the table"
+			    " before the extra table %c\n", arg->extra[i]);
+			return NISSY_ERROR_UNKNOWN;
+		}
+
+		last = extra;
+		extra = (char *)extra +
+		    gendata_h48extra(arg, arg->extra[i], extra);
+	}
+
 	return size;
 }
 
+/*
+Generate the extra table identified by the letter t (see H48_EXTRATABLES)
+in buf and return its size. If buf is NULL, only the size is returned.
+*/
+STATIC size_t
+gendata_h48extra(const gendata_h48_arg_t *arg, char t, void *buf)
+{
+	switch (t) {
+	case 'c':
+		return gendata_h48corners(arg, buf);
+	case 'e':
+		return gendata_h48eoesep(arg, buf);
+	default:
+		LOG("gendata_h48: unknown extra table %c\n", t);
+		return 0;
+	}
+}
+
 STATIC void
 gendata_h48h0k4(gendata_h48_arg_t *arg)
 {
 	_Atomic uint8_t *table;
 	uint8_t val;
 	int64_t i, sc, done, d, h48max;
-	uint64_t t, tt, isize, cc, bufsize;
+	uint64_t t, tt, isize, cc, bufsize, nthreads;
 	h48h0k4_bfs_arg_t bfsarg[THREADS];
 	pthread_t thread[THREADS];
 	pthread_mutex_t table_mutex[CHUNKS];
@@ -185,18 +232,19 @@ gendata_h48h0k4(gendata_h48_arg_t *arg)
 	set_h48_pval_atomic(table, sc, 4, 0);
 	arg->info.distribution[0] = 1;
 
-	isize = h48max / THREADS;
+	nthreads = atomic_load(&nissy_threads);
+	isize = h48max / nthreads;
 	isize = (isize / H48_COEFF(arg->k)) * H48_COEFF(arg->k);
 	for (t = 0; t < CHUNKS; t++)
 		pthread_mutex_init(&table_mutex[t], NULL);
-	for (t = 0; t < THREADS; t++) {
+	for (t = 0; t < nthreads; t++) {
 		bfsarg[t] = (h48h0k4_bfs_arg_t) {
 			.cocsepdata = arg->cocsepdata,
 			.table = table,
 			.selfsim = arg->selfsim,
 			.crep = arg->crep,
 			.start = isize * t,
-			.end = t == THREADS-1 ? (uint64_t)h48max : isize * (t+1),
+			.end = t == nthreads-1 ? (uint64_t)h48max : isize * (t+1),
 		};
 		for (tt = 0; tt < CHUNKS; tt++)
 			bfsarg[t].table_mutex[tt] = &table_mutex[tt];
@@ -204,19 +252,23 @@ gendata_h48h0k4(gendata_h48_arg_t *arg)
 	for (done = 1, d = 1; done < h48max && d <= arg->maxdepth; d++) {
 		LOG("h48: generating depth %" PRIu8 "\n", d);
 
-		for (t = 0; t < THREADS; t++) {
+		GENDATA_PHASE_BEGIN("h0k4_bfs", d);
+		for (t = 0; t < nthreads; t++) {
 			bfsarg[t].depth = d;
 			pthread_create(&thread[t], NULL,
 			    gendata_h48h0k4_runthread, &bfsarg[t]);
 		}
 
-		for (t = 0; t < THREADS; t++)
+		for (t = 0; t < nthreads; t++)
 			pthread_join(thread[t], NULL);
+		GENDATA_PHASE_END(h48max, H48_TABLESIZE(0, 4));
 
+		GENDATA_PHASE_BEGIN("h0k4_count", d);
 		for (i = 0, cc = 0; i < h48max; i++) {
 			val = get_h48_pval_atomic(table, i, 4);
 			cc += val == d;
 		}
+		GENDATA_PHASE_END(h48max, H48_TABLESIZE(0, 4));
 
 		done += cc;
 		arg->info.distribution[d] = cc;
@@ -322,6 +374,10 @@ gendata_h48k2(gendata_h48_arg_t *arg)
 	 * with value 0, at the cost of a less precise estimate for the higher
 	 * values. But I am not 100% confident this is the optimal choice,
 	 * so I'll leave it here for future considerations.
+	 *
+	 * The tool tools/201_tune_base_h48k2 estimates the cost of the
+	 * search for each base by sampling, and can generate a table with
+	 * the best one. These values are used when no base is given.
 	 */
 	 
 	static const uint8_t base[] = {
@@ -339,10 +395,30 @@ gendata_h48k2(gendata_h48_arg_t *arg)
 		[11] = 10
 	};
 
-	uint8_t t;
+	/*
+	 * With k=1 the positions at distance more than the base get the
+	 * lower bound base + 1, all the others need a second lookup. These
+	 * values have been chosen with tools/201_tune_base_h48k2.
+	 */
+	static const uint8_t base_k1[] = {
+		[0]  = 8,
+		[1]  = 8,
+		[2]  = 8,
+		[3]  = 8,
+		[4]  = 8,
+		[5]  = 9,
+		[6]  = 9,
+		[7]  = 9,
+		[8]  = 9,
+		[9]  = 9,
+		[10] = 9,
+		[11] = 9
+	};
+
+	uint8_t t, fill;
 	uint8_t *table;
 	int64_t j;
-	uint64_t i, ii, inext, count, bufsize;
+	uint64_t i, ii, inext, count, bufsize, nthreads;
 	h48map_t shortcubes;
 	gendata_h48short_arg_t shortarg;
 	h48k2_dfs_arg_t dfsarg[THREADS];
@@ -353,6 +429,7 @@ gendata_h48k2(gendata_h48_arg_t *arg)
 	memset(table, 0xFF, H48_TABLESIZE(arg->h, arg->k));
 
 	LOG("Computing depth <=%" PRIu8 "\n", shortdepth)
+	GENDATA_PHASE_BEGIN("k2_short", shortdepth);
 	h48map_create(&shortcubes, capacity, randomizer);
 	shortarg = (gendata_h48short_arg_t) {
 		.maxdepth = shortdepth,
@@ -363,20 +440,36 @@ gendata_h48k2(gendata_h48_arg_t *arg)
 	};
 	gendata_h48short(&shortarg);
 	LOG("Computed %" PRIu64 " positions\n", shortarg.map->n);
+	GENDATA_PHASE_END(shortarg.map->n, capacity * sizeof(uint64_t));
 
+	/*
+	 * The search reaches all positions at distance up to base + 2, the
+	 * others get the largest value. With k = 1 we only need to know
+	 * which positions are at distance up to base. With k = 4 the table
+	 * stores the distance itself (base 0), but we use the same maximum
+	 * depth as for k = 2: this way a k = 4 table is never less precise
+	 * than the k = 2 table with the same h and its h0k4 fallback, and it
+	 * does not need a second lookup for positions close to solved.
+	 */
 	if (arg->base >= 20)
-		arg->base = base[arg->h];
-	arg->info = makeinfo_h48k2(arg);
+		arg->base = arg->k == 1 ? base_k1[arg->h] : base[arg->h];
+	arg->maxdepth = MIN(arg->maxdepth, arg->base + (arg->k == 1 ? 0 : 2));
+	if (arg->k == 4)
+		arg->base = 0;
+	arg->info = makeinfo_h48(arg);
 
+	GENDATA_PHASE_BEGIN("k2_dfs", -1);
 	inext = count = 0;
+	nthreads = atomic_load(&nissy_threads);
 	pthread_mutex_init(&shortcubes_mutex, NULL);
 	for (i = 0; i < CHUNKS; i++)
 		pthread_mutex_init(&table_mutex[i], NULL);
-	for (i = 0; i < THREADS; i++) {
+	for (i = 0; i < nthreads; i++) {
 		dfsarg[i] = (h48k2_dfs_arg_t){
 			.h = arg->h,
 			.k = arg->k,
 			.base = arg->base,
+			.maxdepth = arg->maxdepth,
 			.shortdepth = shortdepth,
 			.cocsepdata = arg->cocsepdata,
 			.table = table,
@@ -394,15 +487,24 @@ gendata_h48k2(gendata_h48_arg_t *arg)
 		    &thread[i], NULL, gendata_h48k2_runthread, &dfsarg[i]);
 	}
 
-	for (i = 0; i < THREADS; i++)
+	for (i = 0; i < nthreads; i++)
 		pthread_join(thread[i], NULL);
 
 	h48map_destroy(&shortcubes);
+	GENDATA_PHASE_END(count, H48_TABLESIZE(arg->h, arg->k));
 
+	GENDATA_PHASE_BEGIN("k2_count", -1);
+	fill = arg->maxdepth + 1 - arg->base;
 	for (j = 0; j < H48_COORDMAX(arg->h); j++) {
-		t = get_h48_pval(table, j, 2);
+		t = get_h48_pval(table, j, arg->k);
+		if (t > fill) {
+			t = fill;
+			set_h48_pval(table, j, arg->k, t);
+		}
 		arg->info.distribution[t]++;
 	}
+	GENDATA_PHASE_END(
+	    H48_COORDMAX(arg->h), H48_TABLESIZE(arg->h, arg->k));
 
 	bufsize = arg->buf_size - COCSEP_FULLSIZE;
 	writetableinfo(&arg->info, bufsize, arg->h48buf);
@@ -411,6 +513,7 @@ gendata_h48k2(gendata_h48_arg_t *arg)
 STATIC void *
 gendata_h48k2_runthread(void *arg)
 {
+	uint8_t val, oldval;
 	uint64_t count, coord, mutex;
 	kvpair_t kv;
 	h48k2_dfs_arg_t *dfsarg;
@@ -433,9 +536,13 @@ gendata_h48k2_runthread(void *arg)
 
 		if (kv.val < dfsarg->shortdepth) {
 			coord = kv.key >> (int64_t)(11 - dfsarg->h);
+			val = (uint8_t)MAX((int)kv.val - dfsarg->base, 0);
+			val = MIN(val, UINT8_BIT(dfsarg->k) - 1);
 			mutex = H48_INDEX(coord, dfsarg->k) % CHUNKS;
 			pthread_mutex_lock(dfsarg->table_mutex[mutex]);
-			set_h48_pval(dfsarg->table, coord, dfsarg->k, 0);
+			oldval = get_h48_pval(dfsarg->table, coord, dfsarg->k);
+			set_h48_pval(
+			    dfsarg->table, coord, dfsarg->k, MIN(val, oldval));
 			pthread_mutex_unlock(dfsarg->table_mutex[mutex]);
 		} else {
 			dfsarg->cube = invcoord_h48(kv.key, dfsarg->crep, 11);
@@ -451,7 +558,8 @@ gendata_h48k2_dfs(h48k2_dfs_arg_t *arg)
 {
 	int8_t d;
 	uint8_t m[4];
-	cube_t cube[4];
+	uint32_t allowed[4];
+	cube_t cube[4][18];
 	gendata_h48_mark_t markarg;
 
 	markarg = (gendata_h48_mark_t) {
@@ -469,55 +577,57 @@ gendata_h48k2_dfs(h48k2_dfs_arg_t *arg)
 	markarg.depth = d;
 	markarg.cube = arg->cube;
 	gendata_h48_mark(&markarg);
+	if (arg->shortdepth >= arg->maxdepth)
+		return;
 
 	/* Depth d+1 */
+	allowed[0] = MM_ALLMOVES;
+	expand_moves(arg->cube, allowed[0], cube[0]);
 	for (m[0] = 0; m[0] < 18; m[0]++) {
 		markarg.depth = d+1;
-		cube[0] = move(arg->cube, m[0]);
-		if (gendata_h48k2_dfs_stop(cube[0], d+1, arg))
+		if (gendata_h48k2_dfs_stop(cube[0][m[0]], d+1, arg))
 			continue;
-		markarg.cube = cube[0];
+		markarg.cube = cube[0][m[0]];
 		gendata_h48_mark(&markarg);
+		if (arg->shortdepth + 1 >= arg->maxdepth)
+			continue;
 
 		/* Depth d+2 */
+		allowed[1] = allowednextmove_h48(m, 1, MM_NORMAL);
+		expand_moves(cube[0][m[0]], allowed[1], cube[1]);
 		for (m[1] = 0; m[1] < 18; m[1]++) {
 			markarg.depth = d+2;
-			if (m[0] / 3 == m[1] / 3) {
-				m[1] += 2;
+			if (!(allowed[1] & (UINT32_C(1) << m[1])))
 				continue;
-			}
-			cube[1] = move(cube[0], m[1]);
-			if (gendata_h48k2_dfs_stop(cube[1], d+2, arg))
+			if (gendata_h48k2_dfs_stop(cube[1][m[1]], d+2, arg))
 				continue;
-			markarg.cube = cube[1];
+			markarg.cube = cube[1][m[1]];
 			gendata_h48_mark(&markarg);
-			if (d >= 0)
+			if (arg->shortdepth + 2 >= arg->maxdepth)
 				continue;
 
 			/* Depth d+3 */
+			allowed[2] = allowednextmove_h48(m, 2, MM_NORMAL);
+			expand_moves(cube[1][m[1]], allowed[2], cube[2]);
 			for (m[2] = 0; m[2] < 18; m[2]++) {
 				markarg.depth = d+3;
-				if (!allowednextmove(m, 3)) {
-					m[2] += 2;
+				if (!(allowed[2] & (UINT32_C(1) << m[2])))
 					continue;
-				}
-				cube[2] = move(cube[1], m[2]);
-				if (gendata_h48k2_dfs_stop(cube[2], d+3, arg))
+				if (gendata_h48k2_dfs_stop(cube[2][m[2]], d+3, arg))
 					continue;
-				markarg.cube = cube[2];
+				markarg.cube = cube[2][m[2]];
 				gendata_h48_mark(&markarg);
-				if (d >= -1)
+				if (arg->shortdepth + 3 >= arg->maxdepth)
 					continue;
 
 				/* Depth d+4 */
+				allowed[3] = allowednextmove_h48(m, 3, MM_NORMAL);
+				expand_moves(cube[2][m[2]], allowed[3], cube[3]);
 				for (m[3] = 0; m[3] < 18; m[3]++) {
 					markarg.depth = d+4;
-					if (!allowednextmove(m, 4)) {
-						m[3] += 2;
+					if (!(allowed[3] & (UINT32_C(1) << m[3])))
 						continue;
-					}
-					cube[3] = move(cube[2], m[3]);
-					markarg.cube = cube[3];
+					markarg.cube = cube[3][m[3]];
 					gendata_h48_mark(&markarg);
 				}
 			}
@@ -532,7 +642,7 @@ gendata_h48_mark_atomic(gendata_h48_mark_t *arg)
 	int64_t coord, mutex;
 
 	FOREACH_H48SIM(arg->cube, arg->cocsepdata, arg->selfsim,
-		coord = coord_h48(arg->cube, arg->cocsepdata, arg->h);
+	    arg->h, coord,
 		oldval = get_h48_pval_atomic(arg->table_atomic, coord, arg->k);
 		newval = (uint8_t)MAX(arg->depth, 0);
 		if (newval < oldval) {
@@ -552,11 +662,12 @@ gendata_h48_mark(gendata_h48_mark_t *arg)
 	int64_t coord, mutex;
 
 	FOREACH_H48SIM(arg->cube, arg->cocsepdata, arg->selfsim,
-		coord = coord_h48(arg->cube, arg->cocsepdata, arg->h);
+	    arg->h, coord,
 		mutex = H48_INDEX(coord, arg->k) % CHUNKS;
 		pthread_mutex_lock(arg->table_mutex[mutex]);
 		oldval = get_h48_pval(arg->table, coord, arg->k);
 		newval = (uint8_t)MAX(arg->depth, 0);
+		newval = MIN(newval, UINT8_BIT(arg->k) - 1);
 		set_h48_pval(arg->table, coord, arg->k, MIN(newval, oldval));
 		pthread_mutex_unlock(arg->table_mutex[mutex]);
 	)
@@ -603,24 +714,26 @@ gendata_h48k2_realcoord_runthread(void *arg)
 }
 
 STATIC tableinfo_t
-makeinfo_h48k2(gendata_h48_arg_t *arg)
+makeinfo_h48(gendata_h48_arg_t *arg)
 {
 	tableinfo_t info;
 
 	info = (tableinfo_t) {
-		.solver = "h48 solver h =  , k = 2",
+		.solver = "h48 solver h =  , k =  ",
 		.type = TABLETYPE_PRUNING,
 		.infosize = INFOSIZE,
-		.fullsize = H48_TABLESIZE(arg->h, 2) + INFOSIZE,
+		.fullsize = H48_TABLESIZE(arg->h, arg->k) + INFOSIZE,
 		.hash = 0, /* TODO */
 		.entries = H48_COORDMAX(arg->h),
 		.classes = 0,
 		.h48h = arg->h,
-		.bits = 2,
+		.bits = arg->k,
 		.base = arg->base,
-		.maxvalue = 3,
+		.maxvalue = arg->k == 4 ?
+		    arg->maxdepth + 1 : UINT8_BIT(arg->k) - 1,
 		.next = 0,
 	};
+	info.solver[22] = arg->k + '0';
 	info.solver[15] = (arg->h % 10) + '0';
 	if (arg->h >= 10)
 		info.solver[14] = (arg->h / 10) + '0';
@@ -701,6 +814,7 @@ gendata_h48_derive(uint8_t h, const void *fulltable, void *buf)
 	fulltableinfo.h48h = 11;
 	fulltableinfo.bits = 2;
 	fulltableinfo.base = 8;
+	fulltableinfo.maxvalue = 3;
 
 	int64_t TODOlarge = 999999999999; /* TODO: cleanup here */
 
@@ -711,7 +825,8 @@ gendata_h48_derive(uint8_t h, const void *fulltable, void *buf)
 	arg.buf = buf;
 	arg.cocsepdata = (uint32_t *)((char *)buf + INFOSIZE);
 	arg.base = fulltableinfo.base;
-	arg.info = makeinfo_h48k2(&arg);
+	arg.info = makeinfo_h48(&arg);
+	arg.info.maxvalue = fulltableinfo.maxvalue;
 
 	/* Technically this step is redundant, except that we
 	   need selfsim and crep */
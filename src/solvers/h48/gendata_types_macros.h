@@ -14,6 +14,22 @@
 #define H48_DIV(k)          ((size_t)8 / (size_t)(k))
 #define H48_TABLESIZE(h, k) DIV_ROUND_UP((size_t)H48_COORDMAX((h)), H48_DIV(k))
 
+#define H48_CORNERS_COORDMAX  ((int64_t)COCSEP_CLASSES * H48_CPSIZE)
+#define H48_CORNERS_TABLESIZE DIV_ROUND_UP((size_t)H48_CORNERS_COORDMAX, 2)
+#define H48_CORNERS_FULLSIZE  (INFOSIZE + H48_CORNERS_TABLESIZE)
+
+#define H48_EOESEP_COORDMAX   H48_ESIZE(11)
+#define H48_EOESEP_TABLESIZE  DIV_ROUND_UP((size_t)H48_EOESEP_COORDMAX, 2)
+#define H48_EOESEP_FULLSIZE   (INFOSIZE + H48_EOESEP_TABLESIZE)
+
+/*
+The extra tables that can be appended to the h48 data, one letter each:
+"c" for the full corner table and "e" for the edge table. A solver name
+such as h48h2k2ce lists them in the order in which they are evaluated.
+*/
+#define H48_EXTRATABLES       "ce"
+#define H48_MAXEXTRA          4
+
 #define H48_COEFF(k)        (INT64_C(8) / (int64_t)(k))
 #define H48_INDEX(i, k)     ((i) / H48_COEFF(k))
 #define H48_SHIFT(i, k)     ((uint8_t)(k) * (uint8_t)((i) % H48_COEFF(k)))
@@ -23,21 +39,35 @@
 #define CHUNKS COCSEP_CLASSES
 
 /*
-TODO: This loop over similar h48 coordinates can be improved by only
-transforming edges, but we need to compose transformations (i.e. conjugate
-_t by _ttrep).
+Hooks called at the start and at the end of each phase of the generation
+of the h48 tables, with the number of positions and of table bytes that the
+phase has processed. They do nothing, but a tool that includes nissy.c can
+define them to measure the phases (see tools/407_benchmark_gendata).
 */
-#define FOREACH_H48SIM(ARG_CUBE, ARG_COCSEPDATA, ARG_SELFSIM, ARG_ACTION) \
+#if !defined(GENDATA_PHASE_BEGIN)
+#define GENDATA_PHASE_BEGIN(name, depth)
+#endif
+#if !defined(GENDATA_PHASE_END)
+#define GENDATA_PHASE_END(positions, bytes)
+#endif
+
+/*
+Loop over the h48 coordinates (with the given h) of all the positions that
+are similar to ARG_CUBE via a self-symmetry of its corner class. All these
+positions have the same cocsep coordinate, and thus the same ttrep, so it
+is enough to transform the edges of ARG_CUBE by ttrep composed with each
+self-symmetry of the representative.
+*/
+#define FOREACH_H48SIM(ARG_CUBE, ARG_COCSEPDATA, ARG_SELFSIM, ARG_H, \
+    ARG_COORD, ARG_ACTION) \
 	int64_t VAR_COCSEP = coord_cocsep(ARG_CUBE); \
 	uint8_t VAR_TTREP = TTREP(ARG_COCSEPDATA[VAR_COCSEP]); \
-	uint8_t VAR_INVERSE_TTREP = inverse_trans(VAR_TTREP); \
 	int64_t VAR_COCLASS = COCLASS(ARG_COCSEPDATA[VAR_COCSEP]); \
-	cube_t VAR_REP = transform(ARG_CUBE, VAR_TTREP); \
 	uint64_t VAR_S = ARG_SELFSIM[VAR_COCLASS]; \
 	for (uint8_t VAR_T = 0; VAR_T < 48 && VAR_S; VAR_T++, VAR_S >>= 1) { \
 		if (!(VAR_S & 1)) continue; \
-		ARG_CUBE = transform(VAR_REP, VAR_T); \
-		ARG_CUBE = transform(ARG_CUBE, VAR_INVERSE_TTREP); \
+		ARG_COORD = coord_h48_edges(ARG_CUBE, VAR_COCLASS, \
+		    compose_trans(VAR_TTREP, VAR_T), ARG_H); \
 		ARG_ACTION \
 	}
 
@@ -57,6 +87,7 @@ typedef struct {
 	uint8_t k;
 	uint8_t base;
 	uint8_t maxdepth;
+	char extra[H48_MAXEXTRA+1];
 	tableinfo_t info;
 	uint64_t buf_size;
 	void *buf;
@@ -90,6 +121,7 @@ typedef struct {
 	uint8_t h;
 	uint8_t k;
 	uint8_t base;
+	uint8_t maxdepth;
 	uint8_t shortdepth;
 	uint32_t *cocsepdata;
 	uint8_t *table;
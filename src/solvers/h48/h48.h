@@ -3,6 +3,9 @@
 #include "gendata_types_macros.h"
 #include "gendata_cocsep.h"
 #include "gendata_h48.h"
+#include "gendata_corners.h"
+#include "gendata_eoesep.h"
 #include "stats.h"
+#include "solve_symmetry.h"
 #include "solve.h"
 #include "solve_multithread.h"
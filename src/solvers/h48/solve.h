@@ -1,3 +1,18 @@
+/*
+Indices of the counters of the positions pruned by each table, which are
+returned in the stats array of the solver starting from index 2. The extra
+tables are counted in the order in which they are evaluated.
+*/
+#define H48_PRUNES_CBOUND 0
+#define H48_PRUNES_H48    1
+#define H48_PRUNES_EXTRA  2
+#define H48_PRUNES_LEN    (H48_PRUNES_EXTRA + H48_MAXEXTRA)
+
+typedef struct {
+	char type;
+	const uint8_t *data;
+} h48_extratable_t;
+
 typedef struct {
 	cube_t cube;
 	cube_t inverse;
@@ -12,6 +27,9 @@ typedef struct {
 	const uint32_t *cocsepdata;
 	const uint8_t *h48data;
 	const uint8_t *h48data_fallback;
+	uint8_t nextra;
+	h48_extratable_t extra[H48_MAXEXTRA];
+	const h48_symmetry_t *symmetry;
 	uint64_t solutions_size;
 	char **nextsol;
 	uint8_t nissbranch;
@@ -19,44 +37,37 @@ typedef struct {
 	uint8_t premoves[MAXLEN];
 	long long nodes_visited;
 	long long table_fallbacks;
+	long long table_prunes[H48_PRUNES_LEN];
+	uint32_t cdata;
+	uint32_t cdata_inv;
 } dfsarg_solveh48_t;
 
-STATIC uint32_t allowednextmove_h48(uint8_t *, uint8_t, uint8_t);
-
 STATIC void solve_h48_appendsolution(dfsarg_solveh48_t *);
+STATIC_INLINE void solve_h48_cdata(dfsarg_solveh48_t *);
+STATIC_INLINE uint32_t solve_h48_children(const dfsarg_solveh48_t *,
+    uint32_t, const cube_t [static 18], const cube_t [static 18],
+    uint32_t [static 18], uint32_t [static 18]);
+STATIC_INLINE int64_t solve_h48_extracoord(
+    const h48_extratable_t *, cube_t, uint32_t);
+STATIC_INLINE uint8_t solve_h48_extravalue(
+    const h48_extratable_t *, int64_t);
+STATIC_INLINE uint8_t solve_h48_extrabound(
+    const h48_extratable_t *, cube_t, uint32_t);
+STATIC_INLINE bool solve_h48_stop_cbound(dfsarg_solveh48_t *);
+STATIC_INLINE bool solve_h48_stop_h48(dfsarg_solveh48_t *, int64_t, bool);
 STATIC_INLINE bool solve_h48_stop(dfsarg_solveh48_t *);
+STATIC_INLINE uint32_t solve_h48_symmetry_mask(
+    const dfsarg_solveh48_t *, bool);
+STATIC_INLINE bool solve_h48_symmetry_leaf(const dfsarg_solveh48_t *);
+STATIC bool solve_h48_symmetry_found(
+    const char *, const char *, uint8_t, const uint8_t *);
+STATIC void solve_h48_symmetry_expand(dfsarg_solveh48_t *, const char *);
+STATIC int64_t solve_h48_extradata(uint64_t, const void *,
+    dfsarg_solveh48_t *);
 STATIC int64_t solve_h48_dfs(dfsarg_solveh48_t *);
 STATIC int64_t solve_h48(cube_t, int8_t, int8_t, int8_t, uint64_t,
     const void *, uint64_t, char *, long long [static NISSY_SIZE_SOLVE_STATS]);
 
-STATIC uint32_t
-allowednextmove_h48(uint8_t *moves, uint8_t n, uint8_t h48branch)
-{
-	uint32_t result = MM_ALLMOVES;
-	if (h48branch & MM_NORMALBRANCH)
-		result &= MM_NOHALFTURNS;
-	if (n < 1)
-		return result;
-
-	uint8_t base1 = movebase(moves[n-1]);
-	uint8_t axis1 = moveaxis(moves[n-1]);
-
-	result = disable_moves(result, base1 * 3);
-	if (base1 % 2)
-		result = disable_moves(result, (base1 - 1) * 3);
-
-	if (n == 1)
-		return result;
-
-	uint8_t base2 = movebase(moves[n-2]);
-	uint8_t axis2 = moveaxis(moves[n-2]);
-
-	if(axis1 == axis2)
-		result = disable_moves(result, base2 * 3);
-
-	return result;
-}
-
 STATIC void
 solve_h48_appendsolution(dfsarg_solveh48_t *arg)
 {
@@ -69,8 +80,11 @@ solve_h48_appendsolution(dfsarg_solveh48_t *arg)
 
 	if (strl < 0)
 		goto solve_h48_appendsolution_error;
-	*arg->nextsol += strl-1; 
-	arg->solutions_size -= strl-1;
+
+	/* Except for the empty solution, strl counts one extra character */
+	strl = strl > 0 ? strl-1 : 0;
+	*arg->nextsol += strl;
+	arg->solutions_size -= strl;
 
 	if (arg->npremoves) {
 		**arg->nextsol = ' ';
@@ -98,31 +112,129 @@ solve_h48_appendsolution_error:
 	return;
 }
 
+/*
+The cocsep data of a position and of its inverse is stored in the
+dfsarg_solveh48_t, so that it can be looked up for all the children of a
+node at once by solve_h48_children(). This function computes it for a
+single position, and it is used for the positions that are not reached
+with solve_h48_children(), for example the root.
+*/
+STATIC_INLINE void
+solve_h48_cdata(dfsarg_solveh48_t *arg)
+{
+	get_h48_cdata(arg->cube, arg->cocsepdata, &arg->cdata);
+	get_h48_cdata(arg->inverse, arg->cocsepdata, &arg->cdata_inv);
+}
+
+/*
+Compute the cocsep data of the children of a node given in cubes and
+inverses, for the moves in allowed. The data of the inverse is computed
+only for the children that are not already pruned by the corner bound of
+the normal cube.
+
+The mask of the children that are not pruned by the corner bounds is
+returned. This must be kept consistent with solve_h48_stop().
+*/
+STATIC_INLINE uint32_t
+solve_h48_children(
+	const dfsarg_solveh48_t *arg,
+	uint32_t allowed,
+	const cube_t cubes[static 18],
+	const cube_t inverses[static 18],
+	uint32_t cdata[static 18],
+	uint32_t cdata_inv[static 18]
+)
+{
+	uint8_t m;
+	uint32_t ok, ok_inv;
+	int8_t n;
+
+	n = arg->nmoves + arg->npremoves + 1;
+
+	coord_h48_cdata_many(cubes, allowed, arg->cocsepdata, cdata);
+	for (m = 0, ok = 0; m < 18; m++)
+		if ((allowed & (1 << m)) &&
+		    (int8_t)CBOUND(cdata[m]) + n <= arg->depth)
+			ok |= 1 << m;
+
+	coord_h48_cdata_many(inverses, ok, arg->cocsepdata, cdata_inv);
+	for (m = 0, ok_inv = 0; m < 18; m++)
+		if ((ok & (1 << m)) &&
+		    (int8_t)CBOUND(cdata_inv[m]) + n <= arg->depth)
+			ok_inv |= 1 << m;
+
+	return ok_inv;
+}
+
+/*
+The coordinate of an extra table for the given cube and its cocsep data,
+or -1 if the type of the table is not known.
+*/
+STATIC_INLINE int64_t
+solve_h48_extracoord(const h48_extratable_t *t, cube_t cube, uint32_t cdata)
+{
+	switch (t->type) {
+	case 'c':
+		return coord_h48corners(cube, COCLASS(cdata), TTREP(cdata));
+	case 'e':
+		return coord_h48eoesep(cube);
+	default:
+		return -1;
+	}
+}
+
+/* The value of an extra table for the given coordinate */
+STATIC_INLINE uint8_t
+solve_h48_extravalue(const h48_extratable_t *t, int64_t coord)
+{
+	return coord < 0 ? 0 : get_h48_pval(t->data, coord, 4);
+}
+
+/* The value of an extra table for the given cube and its cocsep data */
+STATIC_INLINE uint8_t
+solve_h48_extrabound(const h48_extratable_t *t, cube_t cube, uint32_t cdata)
+{
+	return solve_h48_extravalue(t, solve_h48_extracoord(t, cube, cdata));
+}
+
+/* Count the node and check the corner bounds stored in its cocsep data */
 STATIC_INLINE bool
-solve_h48_stop(dfsarg_solveh48_t *arg)
+solve_h48_stop_cbound(dfsarg_solveh48_t *arg)
 {
-	uint32_t data, data_inv;
-	int8_t cbound, cbound_inv, h48bound, h48bound_inv;
-	int64_t coord, coord_inv;
+	int8_t n, cbound, cbound_inv;
 
 	arg->nodes_visited++;
 
 	arg->nissbranch = MM_NORMAL;
-	cbound = get_h48_cdata(arg->cube, arg->cocsepdata, &data);
-	if (cbound + arg->nmoves + arg->npremoves > arg->depth)
+	n = arg->nmoves + arg->npremoves;
+	cbound = CBOUND(arg->cdata);
+	cbound_inv = CBOUND(arg->cdata_inv);
+	if (cbound + n > arg->depth || cbound_inv + n > arg->depth) {
+		arg->table_prunes[H48_PRUNES_CBOUND]++;
 		return true;
+	}
 
-	cbound_inv = get_h48_cdata(arg->inverse, arg->cocsepdata, &data_inv);
-	if (cbound_inv + arg->nmoves + arg->npremoves > arg->depth)
-		return true;
+	return false;
+}
+
+/*
+Check the h48 bound of the cube, or of its inverse if inverse is true,
+given its h48 coordinate. If the bound is tight, only the moves on the
+other side are allowed after this position.
+*/
+STATIC_INLINE bool
+solve_h48_stop_h48(dfsarg_solveh48_t *arg, int64_t coord, bool inverse)
+{
+	int8_t n, h48bound;
 
-	coord = coord_h48_edges(arg->cube, COCLASS(data), TTREP(data), arg->h);
+	n = arg->nmoves + arg->npremoves;
 	h48bound = get_h48_pval(arg->h48data, coord, arg->k);
 
-	/* If the h48 bound is > 0, we add the base value.    */
-	/* Otherwise, we use the fallback h0k4 value instead. */
+	/* With k = 1 or 2, if the h48 bound is > 0 we add the */
+	/* base value. Otherwise, we use the fallback h0k4     */
+	/* value instead. With k = 4 the value is used as is.  */
 
-	if (arg->k == 2) {
+	if (arg->k != 4) {
 		if (h48bound == 0) {
 			arg->table_fallbacks++;
 			h48bound = get_h48_pval(
@@ -131,37 +243,251 @@ solve_h48_stop(dfsarg_solveh48_t *arg)
 			h48bound += arg->base;
 		}
 	}
-	if (h48bound + arg->nmoves + arg->npremoves > arg->depth)
+	if (h48bound + n > arg->depth) {
+		arg->table_prunes[H48_PRUNES_H48]++;
 		return true;
-	if (h48bound + arg->nmoves + arg->npremoves == arg->depth)
-		arg->nissbranch = MM_INVERSEBRANCH;
-
-	coord_inv = coord_h48_edges(
-	    arg->inverse, COCLASS(data_inv), TTREP(data_inv), arg->h);
-	h48bound_inv = get_h48_pval(arg->h48data, coord_inv, arg->k);
-	if (arg->k == 2) {
-		if (h48bound_inv == 0) {
-			arg->table_fallbacks++;
-			h48bound_inv = get_h48_pval(
-			    arg->h48data_fallback, coord_inv >> arg->h, 4);
-		} else {
-			h48bound_inv += arg->base;
+	}
+	if (h48bound + n == arg->depth)
+		arg->nissbranch = inverse ? MM_NORMALBRANCH : MM_INVERSEBRANCH;
+
+	return false;
+}
+
+/*
+The bounds are checked from the cheapest to the most expensive: first the
+corner bound in the cocsep data, then the extra tables in the order in which
+they appear in the data, and finally the h48 table. The search is pruned as
+soon as one of them is too large, which is the same as taking the maximum
+of all of them.
+*/
+STATIC_INLINE bool
+solve_h48_stop(dfsarg_solveh48_t *arg)
+{
+	uint8_t i;
+	int8_t n;
+	int64_t coord;
+
+	if (solve_h48_stop_cbound(arg))
+		return true;
+
+	n = arg->nmoves + arg->npremoves;
+	for (i = 0; i < arg->nextra; i++) {
+		if (solve_h48_extrabound(&arg->extra[i], arg->cube,
+		    arg->cdata) + n > arg->depth ||
+		    solve_h48_extrabound(&arg->extra[i], arg->inverse,
+		    arg->cdata_inv) + n > arg->depth) {
+			arg->table_prunes[H48_PRUNES_EXTRA + i]++;
+			return true;
 		}
 	}
-	if (h48bound_inv + arg->nmoves + arg->npremoves > arg->depth)
+
+	coord = coord_h48_edges(
+	    arg->cube, COCLASS(arg->cdata), TTREP(arg->cdata), arg->h);
+	if (solve_h48_stop_h48(arg, coord, false))
+		return true;
+
+	coord = coord_h48_edges(arg->inverse,
+	    COCLASS(arg->cdata_inv), TTREP(arg->cdata_inv), arg->h);
+
+	return solve_h48_stop_h48(arg, coord, true);
+}
+
+/*
+The moves that can be applied to the position of arg on the normal side,
+or on the inverse side if inverse is true, without leaving the solutions
+whose blocks are the smallest in their orbit, see solve_symmetry.h. The
+block of a side is checked when the side changes axis for the first time.
+*/
+STATIC_INLINE uint32_t
+solve_h48_symmetry_mask(const dfsarg_solveh48_t *arg, bool inverse)
+{
+	bool closed;
+	uint8_t n;
+	uint32_t block, other;
+	const uint8_t *moves;
+
+	n = inverse ? arg->npremoves : arg->nmoves;
+	moves = inverse ? arg->premoves : arg->moves;
+	if (arg->symmetry == NULL || n == 0 || n > 2 ||
+	    moveaxis(moves[n-1]) != moveaxis(moves[0]))
+		return MM_ALLMOVES;
+
+	block = solve_h48_symmetry_block(n, moves, inverse, &closed);
+	if (inverse)
+		other = solve_h48_symmetry_block(
+		    arg->nmoves, arg->moves, false, &closed);
+	else
+		other = solve_h48_symmetry_block(
+		    arg->npremoves, arg->premoves, true, &closed);
+	other = closed ? other : 0;
+
+	if (solve_h48_symmetry_check(arg->symmetry,
+	    inverse ? other : block, inverse ? block : other))
+		return MM_ALLMOVES;
+
+	/* Only the moves that do not close the block are left */
+	return UINT32_C(077) << (6 * moveaxis(moves[0]));
+}
+
+/* Check the blocks of a solution */
+STATIC_INLINE bool
+solve_h48_symmetry_leaf(const dfsarg_solveh48_t *arg)
+{
+	bool closed;
+	uint8_t i, n, moves[MAXLEN], reversed[MAXLEN];
+
+	n = arg->nmoves + arg->npremoves;
+	if (arg->symmetry == NULL || n == 0)
 		return true;
-	if (h48bound_inv + arg->nmoves + arg->npremoves == arg->depth)
-		arg->nissbranch = MM_NORMALBRANCH;
+
+	for (i = 0; i < arg->nmoves; i++)
+		moves[i] = arg->moves[i];
+	for (i = 0; i < arg->npremoves; i++)
+		moves[n-1-i] = inverse_move(arg->premoves[i]);
+	for (i = 0; i < n; i++)
+		reversed[i] = moves[n-1-i];
+
+	return solve_h48_symmetry_check(arg->symmetry,
+	    solve_h48_symmetry_block(n, moves, false, &closed),
+	    solve_h48_symmetry_block(n, reversed, false, &closed));
+}
+
+/*
+Check if the solution is already written between from and end, up to the
+order of the commuting moves.
+*/
+STATIC bool
+solve_h48_symmetry_found(
+	const char *from,
+	const char *end,
+	uint8_t n,
+	const uint8_t *moves
+)
+{
+	int k;
+	uint8_t other[MAXLEN];
+	char line[4 * MAXLEN];
+	const char *next;
+
+	for ( ; from < end; from = next+1) {
+		next = memchr(from, '\n', end - from);
+		if (next == NULL || next - from >= (ptrdiff_t)sizeof(line))
+			break;
+		memcpy(line, from, next - from);
+		line[next - from] = '\0';
+		if ((k = readmoves(line, MAXLEN, other)) != n)
+			continue;
+		solve_h48_symmetry_canonical(n, other);
+		if (!memcmp(moves, other, n))
+			return true;
+	}
 
 	return false;
 }
 
+/*
+Append the solutions obtained by transforming the solutions written from
+the position from, skipping the ones that are already written.
+*/
+STATIC void
+solve_h48_symmetry_expand(dfsarg_solveh48_t *arg, const char *from)
+{
+	bool anti;
+	int n, i;
+	uint8_t t, moves[MAXLEN];
+	char line[4 * MAXLEN];
+	const char *end, *sol, *next;
+	const h48_symmetry_t *sym;
+	dfsarg_solveh48_t image;
+
+	if ((sym = arg->symmetry) == NULL)
+		return;
+
+	image = *arg;
+	image.npremoves = 0;
+	end = *arg->nextsol;
+	for (sol = from; sol < end && *arg->nsols < arg->maxsolutions;
+	    sol = next+1) {
+		next = memchr(sol, '\n', end - sol);
+		if (next == NULL || next - sol >= (ptrdiff_t)sizeof(line))
+			break;
+		memcpy(line, sol, next - sol);
+		line[next - sol] = '\0';
+		if ((n = readmoves(line, MAXLEN, moves)) <= 0)
+			continue;
+
+		for (t = 0; t < 96 && *arg->nsols < arg->maxsolutions; t++) {
+			anti = t >= 48;
+			if (!solve_h48_symmetry_has(sym, t % 48, anti))
+				continue;
+			for (i = 0; i < n; i++)
+				image.moves[i] = anti ? inverse_move(
+				    transform_move(moves[n-1-i], t % 48)) :
+				    transform_move(moves[i], t % 48);
+			image.nmoves = n;
+			solve_h48_symmetry_canonical(n, image.moves);
+			if (!solve_h48_symmetry_found(
+			    from, *arg->nextsol, n, image.moves))
+				solve_h48_appendsolution(&image);
+		}
+	}
+
+	arg->solutions_size = image.solutions_size;
+}
+
+/*
+Find the extra tables, which come after the h48 table and its fallback,
+and store them in arg. Returns the number of extra tables, or a negative
+value if the data is invalid.
+*/
+STATIC int64_t
+solve_h48_extradata(
+	uint64_t data_size,
+	const void *data,
+	dfsarg_solveh48_t *arg
+)
+{
+	char t;
+	const char *buf;
+	tableinfo_t info;
+
+	arg->nextra = 0;
+	for (buf = data; ; buf += info.next) {
+		if (readtableinfo(data_size, buf, &info) != NISSY_OK)
+			return NISSY_ERROR_DATA;
+		data_size -= info.next;
+
+		if (!strncmp(info.solver, "corners", 7))
+			t = 'c';
+		else if (!strncmp(info.solver, "eoesep", 6))
+			t = 'e';
+		else
+			t = '\0';
+
+		if (t != '\0') {
+			if (arg->nextra == H48_MAXEXTRA)
+				return NISSY_ERROR_DATA;
+			arg->extra[arg->nextra++] = (h48_extratable_t) {
+				.type = t,
+				.data = (const uint8_t *)buf + INFOSIZE,
+			};
+		}
+
+		if (info.next == 0)
+			break;
+	}
+
+	return arg->nextra;
+}
+
 STATIC int64_t
 solve_h48_dfs(dfsarg_solveh48_t *arg)
 {
 	dfsarg_solveh48_t nextarg;
 	int64_t ret;
 	uint8_t m;
+	uint32_t allowed, ok, cdata[18], cdata_inv[18];
+	cube_t cubes[18], inverses[18];
 
 	if (*arg->nsols == arg->maxsolutions)
 		return 0;
@@ -170,7 +496,8 @@ solve_h48_dfs(dfsarg_solveh48_t *arg)
 		return 0;
 
 	if (issolved(arg->cube)) {
-		if (arg->nmoves + arg->npremoves != arg->depth)
+		if (arg->nmoves + arg->npremoves != arg->depth ||
+		    !solve_h48_symmetry_leaf(arg))
 			return 0;
 		solve_h48_appendsolution(arg);
 		return 1;
@@ -178,33 +505,58 @@ solve_h48_dfs(dfsarg_solveh48_t *arg)
 
 	nextarg = *arg;
 	ret = 0;
-	uint32_t allowed;
 	if(arg->nissbranch & MM_INVERSE) {
-		allowed = allowednextmove_h48(arg->premoves, arg->npremoves, arg->nissbranch);
+		allowed = allowednextmove_h48(arg->premoves,
+		    arg->npremoves, arg->nissbranch) &
+		    solve_h48_symmetry_mask(arg, true);
+		expand_moves(arg->inverse, allowed, inverses);
+		expand_premoves(arg->cube, allowed, cubes);
+		ok = solve_h48_children(arg, allowed, cubes, inverses,
+		    cdata, cdata_inv);
 		for (m = 0; m < 18; m++) {
-			if(allowed & (1 << m)) {
+			if (ok & (1 << m)) {
 				nextarg.npremoves = arg->npremoves + 1;
 				nextarg.premoves[arg->npremoves] = m;
-				nextarg.inverse = move(arg->inverse, m);
-				nextarg.cube = premove(arg->cube, m);
+				nextarg.inverse = inverses[m];
+				nextarg.cube = cubes[m];
+				nextarg.cdata = cdata[m];
+				nextarg.cdata_inv = cdata_inv[m];
 				ret += solve_h48_dfs(&nextarg);
+			} else if (allowed & (1 << m)) {
+				/* Pruned by solve_h48_children() */
+				nextarg.nodes_visited++;
+				nextarg.table_prunes[H48_PRUNES_CBOUND]++;
 			}
 		}
 	} else {
-		allowed = allowednextmove_h48(arg->moves, arg->nmoves, arg->nissbranch);
+		allowed = allowednextmove_h48(arg->moves,
+		    arg->nmoves, arg->nissbranch) &
+		    solve_h48_symmetry_mask(arg, false);
+		expand_moves(arg->cube, allowed, cubes);
+		expand_premoves(arg->inverse, allowed, inverses);
+		ok = solve_h48_children(arg, allowed, cubes, inverses,
+		    cdata, cdata_inv);
 		for (m = 0; m < 18; m++) {
-			if (allowed & (1 << m)) {
+			if (ok & (1 << m)) {
 				nextarg.nmoves = arg->nmoves + 1;
 				nextarg.moves[arg->nmoves] = m;
-				nextarg.cube = move(arg->cube, m);
-				nextarg.inverse = premove(arg->inverse, m);
+				nextarg.cube = cubes[m];
+				nextarg.inverse = inverses[m];
+				nextarg.cdata = cdata[m];
+				nextarg.cdata_inv = cdata_inv[m];
 				ret += solve_h48_dfs(&nextarg);
+			} else if (allowed & (1 << m)) {
+				/* Pruned by solve_h48_children() */
+				nextarg.nodes_visited++;
+				nextarg.table_prunes[H48_PRUNES_CBOUND]++;
 			}
 		}
 	}
 
 	arg->nodes_visited = nextarg.nodes_visited;
 	arg->table_fallbacks = nextarg.table_fallbacks;
+	memcpy(arg->table_prunes, nextarg.table_prunes,
+	    sizeof(arg->table_prunes));
 	return ret;
 }
 
@@ -221,8 +573,11 @@ solve_h48(
 	long long stats[static NISSY_SIZE_SOLVE_STATS]
 )
 {
+	int i;
 	_Atomic int64_t nsols;
+	char *buf, *from;
 	dfsarg_solveh48_t arg;
+	h48_symmetry_t symmetry;
 	tableinfo_t info, fbinfo;
 
 	if(readtableinfo_n(data_size, data, 2, &info) != NISSY_OK)
@@ -238,13 +593,16 @@ solve_h48(
 		.base = info.base,
 		.cocsepdata = (uint32_t *)((char *)data + INFOSIZE),
 		.h48data = (uint8_t *)data + COCSEP_FULLSIZE + INFOSIZE,
+		.symmetry = solve_h48_symmetry(cube, &symmetry) ?
+		    &symmetry : NULL,
 		.solutions_size = solutions_size,
 		.nextsol = &solutions,
 		.nodes_visited = 0,
-		.table_fallbacks = 0
+		.table_fallbacks = 0,
+		.table_prunes = {0}
 	};
 
-	if (info.bits == 2) {
+	if (info.bits != 4) {
 		if (readtableinfo_n(data_size, data, 3, &fbinfo) != NISSY_OK)
 			goto solve_h48_error_data;
 		/* We only support h0k4 as fallback table */
@@ -254,8 +612,12 @@ solve_h48(
 	} else {
 		arg.h48data_fallback = NULL;
 	}
+	if (solve_h48_extradata(data_size, data, &arg) < 0)
+		goto solve_h48_error_data;
+	solve_h48_cdata(&arg);
 
 	nsols = 0;
+	buf = solutions;
 	for (arg.depth = minmoves;
 	     arg.depth <= maxmoves && nsols < maxsolutions;
 	     arg.depth++)
@@ -264,12 +626,17 @@ solve_h48(
 		    PRId8 "\n", nsols, arg.depth);
 		arg.nmoves = 0;
 		arg.npremoves = 0;
+		from = *arg.nextsol;
 		solve_h48_dfs(&arg);
+		arg.solutions_size = solutions_size - (*arg.nextsol - buf);
+		solve_h48_symmetry_expand(&arg, from);
 	}
 	**arg.nextsol = '\0';
 
 	stats[0] = arg.nodes_visited;
 	stats[1] = arg.table_fallbacks;
+	for (i = 0; i < H48_PRUNES_LEN; i++)
+		stats[2+i] = arg.table_prunes[i];
 	LOG("Nodes visited: %lld\nTable fallbacks: %lld\n",
 	    arg.nodes_visited, arg.table_fallbacks);
 
@@ -13,15 +13,65 @@ typedef struct {
 	atomic_bool terminate;
 	_Atomic long long nodes_visited_global;
 	_Atomic long long table_fallbacks_global;
+	_Atomic long long table_prunes_global[H48_PRUNES_LEN];
 } task_queue_t;
 
+/*
+The argument of each solver thread. If node is not negative, the thread is
+pinned to it and uses the copy replica of the data, see numa_prepare().
+*/
+typedef struct {
+	task_queue_t *queue;
+	int node;
+	unsigned interleave;
+	const void *data;
+	const void *replica;
+} solve_thread_arg_t;
+
+/*
+A search of a subtree run by solve_h48_interleave(). The recursion of
+solve_h48_single() is replaced by a stack of frames, each one with the
+children of a position that are left to visit, so that the search can be
+paused at any position. The coordinates of the position whose table
+entries are being loaded are kept until the search is resumed.
+*/
+typedef struct {
+	cube_t cubes[18];
+	cube_t inverses[18];
+	uint32_t cdata[18];
+	uint32_t cdata_inv[18];
+	uint32_t ok;
+	uint8_t next;
+	bool inverse;
+	int8_t nmoves;
+	int8_t npremoves;
+} h48_frame_t;
+
+typedef struct {
+	h48_frame_t frame[MAXLEN];
+	dfsarg_solveh48_t arg;
+	int8_t top;
+	bool running;
+	int64_t coord;
+	int64_t coord_inv;
+	int64_t extra[H48_MAXEXTRA];
+	int64_t extra_inv[H48_MAXEXTRA];
+} h48_search_t;
+
 STATIC void solve_h48_appendsolution_thread(dfsarg_solveh48_t *, task_queue_t *);
 STATIC void init_queue(task_queue_t *);
 STATIC void submit_task(task_queue_t *, dfsarg_solveh48_t);
 STATIC void copy_queue(task_queue_t *, task_queue_t *, int, _Atomic int64_t *);
+STATIC bool take_task(solve_thread_arg_t *, bool, dfsarg_solveh48_t *);
+STATIC void finish_task(task_queue_t *, const dfsarg_solveh48_t *);
 STATIC void *start_thread(void *);
+STATIC void solve_h48_rebase(dfsarg_solveh48_t *, const void *, const void *);
 STATIC int64_t solve_h48_bfs(dfsarg_solveh48_t *, task_queue_t *, int8_t);
 STATIC int64_t solve_h48_single(dfsarg_solveh48_t *, task_queue_t *);
+STATIC_INLINE bool solve_h48_interleave_enter(h48_search_t *);
+STATIC void solve_h48_interleave_visit(h48_search_t *, task_queue_t *);
+STATIC bool solve_h48_interleave_step(h48_search_t *, task_queue_t *);
+STATIC void solve_h48_interleave(solve_thread_arg_t *, h48_search_t *);
 STATIC int64_t solve_h48_multithread(cube_t, int8_t, int8_t, int8_t, uint64_t,
     const void *, uint64_t, char *, long long [static NISSY_SIZE_SOLVE_STATS]);
 
@@ -38,8 +88,11 @@ solve_h48_appendsolution_thread(dfsarg_solveh48_t *arg, task_queue_t *tq)
 
 	if (strl < 0)
 		goto solve_h48_appendsolution_thread_error;
-	*arg->nextsol += strl-1;
-	arg->solutions_size -= strl-1;
+
+	/* Except for the empty solution, strl counts one extra character */
+	strl = strl > 0 ? strl-1 : 0;
+	*arg->nextsol += strl;
+	arg->solutions_size -= strl;
 
 	if (arg->npremoves)
 	{
@@ -108,42 +161,98 @@ copy_queue(task_queue_t *src, task_queue_t *dest, int depth, _Atomic int64_t *ns
 	pthread_mutex_unlock(&dest->mutex);
 }
 
+/*
+Take a task from the queue, waiting for one if wait is true. Returns false
+if there is no task, which when waiting means that the queue is terminated.
+*/
+STATIC bool
+take_task(solve_thread_arg_t *targ, bool wait, dfsarg_solveh48_t *task)
+{
+	bool ret;
+	task_queue_t *queue = targ->queue;
+
+	pthread_mutex_lock(&queue->mutex);
+	while (wait && queue->tasks_count == 0 && !queue->terminate)
+		pthread_cond_wait(&queue->cond, &queue->mutex);
+
+	ret = queue->tasks_count > 0;
+	if (ret) {
+		*task = queue->tasks[queue->front];
+		queue->front = (queue->front + 1) % MAX_QUEUE_SIZE;
+		queue->tasks_count--;
+		queue->active++;
+	}
+	pthread_mutex_unlock(&queue->mutex);
+
+	if (ret && targ->node >= 0)
+		solve_h48_rebase(task, targ->data, targ->replica);
+
+	return ret;
+}
+
+/* Collect the statistics of a task taken with take_task() */
+STATIC void
+finish_task(task_queue_t *queue, const dfsarg_solveh48_t *task)
+{
+	queue->nodes_visited_global += task->nodes_visited;
+	queue->table_fallbacks_global += task->table_fallbacks;
+	for (int i = 0; i < H48_PRUNES_LEN; i++)
+		queue->table_prunes_global[i] += task->table_prunes[i];
+
+	pthread_mutex_lock(&queue->mutex);
+	queue->active--;
+	if (queue->tasks_count == 0 && queue->active == 0)
+		pthread_cond_signal(&queue->active_cond);
+	pthread_mutex_unlock(&queue->mutex);
+}
+
 STATIC void *
 start_thread(void *arg)
 {
-	task_queue_t *queue = (task_queue_t *)arg;
-	while (1) {
-		pthread_mutex_lock(&queue->mutex);
-		while (queue->tasks_count == 0 && !queue->terminate) {
-			pthread_cond_wait(&queue->cond, &queue->mutex);
-		}
-		if (queue->tasks_count == 0 && queue->terminate) {
-			pthread_mutex_unlock(&queue->mutex);
-			break;
+	dfsarg_solveh48_t task;
+	h48_search_t *search;
+	solve_thread_arg_t *targ = (solve_thread_arg_t *)arg;
+
+	if (targ->node >= 0 && !numa_pin(targ->node))
+		LOG("Could not pin thread to node %d\n", targ->node);
+
+	if (targ->interleave > 1) {
+		search = aligned_alloc(_Alignof(h48_search_t),
+		    targ->interleave * sizeof(h48_search_t));
+		if (search != NULL) {
+			solve_h48_interleave(targ, search);
+			free(search);
+			return NULL;
 		}
+		LOG("Could not allocate the searches, not interleaving\n");
+	}
 
-		if (queue->tasks_count > 0) {
-			dfsarg_solveh48_t task = queue->tasks[queue->front];
-			queue->front = (queue->front + 1) % MAX_QUEUE_SIZE;
-			queue->tasks_count--;
-			queue->active++;
-			pthread_mutex_unlock(&queue->mutex);
-			
-			solve_h48_single(&task, queue);
-			queue->nodes_visited_global += task.nodes_visited;
-			queue->table_fallbacks_global += task.table_fallbacks;
-
-			pthread_mutex_lock(&queue->mutex);
-			queue->active--;
-
-			if(queue->tasks_count == 0 && queue->active == 0)
-				pthread_cond_signal(&queue->active_cond);
-		}
-		pthread_mutex_unlock(&queue->mutex);
+	while (take_task(targ, true, &task)) {
+		solve_h48_single(&task, targ->queue);
+		finish_task(targ->queue, &task);
 	}
+
 	return NULL;
 }
 
+/* Make the table pointers of arg point to the same tables in copy */
+STATIC void
+solve_h48_rebase(dfsarg_solveh48_t *arg, const void *data, const void *copy)
+{
+	uint8_t i;
+	const uint8_t *from, *to;
+
+	from = (const uint8_t *)data;
+	to = (const uint8_t *)copy;
+	arg->cocsepdata = (const uint32_t *)
+	    (to + ((const uint8_t *)arg->cocsepdata - from));
+	arg->h48data = to + (arg->h48data - from);
+	if (arg->h48data_fallback != NULL)
+		arg->h48data_fallback = to + (arg->h48data_fallback - from);
+	for (i = 0; i < arg->nextra; i++)
+		arg->extra[i].data = to + (arg->extra[i].data - from);
+}
+
 STATIC int64_t
 solve_h48_bfs(dfsarg_solveh48_t *arg_zero, task_queue_t *tq, int8_t maxmoves)
 {
@@ -153,6 +262,7 @@ solve_h48_bfs(dfsarg_solveh48_t *arg_zero, task_queue_t *tq, int8_t maxmoves)
 	int depth = 0;
 	int nodes_at_current_depth = 1;
 	int nodes_at_next_depth = 0;
+	cube_t cubes[18], inverses[18];
 	queue[rear++] = *arg_zero;
 
 	dfsarg_solveh48_t task_pool[MAX_QUEUE_SIZE];
@@ -165,21 +275,26 @@ solve_h48_bfs(dfsarg_solveh48_t *arg_zero, task_queue_t *tq, int8_t maxmoves)
 			return 1;
 
 		if (issolved(arg.cube)){
-			if (arg.nmoves + arg.npremoves >= arg.depth && arg.nmoves + arg.npremoves <= maxmoves)
+			if (arg.nmoves + arg.npremoves >= arg.depth && arg.nmoves + arg.npremoves <= maxmoves &&
+			    solve_h48_symmetry_leaf(&arg))
 			solve_h48_appendsolution(&arg);
 			continue;
 		}
 
 		arg.nissbranch = MM_NORMAL;
-		uint32_t allowed = allowednextmove_h48(arg.moves, arg.nmoves, arg.nissbranch);
+		uint32_t allowed = allowednextmove_h48(arg.moves, arg.nmoves, arg.nissbranch) &
+		    solve_h48_symmetry_mask(&arg, false);
+		expand_moves(arg.cube, allowed, cubes);
+		expand_premoves(arg.inverse, allowed, inverses);
 
 		for (uint8_t m = 0; m < 18; m++){
 			if (allowed & (1 << m)){
 				nextarg = arg;
 				nextarg.nmoves = arg.nmoves + 1;
 				nextarg.moves[arg.nmoves] = m;
-				nextarg.cube = move(arg.cube, m);
-				nextarg.inverse = premove(arg.inverse, m);
+				nextarg.cube = cubes[m];
+				nextarg.inverse = inverses[m];
+				solve_h48_cdata(&nextarg);
 
 				if (nextarg.nmoves == BFS_DEPTH){
 					dfsarg_solveh48_t *task = &task_pool[rear % MAX_QUEUE_SIZE];
@@ -194,7 +309,9 @@ solve_h48_bfs(dfsarg_solveh48_t *arg_zero, task_queue_t *tq, int8_t maxmoves)
 		if (nodes_at_current_depth == 0){
 			nodes_at_current_depth = nodes_at_next_depth;
 			nodes_at_next_depth = 0;
-			LOG("Found %" PRId64 " solutions, searching at depth %" PRId8 "\n", *nextarg.nsols, depth++);
+			LOG("Found %" PRId64 " solutions, searching at depth %"
+			    PRId8 "\n", *nextarg.nsols, depth);
+			depth++;
 		}
 		if (depth == BFS_DEPTH) return 0;
 	}
@@ -207,6 +324,8 @@ solve_h48_single(dfsarg_solveh48_t *arg, task_queue_t *tq)
 	dfsarg_solveh48_t nextarg;
 	int64_t ret;
 	uint8_t m;
+	uint32_t allowed, ok, cdata[18], cdata_inv[18];
+	cube_t cubes[18], inverses[18];
 
 	if (*arg->nsols == arg->maxsolutions)
 		return 0;
@@ -215,7 +334,8 @@ solve_h48_single(dfsarg_solveh48_t *arg, task_queue_t *tq)
 		return 0;
 
 	if (issolved(arg->cube)){
-		if (arg->nmoves + arg->npremoves != arg->depth)
+		if (arg->nmoves + arg->npremoves != arg->depth ||
+		    !solve_h48_symmetry_leaf(arg))
 			return 0;
 		solve_h48_appendsolution_thread(arg, tq);
 		return 1;
@@ -223,36 +343,255 @@ solve_h48_single(dfsarg_solveh48_t *arg, task_queue_t *tq)
 
 	nextarg = *arg;
 	ret = 0;
-	uint32_t allowed;
 	if (arg->nissbranch & MM_INVERSE){
-		allowed = allowednextmove_h48(arg->premoves, arg->npremoves, arg->nissbranch);
+		allowed = allowednextmove_h48(arg->premoves,
+		    arg->npremoves, arg->nissbranch) &
+		    solve_h48_symmetry_mask(arg, true);
+		expand_moves(arg->inverse, allowed, inverses);
+		expand_premoves(arg->cube, allowed, cubes);
+		ok = solve_h48_children(arg, allowed, cubes, inverses,
+		    cdata, cdata_inv);
 		for (m = 0; m < 18; m++){
-			if (allowed & (1 << m)){
+			if (ok & (1 << m)) {
 				nextarg.npremoves = arg->npremoves + 1;
 				nextarg.premoves[arg->npremoves] = m;
-				nextarg.inverse = move(arg->inverse, m);
-				nextarg.cube = premove(arg->cube, m);
+				nextarg.inverse = inverses[m];
+				nextarg.cube = cubes[m];
+				nextarg.cdata = cdata[m];
+				nextarg.cdata_inv = cdata_inv[m];
 				ret += solve_h48_single(&nextarg, tq);
+			} else if (allowed & (1 << m)) {
+				/* Pruned by solve_h48_children() */
+				nextarg.nodes_visited++;
+				nextarg.table_prunes[H48_PRUNES_CBOUND]++;
 			}
 		}
 	} else {
-		allowed = allowednextmove_h48(arg->moves, arg->nmoves, arg->nissbranch);
+		allowed = allowednextmove_h48(arg->moves,
+		    arg->nmoves, arg->nissbranch) &
+		    solve_h48_symmetry_mask(arg, false);
+		expand_moves(arg->cube, allowed, cubes);
+		expand_premoves(arg->inverse, allowed, inverses);
+		ok = solve_h48_children(arg, allowed, cubes, inverses,
+		    cdata, cdata_inv);
 		for (m = 0; m < 18; m++){
-			if (allowed & (1 << m)){
+			if (ok & (1 << m)) {
 				nextarg.nmoves = arg->nmoves + 1;
 				nextarg.moves[arg->nmoves] = m;
-				nextarg.cube = move(arg->cube, m);
-				nextarg.inverse = premove(arg->inverse, m);
+				nextarg.cube = cubes[m];
+				nextarg.inverse = inverses[m];
+				nextarg.cdata = cdata[m];
+				nextarg.cdata_inv = cdata_inv[m];
 				ret += solve_h48_single(&nextarg, tq);
+			} else if (allowed & (1 << m)) {
+				/* Pruned by solve_h48_children() */
+				nextarg.nodes_visited++;
+				nextarg.table_prunes[H48_PRUNES_CBOUND]++;
 			}
 		}
 	}
 
 	arg->nodes_visited = nextarg.nodes_visited;
 	arg->table_fallbacks = nextarg.table_fallbacks;
+	memcpy(arg->table_prunes, nextarg.table_prunes,
+	    sizeof(arg->table_prunes));
 	return ret;
 }
 
+/*
+Check the corner bounds of the position of the search and start loading
+the entries of the extra tables and of the h48 table for the position and
+for its inverse. Returns false if the position is pruned.
+*/
+STATIC_INLINE bool
+solve_h48_interleave_enter(h48_search_t *s)
+{
+	uint8_t i;
+	dfsarg_solveh48_t *arg;
+
+	arg = &s->arg;
+	if (*arg->nsols == arg->maxsolutions || solve_h48_stop_cbound(arg))
+		return false;
+
+	for (i = 0; i < arg->nextra; i++) {
+		s->extra[i] = solve_h48_extracoord(
+		    &arg->extra[i], arg->cube, arg->cdata);
+		s->extra_inv[i] = solve_h48_extracoord(
+		    &arg->extra[i], arg->inverse, arg->cdata_inv);
+		if (s->extra[i] >= 0 && s->extra_inv[i] >= 0) {
+			prefetch(arg->extra[i].data +
+			    H48_INDEX(s->extra[i], 4));
+			prefetch(arg->extra[i].data +
+			    H48_INDEX(s->extra_inv[i], 4));
+		}
+	}
+
+	s->coord = coord_h48_edges(
+	    arg->cube, COCLASS(arg->cdata), TTREP(arg->cdata), arg->h);
+	s->coord_inv = coord_h48_edges(arg->inverse,
+	    COCLASS(arg->cdata_inv), TTREP(arg->cdata_inv), arg->h);
+	prefetch(arg->h48data + H48_INDEX(s->coord, arg->k));
+	prefetch(arg->h48data + H48_INDEX(s->coord_inv, arg->k));
+
+	return true;
+}
+
+/*
+Finish checking the position of the search with the entries loaded by
+solve_h48_interleave_enter(), in the same order as solve_h48_stop(). If
+the position is not pruned and it is not solved, its children are pushed
+on the stack of the search.
+*/
+STATIC void
+solve_h48_interleave_visit(h48_search_t *s, task_queue_t *tq)
+{
+	uint8_t i, m;
+	int8_t n;
+	uint32_t allowed;
+	h48_frame_t *f;
+	dfsarg_solveh48_t *arg;
+
+	arg = &s->arg;
+	n = arg->nmoves + arg->npremoves;
+	for (i = 0; i < arg->nextra; i++) {
+		if (solve_h48_extravalue(&arg->extra[i], s->extra[i]) + n >
+		    arg->depth || solve_h48_extravalue(&arg->extra[i],
+		    s->extra_inv[i]) + n > arg->depth) {
+			arg->table_prunes[H48_PRUNES_EXTRA + i]++;
+			return;
+		}
+	}
+	if (solve_h48_stop_h48(arg, s->coord, false) ||
+	    solve_h48_stop_h48(arg, s->coord_inv, true))
+		return;
+
+	if (issolved(arg->cube)) {
+		if (n == arg->depth && solve_h48_symmetry_leaf(arg))
+			solve_h48_appendsolution_thread(arg, tq);
+		return;
+	}
+
+	f = &s->frame[s->top++];
+	f->next = 0;
+	f->inverse = arg->nissbranch & MM_INVERSE;
+	f->nmoves = arg->nmoves;
+	f->npremoves = arg->npremoves;
+	if (f->inverse) {
+		allowed = allowednextmove_h48(arg->premoves,
+		    arg->npremoves, arg->nissbranch) &
+		    solve_h48_symmetry_mask(arg, true);
+		expand_moves(arg->inverse, allowed, f->inverses);
+		expand_premoves(arg->cube, allowed, f->cubes);
+	} else {
+		allowed = allowednextmove_h48(arg->moves,
+		    arg->nmoves, arg->nissbranch) &
+		    solve_h48_symmetry_mask(arg, false);
+		expand_moves(arg->cube, allowed, f->cubes);
+		expand_premoves(arg->inverse, allowed, f->inverses);
+	}
+	f->ok = solve_h48_children(arg, allowed, f->cubes, f->inverses,
+	    f->cdata, f->cdata_inv);
+
+	/* Pruned by solve_h48_children() */
+	for (m = 0; m < 18; m++) {
+		if ((allowed & ~f->ok) & (UINT32_C(1) << m)) {
+			arg->nodes_visited++;
+			arg->table_prunes[H48_PRUNES_CBOUND]++;
+		}
+	}
+}
+
+/*
+Visit the position of the search, then move to the next position that is
+not pruned by the corner bounds and start loading its table entries.
+Returns false when the search is over.
+*/
+STATIC bool
+solve_h48_interleave_step(h48_search_t *s, task_queue_t *tq)
+{
+	uint8_t m;
+	h48_frame_t *f;
+	dfsarg_solveh48_t *arg;
+
+	arg = &s->arg;
+	solve_h48_interleave_visit(s, tq);
+	while (s->top > 0) {
+		f = &s->frame[s->top-1];
+		if ((f->ok >> f->next) == 0) {
+			s->top--;
+			continue;
+		}
+		for (m = f->next; !(f->ok & (UINT32_C(1) << m)); m++) ;
+		f->next = m+1;
+
+		arg->nmoves = f->nmoves;
+		arg->npremoves = f->npremoves;
+		if (f->inverse)
+			arg->premoves[arg->npremoves++] = m;
+		else
+			arg->moves[arg->nmoves++] = m;
+		arg->cube = f->cubes[m];
+		arg->inverse = f->inverses[m];
+		arg->cdata = f->cdata[m];
+		arg->cdata_inv = f->cdata_inv[m];
+		if (solve_h48_interleave_enter(s))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+Run targ->interleave searches at the same time, one for each task taken
+from the queue. Each search stops at every position after requesting the
+table entries it needs, and the thread moves on to the next search
+instead of waiting for the memory. By the time the search is resumed, the
+entries are likely to be in the cache.
+
+The tasks are only added to the queue when all of them are finished, so
+once the queue is found empty the thread waits for a new task only after
+all its searches are over.
+*/
+STATIC void
+solve_h48_interleave(solve_thread_arg_t *targ, h48_search_t *s)
+{
+	bool more;
+	unsigned i, n, running;
+
+	n = targ->interleave;
+	for (i = 0; i < n; i++)
+		s[i].running = false;
+
+	for (running = 0, more = true; ; ) {
+		for (i = 0; i < n && (more || running == 0); i++) {
+			if (s[i].running)
+				continue;
+			if (!take_task(targ, running == 0, &s[i].arg)) {
+				if (running == 0)
+					return;
+				more = false;
+				break;
+			}
+			more = true;
+			s[i].top = 0;
+			s[i].running = solve_h48_interleave_enter(&s[i]);
+			if (s[i].running)
+				running++;
+			else
+				finish_task(targ->queue, &s[i].arg);
+		}
+
+		for (i = 0; i < n; i++) {
+			if (s[i].running &&
+			    !solve_h48_interleave_step(&s[i], targ->queue)) {
+				s[i].running = false;
+				running--;
+				finish_task(targ->queue, &s[i].arg);
+			}
+		}
+	}
+}
+
 STATIC int64_t
 solve_h48_multithread(
 	cube_t cube,
@@ -268,9 +607,16 @@ solve_h48_multithread(
 {
 	_Atomic int64_t nsols = 0;
 	int p_depth = 0;
+	bool bfsdone;
+	char *buf, *from;
 	dfsarg_solveh48_t arg;
+	h48_symmetry_t symmetry;
 	tableinfo_t info, fbinfo;
+	int nodes, numaset, node[NUMA_MAXNODES];
+	unsigned nthreads;
+	const void *replica[NUMA_MAXNODES];
 	pthread_t threads[THREADS];
+	solve_thread_arg_t targ[THREADS];
 
 	if (readtableinfo_n(data_size, data, 2, &info) != NISSY_OK)
 		goto solve_h48_multithread_error_data;
@@ -286,13 +632,16 @@ solve_h48_multithread(
 		.base = info.base,
 		.cocsepdata = (uint32_t *)((char *)data + INFOSIZE),
 		.h48data = (uint8_t *)data + COCSEP_FULLSIZE + INFOSIZE,
+		.symmetry = solve_h48_symmetry(cube, &symmetry) ?
+		    &symmetry : NULL,
 		.solutions_size = solutions_size,
 		.nextsol = &solutions,
 		.nodes_visited = 0,
-		.table_fallbacks = 0
+		.table_fallbacks = 0,
+		.table_prunes = {0}
 	};
 
-	if (info.bits == 2) {
+	if (info.bits != 4) {
 		if (readtableinfo_n(data_size, data, 3, &fbinfo) != NISSY_OK)
 			goto solve_h48_multithread_error_data;
 		/* We only support h0k4 as fallback table */
@@ -302,45 +651,78 @@ solve_h48_multithread(
 	} else {
 		arg.h48data_fallback = NULL;
 	}
+	if (solve_h48_extradata(data_size, data, &arg) < 0)
+		goto solve_h48_multithread_error_data;
+	solve_h48_cdata(&arg);
 
 	task_queue_t q;
 	init_queue(&q);
-	if (solve_h48_bfs(&arg, &q, maxmoves))
+	buf = solutions;
+	bfsdone = solve_h48_bfs(&arg, &q, maxmoves);
+
+	/* The solutions shorter than BFS_DEPTH are found by the BFS */
+	arg.solutions_size = solutions_size - (*arg.nextsol - buf);
+	solve_h48_symmetry_expand(&arg, buf);
+	if (bfsdone) {
+		/* All solutions were found in the first few moves */
+		**arg.nextsol = '\0';
+		stats[0] = arg.nodes_visited;
+		stats[1] = arg.table_fallbacks;
+		for (int i = 0; i < H48_PRUNES_LEN; i++)
+			stats[2+i] = arg.table_prunes[i];
 		return nsols;
+	}
 
 	task_queue_t nq;
 	init_queue(&nq);
 
 	nq.nodes_visited_global = nq.table_fallbacks_global = 0;
-	for (int i = 0; i < THREADS; i++) {
-		pthread_create(&threads[i], NULL, &start_thread, &nq);
+	for (int i = 0; i < H48_PRUNES_LEN; i++)
+		nq.table_prunes_global[i] = 0;
+	nthreads = atomic_load(&nissy_threads);
+	nodes = numa_prepare(data_size, data, &numaset, node, replica);
+	for (unsigned i = 0; i < nthreads; i++) {
+		targ[i] = (solve_thread_arg_t) {
+			.queue = &nq,
+			.node = nodes > 0 ? node[i % nodes] : -1,
+			.interleave = atomic_load(&nissy_interleave),
+			.data = data,
+			.replica = nodes > 0 ? replica[i % nodes] : NULL,
+		};
+		pthread_create(&threads[i], NULL, &start_thread, &targ[i]);
 	}
 
-	nsols = 0;
 	for (p_depth = minmoves > BFS_DEPTH ? minmoves : BFS_DEPTH;
 		 p_depth <= maxmoves && nsols < maxsolutions;
 		 p_depth++)
 	{
 		LOG("Found %" PRId64 " solutions, "
 		    "searching at depth %" PRId8 "\n", nsols, p_depth);
+		from = *arg.nextsol;
 		copy_queue(&q, &nq, p_depth, &nsols);
 		
 		pthread_mutex_lock(&nq.mutex);
 		while (nq.active > 0 || nq.tasks_count > 0)
 			pthread_cond_wait(&nq.active_cond, &nq.mutex);
 		pthread_mutex_unlock(&nq.mutex);
+
+		arg.solutions_size = solutions_size - (*arg.nextsol - buf);
+		solve_h48_symmetry_expand(&arg, from);
 	}
 
 	atomic_store(&nq.terminate, true);
 	pthread_cond_broadcast(&nq.cond);
 
-	for (int i = 0; i < THREADS; i++) {
+	for (unsigned i = 0; i < nthreads; i++) {
 		pthread_join(threads[i], NULL);
 	}
+	numa_release(numaset);
 	**arg.nextsol = '\0';
 
 	stats[0] = nq.nodes_visited_global;
 	stats[1] = nq.table_fallbacks_global;
+	for (int i = 0; i < H48_PRUNES_LEN; i++)
+		stats[2+i] = nq.table_prunes_global[i];
 	LOG("Nodes visited: %lld\nTable fallbacks: %lld\n",
 	    nq.nodes_visited_global, nq.table_fallbacks_global);
 
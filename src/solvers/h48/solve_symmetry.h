@@ -0,0 +1,179 @@
+/*
+If the cube to solve is invariant under some of the 48 transformations,
+or if it is transformed into its inverse by some of them, its solutions
+come in groups that are obtained from each other by applying these
+transformations (and by inverting the solution, in the second case).
+
+A transformation t is a symmetry of the cube c if transform(c, t) = c,
+and then for every solution s of c the sequence t(s) is also a solution.
+It is an antisymmetry if transform(c, t) is the inverse of c, and then
+the inverse of t(s) is also a solution.
+
+Consecutive moves on the same axis commute, and the search finds each
+solution only once, with these moves in a fixed order. So the solutions
+are compared by their first and last blocks: the sets of moves that come
+before the first change of axis and after the last one. They do not depend
+on the order of the commuting moves, and a transformation maps the blocks
+of a solution to the blocks of its image. The solver only keeps the
+solutions whose pair of blocks is the smallest in its orbit under the
+transformations, see solve_h48_symmetry_check(), and finds the others by
+transforming these, see solve_h48_symmetry_expand().
+
+As soon as a side of the search changes axis for the first time, the block
+of that side is known and the branch can be pruned. For a cube with many
+symmetries this makes the search up to 48 times faster.
+*/
+typedef struct {
+	uint64_t trans; /* Symmetries */
+	uint64_t anti;  /* Antisymmetries */
+} h48_symmetry_t;
+
+STATIC bool solve_h48_symmetry(cube_t, h48_symmetry_t *);
+STATIC_INLINE bool solve_h48_symmetry_has(
+    const h48_symmetry_t *, uint8_t, bool);
+STATIC_INLINE uint8_t solve_h48_symmetry_min(
+    const h48_symmetry_t *, uint8_t, bool, uint32_t);
+STATIC bool solve_h48_symmetry_check(
+    const h48_symmetry_t *, uint32_t, uint32_t);
+STATIC_INLINE uint32_t solve_h48_symmetry_block(
+    uint8_t, const uint8_t *, bool, bool *);
+STATIC void solve_h48_symmetry_canonical(uint8_t, uint8_t *);
+
+/*
+Find the symmetries and the antisymmetries of the cube. Returns false if
+the cube has no symmetry other than the identity and no antisymmetry, in
+which case nothing is restricted.
+*/
+STATIC bool
+solve_h48_symmetry(cube_t cube, h48_symmetry_t *sym)
+{
+	uint8_t t;
+	cube_t inv;
+
+	inv = inverse(cube);
+	sym->trans = sym->anti = 0;
+	for (t = 0; t < 48; t++) {
+		if (equal(transform(cube, t), cube))
+			sym->trans |= UINT64_C(1) << t;
+		if (equal(transform(cube, t), inv))
+			sym->anti |= UINT64_C(1) << t;
+	}
+
+	return sym->trans != UINT64_C(1) << TRANS_UFr || sym->anti != 0;
+}
+
+/* Check if t is a symmetry, or an antisymmetry if anti is true */
+STATIC_INLINE bool
+solve_h48_symmetry_has(const h48_symmetry_t *sym, uint8_t t, bool anti)
+{
+	return (anti ? sym->anti : sym->trans) & (UINT64_C(1) << t);
+}
+
+/*
+The smallest move of the block transformed by t, inverted if t is used as
+an antisymmetry. The block must not be empty.
+*/
+STATIC_INLINE uint8_t
+solve_h48_symmetry_min(
+	const h48_symmetry_t *sym,
+	uint8_t t,
+	bool anti,
+	uint32_t block
+)
+{
+	uint8_t m, n, ret;
+
+	for (m = 0, ret = 18; m < 18; m++) {
+		if (!(block & (UINT32_C(1) << m)))
+			continue;
+		n = transform_move(m, t);
+		if (anti)
+			n = inverse_move(n);
+		ret = MIN(ret, n);
+	}
+
+	return ret;
+}
+
+/*
+Check that no transformation makes the pair of blocks first, last smaller,
+comparing the smallest move of each block, the first block before the
+last. An empty block means that the block is not known yet, and nothing
+is checked for the transformations that need it.
+*/
+STATIC bool
+solve_h48_symmetry_check(
+	const h48_symmetry_t *sym,
+	uint32_t first,
+	uint32_t last
+)
+{
+	bool anti;
+	uint8_t t, f, l, tf;
+	uint32_t tfirst, tlast;
+
+	if (first == 0)
+		return true;
+
+	f = solve_h48_symmetry_min(sym, TRANS_UFr, false, first);
+	l = last == 0 ? 0 :
+	    solve_h48_symmetry_min(sym, TRANS_UFr, false, last);
+	for (t = 0; t < 96; t++) {
+		anti = t >= 48;
+		if (!solve_h48_symmetry_has(sym, t % 48, anti))
+			continue;
+
+		/* An antisymmetry reverses the solution */
+		tfirst = anti ? last : first;
+		tlast = anti ? first : last;
+		if (tfirst == 0)
+			continue;
+		tf = solve_h48_symmetry_min(sym, t % 48, anti, tfirst);
+		if (tf < f)
+			return false;
+		if (tf == f && tlast != 0 && last != 0 &&
+		    solve_h48_symmetry_min(sym, t % 48, anti, tlast) < l)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+The block at the start of the n moves, inverted if inverse is true. The
+variable closed is set to true if the moves change axis after the block,
+so that the block cannot grow anymore.
+*/
+STATIC_INLINE uint32_t
+solve_h48_symmetry_block(
+	uint8_t n,
+	const uint8_t *moves,
+	bool inverse,
+	bool *closed
+)
+{
+	uint8_t i;
+	uint32_t ret;
+
+	for (i = 0, ret = 0; i < n && moveaxis(moves[i]) == moveaxis(moves[0]);
+	    i++)
+		ret |= UINT32_C(1) << (inverse ? inverse_move(moves[i]) : moves[i]);
+	*closed = i < n;
+
+	return ret;
+}
+
+/* Sort the moves of each block of consecutive moves on the same axis */
+STATIC void
+solve_h48_symmetry_canonical(uint8_t n, uint8_t *moves)
+{
+	uint8_t i, j, m;
+
+	for (i = 1; i < n; i++) {
+		m = moves[i];
+		for (j = i; j > 0 && moveaxis(moves[j-1]) == moveaxis(m) &&
+		    moves[j-1] > m; j--)
+			moves[j] = moves[j-1];
+		moves[j] = m;
+	}
+}
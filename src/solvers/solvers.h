@@ -1,2 +1,3 @@
 #include "tables.h"
 #include "h48/h48.h"
+#include "cache.h"
@@ -9,19 +9,348 @@
 #define COMB_12_4  INT64_C(495)
 #define COMB_8_4   INT64_C(70)
 
-STATIC int64_t binomial[12][12] = {
-	{1,  0,  0,   0,   0,   0,   0,   0,   0,  0,  0, 0},
-	{1,  1,  0,   0,   0,   0,   0,   0,   0,  0,  0, 0},
-	{1,  2,  1,   0,   0,   0,   0,   0,   0,  0,  0, 0},
-	{1,  3,  3,   1,   0,   0,   0,   0,   0,  0,  0, 0},
-	{1,  4,  6,   4,   1,   0,   0,   0,   0,  0,  0, 0},
-	{1,  5, 10,  10,   5,   1,   0,   0,   0,  0,  0, 0},
-	{1,  6, 15,  20,  15,   6,   1,   0,   0,  0,  0, 0},
-	{1,  7, 21,  35,  35,  21,   7,   1,   0,  0,  0, 0},
-	{1,  8, 28,  56,  70,  56,  28,   8,   1,  0,  0, 0},
-	{1,  9, 36,  84, 126, 126,  84,  36,   9,  1,  0, 0},
-	{1, 10, 45, 120, 210, 252, 210, 120,  45, 10,  1, 0},
-	{1, 11, 55, 165, 330, 462, 462, 330, 165, 55, 11, 1},
+/*
+Tables used to compute the esep coordinate. This coordinate encodes the
+positions of the E-slice edges (FR, FL, BL, BR) among all 12 edges, and
+those of the S-slice edges (UR, UL, DL, DR) among the remaining 8. These
+positions can be given as bitmasks with 4 bits set; the tables below give
+the rank of each such bitmask and, conversely, the bitmask with a given
+rank. See coord_esep_masks() and invcoord_esep_array().
+*/
+STATIC const uint16_t esep_rank12[4096] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 494,
+	0, 0, 0, 0, 0, 0, 0, 493, 0, 0, 0, 485, 0, 449, 329, 0,
+	0, 0, 0, 0, 0, 0, 0, 492, 0, 0, 0, 484, 0, 448, 328, 0,
+	0, 0, 0, 477, 0, 441, 321, 0, 0, 413, 293, 0, 209, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 491, 0, 0, 0, 483, 0, 447, 327, 0,
+	0, 0, 0, 476, 0, 440, 320, 0, 0, 412, 292, 0, 208, 0, 0, 0,
+	0, 0, 0, 470, 0, 434, 314, 0, 0, 406, 286, 0, 202, 0, 0, 0,
+	0, 385, 265, 0, 181, 0, 0, 0, 125, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 490, 0, 0, 0, 482, 0, 446, 326, 0,
+	0, 0, 0, 475, 0, 439, 319, 0, 0, 411, 291, 0, 207, 0, 0, 0,
+	0, 0, 0, 469, 0, 433, 313, 0, 0, 405, 285, 0, 201, 0, 0, 0,
+	0, 384, 264, 0, 180, 0, 0, 0, 124, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 464, 0, 428, 308, 0, 0, 400, 280, 0, 196, 0, 0, 0,
+	0, 379, 259, 0, 175, 0, 0, 0, 119, 0, 0, 0, 0, 0, 0, 0,
+	0, 364, 244, 0, 160, 0, 0, 0, 104, 0, 0, 0, 0, 0, 0, 0,
+	69, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 489, 0, 0, 0, 481, 0, 445, 325, 0,
+	0, 0, 0, 474, 0, 438, 318, 0, 0, 410, 290, 0, 206, 0, 0, 0,
+	0, 0, 0, 468, 0, 432, 312, 0, 0, 404, 284, 0, 200, 0, 0, 0,
+	0, 383, 263, 0, 179, 0, 0, 0, 123, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 463, 0, 427, 307, 0, 0, 399, 279, 0, 195, 0, 0, 0,
+	0, 378, 258, 0, 174, 0, 0, 0, 118, 0, 0, 0, 0, 0, 0, 0,
+	0, 363, 243, 0, 159, 0, 0, 0, 103, 0, 0, 0, 0, 0, 0, 0,
+	68, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 459, 0, 423, 303, 0, 0, 395, 275, 0, 191, 0, 0, 0,
+	0, 374, 254, 0, 170, 0, 0, 0, 114, 0, 0, 0, 0, 0, 0, 0,
+	0, 359, 239, 0, 155, 0, 0, 0, 99, 0, 0, 0, 0, 0, 0, 0,
+	64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 349, 229, 0, 145, 0, 0, 0, 89, 0, 0, 0, 0, 0, 0, 0,
+	54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	34, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 488, 0, 0, 0, 480, 0, 444, 324, 0,
+	0, 0, 0, 473, 0, 437, 317, 0, 0, 409, 289, 0, 205, 0, 0, 0,
+	0, 0, 0, 467, 0, 431, 311, 0, 0, 403, 283, 0, 199, 0, 0, 0,
+	0, 382, 262, 0, 178, 0, 0, 0, 122, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 462, 0, 426, 306, 0, 0, 398, 278, 0, 194, 0, 0, 0,
+	0, 377, 257, 0, 173, 0, 0, 0, 117, 0, 0, 0, 0, 0, 0, 0,
+	0, 362, 242, 0, 158, 0, 0, 0, 102, 0, 0, 0, 0, 0, 0, 0,
+	67, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 458, 0, 422, 302, 0, 0, 394, 274, 0, 190, 0, 0, 0,
+	0, 373, 253, 0, 169, 0, 0, 0, 113, 0, 0, 0, 0, 0, 0, 0,
+	0, 358, 238, 0, 154, 0, 0, 0, 98, 0, 0, 0, 0, 0, 0, 0,
+	63, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 348, 228, 0, 144, 0, 0, 0, 88, 0, 0, 0, 0, 0, 0, 0,
+	53, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	33, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 455, 0, 419, 299, 0, 0, 391, 271, 0, 187, 0, 0, 0,
+	0, 370, 250, 0, 166, 0, 0, 0, 110, 0, 0, 0, 0, 0, 0, 0,
+	0, 355, 235, 0, 151, 0, 0, 0, 95, 0, 0, 0, 0, 0, 0, 0,
+	60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 345, 225, 0, 141, 0, 0, 0, 85, 0, 0, 0, 0, 0, 0, 0,
+	50, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	30, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 339, 219, 0, 135, 0, 0, 0, 79, 0, 0, 0, 0, 0, 0, 0,
+	44, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	24, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 487, 0, 0, 0, 479, 0, 443, 323, 0,
+	0, 0, 0, 472, 0, 436, 316, 0, 0, 408, 288, 0, 204, 0, 0, 0,
+	0, 0, 0, 466, 0, 430, 310, 0, 0, 402, 282, 0, 198, 0, 0, 0,
+	0, 381, 261, 0, 177, 0, 0, 0, 121, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 461, 0, 425, 305, 0, 0, 397, 277, 0, 193, 0, 0, 0,
+	0, 376, 256, 0, 172, 0, 0, 0, 116, 0, 0, 0, 0, 0, 0, 0,
+	0, 361, 241, 0, 157, 0, 0, 0, 101, 0, 0, 0, 0, 0, 0, 0,
+	66, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 457, 0, 421, 301, 0, 0, 393, 273, 0, 189, 0, 0, 0,
+	0, 372, 252, 0, 168, 0, 0, 0, 112, 0, 0, 0, 0, 0, 0, 0,
+	0, 357, 237, 0, 153, 0, 0, 0, 97, 0, 0, 0, 0, 0, 0, 0,
+	62, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 347, 227, 0, 143, 0, 0, 0, 87, 0, 0, 0, 0, 0, 0, 0,
+	52, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	32, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 454, 0, 418, 298, 0, 0, 390, 270, 0, 186, 0, 0, 0,
+	0, 369, 249, 0, 165, 0, 0, 0, 109, 0, 0, 0, 0, 0, 0, 0,
+	0, 354, 234, 0, 150, 0, 0, 0, 94, 0, 0, 0, 0, 0, 0, 0,
+	59, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 344, 224, 0, 140, 0, 0, 0, 84, 0, 0, 0, 0, 0, 0, 0,
+	49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	29, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 338, 218, 0, 134, 0, 0, 0, 78, 0, 0, 0, 0, 0, 0, 0,
+	43, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	23, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 452, 0, 416, 296, 0, 0, 388, 268, 0, 184, 0, 0, 0,
+	0, 367, 247, 0, 163, 0, 0, 0, 107, 0, 0, 0, 0, 0, 0, 0,
+	0, 352, 232, 0, 148, 0, 0, 0, 92, 0, 0, 0, 0, 0, 0, 0,
+	57, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 342, 222, 0, 138, 0, 0, 0, 82, 0, 0, 0, 0, 0, 0, 0,
+	47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 336, 216, 0, 132, 0, 0, 0, 76, 0, 0, 0, 0, 0, 0, 0,
+	41, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	21, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 333, 213, 0, 129, 0, 0, 0, 73, 0, 0, 0, 0, 0, 0, 0,
+	38, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 486, 0, 0, 0, 478, 0, 442, 322, 0,
+	0, 0, 0, 471, 0, 435, 315, 0, 0, 407, 287, 0, 203, 0, 0, 0,
+	0, 0, 0, 465, 0, 429, 309, 0, 0, 401, 281, 0, 197, 0, 0, 0,
+	0, 380, 260, 0, 176, 0, 0, 0, 120, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 460, 0, 424, 304, 0, 0, 396, 276, 0, 192, 0, 0, 0,
+	0, 375, 255, 0, 171, 0, 0, 0, 115, 0, 0, 0, 0, 0, 0, 0,
+	0, 360, 240, 0, 156, 0, 0, 0, 100, 0, 0, 0, 0, 0, 0, 0,
+	65, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 456, 0, 420, 300, 0, 0, 392, 272, 0, 188, 0, 0, 0,
+	0, 371, 251, 0, 167, 0, 0, 0, 111, 0, 0, 0, 0, 0, 0, 0,
+	0, 356, 236, 0, 152, 0, 0, 0, 96, 0, 0, 0, 0, 0, 0, 0,
+	61, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 346, 226, 0, 142, 0, 0, 0, 86, 0, 0, 0, 0, 0, 0, 0,
+	51, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 453, 0, 417, 297, 0, 0, 389, 269, 0, 185, 0, 0, 0,
+	0, 368, 248, 0, 164, 0, 0, 0, 108, 0, 0, 0, 0, 0, 0, 0,
+	0, 353, 233, 0, 149, 0, 0, 0, 93, 0, 0, 0, 0, 0, 0, 0,
+	58, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 343, 223, 0, 139, 0, 0, 0, 83, 0, 0, 0, 0, 0, 0, 0,
+	48, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 337, 217, 0, 133, 0, 0, 0, 77, 0, 0, 0, 0, 0, 0, 0,
+	42, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	22, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 451, 0, 415, 295, 0, 0, 387, 267, 0, 183, 0, 0, 0,
+	0, 366, 246, 0, 162, 0, 0, 0, 106, 0, 0, 0, 0, 0, 0, 0,
+	0, 351, 231, 0, 147, 0, 0, 0, 91, 0, 0, 0, 0, 0, 0, 0,
+	56, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 341, 221, 0, 137, 0, 0, 0, 81, 0, 0, 0, 0, 0, 0, 0,
+	46, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 335, 215, 0, 131, 0, 0, 0, 75, 0, 0, 0, 0, 0, 0, 0,
+	40, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 332, 212, 0, 128, 0, 0, 0, 72, 0, 0, 0, 0, 0, 0, 0,
+	37, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 450, 0, 414, 294, 0, 0, 386, 266, 0, 182, 0, 0, 0,
+	0, 365, 245, 0, 161, 0, 0, 0, 105, 0, 0, 0, 0, 0, 0, 0,
+	0, 350, 230, 0, 146, 0, 0, 0, 90, 0, 0, 0, 0, 0, 0, 0,
+	55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 340, 220, 0, 136, 0, 0, 0, 80, 0, 0, 0, 0, 0, 0, 0,
+	45, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 334, 214, 0, 130, 0, 0, 0, 74, 0, 0, 0, 0, 0, 0, 0,
+	39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	19, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 331, 211, 0, 127, 0, 0, 0, 71, 0, 0, 0, 0, 0, 0, 0,
+	36, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 330, 210, 0, 126, 0, 0, 0, 70, 0, 0, 0, 0, 0, 0, 0,
+	35, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+STATIC const uint8_t esep_rank8[256] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 69,
+	0, 0, 0, 0, 0, 0, 0, 68, 0, 0, 0, 64, 0, 54, 34, 0,
+	0, 0, 0, 0, 0, 0, 0, 67, 0, 0, 0, 63, 0, 53, 33, 0,
+	0, 0, 0, 60, 0, 50, 30, 0, 0, 44, 24, 0, 14, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 66, 0, 0, 0, 62, 0, 52, 32, 0,
+	0, 0, 0, 59, 0, 49, 29, 0, 0, 43, 23, 0, 13, 0, 0, 0,
+	0, 0, 0, 57, 0, 47, 27, 0, 0, 41, 21, 0, 11, 0, 0, 0,
+	0, 38, 18, 0, 8, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 65, 0, 0, 0, 61, 0, 51, 31, 0,
+	0, 0, 0, 58, 0, 48, 28, 0, 0, 42, 22, 0, 12, 0, 0, 0,
+	0, 0, 0, 56, 0, 46, 26, 0, 0, 40, 20, 0, 10, 0, 0, 0,
+	0, 37, 17, 0, 7, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 55, 0, 45, 25, 0, 0, 39, 19, 0, 9, 0, 0, 0,
+	0, 36, 16, 0, 6, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0,
+	0, 35, 15, 0, 5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+STATIC const uint16_t esep_unrank12[495] = {
+	3840, 3712, 3456, 2944, 1920, 3648, 3392, 2880, 1856, 3264, 2752,
+	1728, 2496, 1472, 960, 3616, 3360, 2848, 1824, 3232, 2720, 1696,
+	2464, 1440, 928, 3168, 2656, 1632, 2400, 1376, 864, 2272, 1248,
+	736, 480, 3600, 3344, 2832, 1808, 3216, 2704, 1680, 2448, 1424,
+	912, 3152, 2640, 1616, 2384, 1360, 848, 2256, 1232, 720, 464,
+	3120, 2608, 1584, 2352, 1328, 816, 2224, 1200, 688, 432, 2160,
+	1136, 624, 368, 240, 3592, 3336, 2824, 1800, 3208, 2696, 1672,
+	2440, 1416, 904, 3144, 2632, 1608, 2376, 1352, 840, 2248, 1224,
+	712, 456, 3112, 2600, 1576, 2344, 1320, 808, 2216, 1192, 680,
+	424, 2152, 1128, 616, 360, 232, 3096, 2584, 1560, 2328, 1304,
+	792, 2200, 1176, 664, 408, 2136, 1112, 600, 344, 216, 2104,
+	1080, 568, 312, 184, 120, 3588, 3332, 2820, 1796, 3204, 2692,
+	1668, 2436, 1412, 900, 3140, 2628, 1604, 2372, 1348, 836, 2244,
+	1220, 708, 452, 3108, 2596, 1572, 2340, 1316, 804, 2212, 1188,
+	676, 420, 2148, 1124, 612, 356, 228, 3092, 2580, 1556, 2324,
+	1300, 788, 2196, 1172, 660, 404, 2132, 1108, 596, 340, 212,
+	2100, 1076, 564, 308, 180, 116, 3084, 2572, 1548, 2316, 1292,
+	780, 2188, 1164, 652, 396, 2124, 1100, 588, 332, 204, 2092,
+	1068, 556, 300, 172, 108, 2076, 1052, 540, 284, 156, 92,
+	60, 3586, 3330, 2818, 1794, 3202, 2690, 1666, 2434, 1410, 898,
+	3138, 2626, 1602, 2370, 1346, 834, 2242, 1218, 706, 450, 3106,
+	2594, 1570, 2338, 1314, 802, 2210, 1186, 674, 418, 2146, 1122,
+	610, 354, 226, 3090, 2578, 1554, 2322, 1298, 786, 2194, 1170,
+	658, 402, 2130, 1106, 594, 338, 210, 2098, 1074, 562, 306,
+	178, 114, 3082, 2570, 1546, 2314, 1290, 778, 2186, 1162, 650,
+	394, 2122, 1098, 586, 330, 202, 2090, 1066, 554, 298, 170,
+	106, 2074, 1050, 538, 282, 154, 90, 58, 3078, 2566, 1542,
+	2310, 1286, 774, 2182, 1158, 646, 390, 2118, 1094, 582, 326,
+	198, 2086, 1062, 550, 294, 166, 102, 2070, 1046, 534, 278,
+	150, 86, 54, 2062, 1038, 526, 270, 142, 78, 46, 30,
+	3585, 3329, 2817, 1793, 3201, 2689, 1665, 2433, 1409, 897, 3137,
+	2625, 1601, 2369, 1345, 833, 2241, 1217, 705, 449, 3105, 2593,
+	1569, 2337, 1313, 801, 2209, 1185, 673, 417, 2145, 1121, 609,
+	353, 225, 3089, 2577, 1553, 2321, 1297, 785, 2193, 1169, 657,
+	401, 2129, 1105, 593, 337, 209, 2097, 1073, 561, 305, 177,
+	113, 3081, 2569, 1545, 2313, 1289, 777, 2185, 1161, 649, 393,
+	2121, 1097, 585, 329, 201, 2089, 1065, 553, 297, 169, 105,
+	2073, 1049, 537, 281, 153, 89, 57, 3077, 2565, 1541, 2309,
+	1285, 773, 2181, 1157, 645, 389, 2117, 1093, 581, 325, 197,
+	2085, 1061, 549, 293, 165, 101, 2069, 1045, 533, 277, 149,
+	85, 53, 2061, 1037, 525, 269, 141, 77, 45, 29, 3075,
+	2563, 1539, 2307, 1283, 771, 2179, 1155, 643, 387, 2115, 1091,
+	579, 323, 195, 2083, 1059, 547, 291, 163, 99, 2067, 1043,
+	531, 275, 147, 83, 51, 2059, 1035, 523, 267, 139, 75,
+	43, 27, 2055, 1031, 519, 263, 135, 71, 39, 23, 15,
+};
+
+STATIC const uint8_t esep_unrank8[70] = {
+	240, 232, 216, 184, 120, 228, 212, 180, 116, 204,
+	172, 108, 156, 92, 60, 226, 210, 178, 114, 202,
+	170, 106, 154, 90, 58, 198, 166, 102, 150, 86,
+	54, 142, 78, 46, 30, 225, 209, 177, 113, 201,
+	169, 105, 153, 89, 57, 197, 165, 101, 149, 85,
+	53, 141, 77, 45, 29, 195, 163, 99, 147, 83,
+	51, 139, 75, 43, 27, 135, 71, 39, 23, 15,
 };
 
 #define MOVE_U  UINT8_C(0)
@@ -296,3 +625,258 @@ static uint8_t inverse_trans_table[48] = {
 	[TRANS_BLr] = TRANS_RDr,
 	[TRANS_BLm] = TRANS_LDm,
 };
+
+/*
+Composition of transformations: transforming a cube by t1 and then by t2
+is the same as transforming it by compose_trans_table[t1][t2].
+*/
+static uint8_t compose_trans_table[48][48] = {
+	{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+	 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47},
+	{1, 2, 3, 0, 7, 4, 5, 6, 11, 8, 9, 10, 13, 14, 15, 12,
+	 17, 18, 19, 16, 23, 20, 21, 22, 25, 26, 27, 24, 31, 28, 29, 30,
+	 35, 32, 33, 34, 37, 38, 39, 36, 41, 42, 43, 40, 47, 44, 45, 46},
+	{2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+	 18, 19, 16, 17, 22, 23, 20, 21, 26, 27, 24, 25, 30, 31, 28, 29,
+	 34, 35, 32, 33, 38, 39, 36, 37, 42, 43, 40, 41, 46, 47, 44, 45},
+	{3, 0, 1, 2, 5, 6, 7, 4, 9, 10, 11, 8, 15, 12, 13, 14,
+	 19, 16, 17, 18, 21, 22, 23, 20, 27, 24, 25, 26, 29, 30, 31, 28,
+	 33, 34, 35, 32, 39, 36, 37, 38, 43, 40, 41, 42, 45, 46, 47, 44},
+	{4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11,
+	 20, 21, 22, 23, 16, 17, 18, 19, 28, 29, 30, 31, 24, 25, 26, 27,
+	 36, 37, 38, 39, 32, 33, 34, 35, 44, 45, 46, 47, 40, 41, 42, 43},
+	{5, 6, 7, 4, 3, 0, 1, 2, 15, 12, 13, 14, 9, 10, 11, 8,
+	 21, 22, 23, 20, 19, 16, 17, 18, 29, 30, 31, 28, 27, 24, 25, 26,
+	 39, 36, 37, 38, 33, 34, 35, 32, 45, 46, 47, 44, 43, 40, 41, 42},
+	{6, 7, 4, 5, 2, 3, 0, 1, 14, 15, 12, 13, 10, 11, 8, 9,
+	 22, 23, 20, 21, 18, 19, 16, 17, 30, 31, 28, 29, 26, 27, 24, 25,
+	 38, 39, 36, 37, 34, 35, 32, 33, 46, 47, 44, 45, 42, 43, 40, 41},
+	{7, 4, 5, 6, 1, 2, 3, 0, 13, 14, 15, 12, 11, 8, 9, 10,
+	 23, 20, 21, 22, 17, 18, 19, 16, 31, 28, 29, 30, 25, 26, 27, 24,
+	 37, 38, 39, 36, 35, 32, 33, 34, 47, 44, 45, 46, 41, 42, 43, 40},
+	{8, 16, 12, 20, 14, 22, 10, 18, 17, 7, 21, 3, 23, 1, 19, 5,
+	 13, 0, 9, 4, 11, 6, 15, 2, 32, 40, 36, 44, 38, 46, 34, 42,
+	 41, 31, 45, 27, 47, 25, 43, 29, 37, 24, 33, 28, 35, 30, 39, 26},
+	{9, 19, 15, 21, 13, 23, 11, 17, 16, 4, 22, 2, 20, 0, 18, 6,
+	 12, 3, 10, 5, 8, 7, 14, 1, 33, 43, 39, 45, 37, 47, 35, 41,
+	 40, 28, 46, 26, 44, 24, 42, 30, 36, 27, 34, 29, 32, 31, 38, 25},
+	{10, 18, 14, 22, 12, 20, 8, 16, 19, 5, 23, 1, 21, 3, 17, 7,
+	 15, 2, 11, 6, 9, 4, 13, 0, 34, 42, 38, 46, 36, 44, 32, 40,
+	 43, 29, 47, 25, 45, 27, 41, 31, 39, 26, 35, 30, 33, 28, 37, 24},
+	{11, 17, 13, 23, 15, 21, 9, 19, 18, 6, 20, 0, 22, 2, 16, 4,
+	 14, 1, 8, 7, 10, 5, 12, 3, 35, 41, 37, 47, 39, 45, 33, 43,
+	 42, 30, 44, 24, 46, 26, 40, 28, 38, 25, 32, 31, 34, 29, 36, 27},
+	{12, 20, 8, 16, 10, 18, 14, 22, 21, 3, 17, 7, 19, 5, 23, 1,
+	 9, 4, 13, 0, 15, 2, 11, 6, 36, 44, 32, 40, 34, 42, 38, 46,
+	 45, 27, 41, 31, 43, 29, 47, 25, 33, 28, 37, 24, 39, 26, 35, 30},
+	{13, 23, 11, 17, 9, 19, 15, 21, 20, 0, 18, 6, 16, 4, 22, 2,
+	 8, 7, 14, 1, 12, 3, 10, 5, 37, 47, 35, 41, 33, 43, 39, 45,
+	 44, 24, 42, 30, 40, 28, 46, 26, 32, 31, 38, 25, 36, 27, 34, 29},
+	{14, 22, 10, 18, 8, 16, 12, 20, 23, 1, 19, 5, 17, 7, 21, 3,
+	 11, 6, 15, 2, 13, 0, 9, 4, 38, 46, 34, 42, 32, 40, 36, 44,
+	 47, 25, 43, 29, 41, 31, 45, 27, 35, 30, 39, 26, 37, 24, 33, 28},
+	{15, 21, 9, 19, 11, 17, 13, 23, 22, 2, 16, 4, 18, 6, 20, 0,
+	 10, 5, 12, 3, 14, 1, 8, 7, 39, 45, 33, 43, 35, 41, 37, 47,
+	 46, 26, 40, 28, 42, 30, 44, 24, 34, 29, 36, 27, 38, 25, 32, 31},
+	{16, 12, 20, 8, 18, 14, 22, 10, 3, 17, 7, 21, 1, 19, 5, 23,
+	 0, 9, 4, 13, 2, 11, 6, 15, 40, 36, 44, 32, 42, 38, 46, 34,
+	 27, 41, 31, 45, 25, 43, 29, 47, 24, 33, 28, 37, 26, 35, 30, 39},
+	{17, 13, 23, 11, 19, 15, 21, 9, 0, 18, 6, 20, 2, 16, 4, 22,
+	 1, 8, 7, 14, 3, 10, 5, 12, 41, 37, 47, 35, 43, 39, 45, 33,
+	 24, 42, 30, 44, 26, 40, 28, 46, 25, 32, 31, 38, 27, 34, 29, 36},
+	{18, 14, 22, 10, 16, 12, 20, 8, 1, 19, 5, 23, 3, 17, 7, 21,
+	 2, 11, 6, 15, 0, 9, 4, 13, 42, 38, 46, 34, 40, 36, 44, 32,
+	 25, 43, 29, 47, 27, 41, 31, 45, 26, 35, 30, 39, 24, 33, 28, 37},
+	{19, 15, 21, 9, 17, 13, 23, 11, 2, 16, 4, 22, 0, 18, 6, 20,
+	 3, 10, 5, 12, 1, 8, 7, 14, 43, 39, 45, 33, 41, 37, 47, 35,
+	 26, 40, 28, 46, 24, 42, 30, 44, 27, 34, 29, 36, 25, 32, 31, 38},
+	{20, 8, 16, 12, 22, 10, 18, 14, 7, 21, 3, 17, 5, 23, 1, 19,
+	 4, 13, 0, 9, 6, 15, 2, 11, 44, 32, 40, 36, 46, 34, 42, 38,
+	 31, 45, 27, 41, 29, 47, 25, 43, 28, 37, 24, 33, 30, 39, 26, 35},
+	{21, 9, 19, 15, 23, 11, 17, 13, 4, 22, 2, 16, 6, 20, 0, 18,
+	 5, 12, 3, 10, 7, 14, 1, 8, 45, 33, 43, 39, 47, 35, 41, 37,
+	 28, 46, 26, 40, 30, 44, 24, 42, 29, 36, 27, 34, 31, 38, 25, 32},
+	{22, 10, 18, 14, 20, 8, 16, 12, 5, 23, 1, 19, 7, 21, 3, 17,
+	 6, 15, 2, 11, 4, 13, 0, 9, 46, 34, 42, 38, 44, 32, 40, 36,
+	 29, 47, 25, 43, 31, 45, 27, 41, 30, 39, 26, 35, 28, 37, 24, 33},
+	{23, 11, 17, 13, 21, 9, 19, 15, 6, 20, 0, 18, 4, 22, 2, 16,
+	 7, 14, 1, 8, 5, 12, 3, 10, 47, 35, 41, 37, 45, 33, 43, 39,
+	 30, 44, 24, 42, 28, 46, 26, 40, 31, 38, 25, 32, 29, 36, 27, 34},
+	{24, 27, 26, 25, 28, 31, 30, 29, 36, 37, 38, 39, 32, 33, 34, 35,
+	 40, 43, 42, 41, 44, 47, 46, 45, 0, 3, 2, 1, 4, 7, 6, 5,
+	 12, 13, 14, 15, 8, 9, 10, 11, 16, 19, 18, 17, 20, 23, 22, 21},
+	{25, 24, 27, 26, 31, 30, 29, 28, 37, 38, 39, 36, 35, 32, 33, 34,
+	 41, 40, 43, 42, 47, 46, 45, 44, 1, 0, 3, 2, 7, 6, 5, 4,
+	 13, 14, 15, 12, 11, 8, 9, 10, 17, 16, 19, 18, 23, 22, 21, 20},
+	{26, 25, 24, 27, 30, 29, 28, 31, 38, 39, 36, 37, 34, 35, 32, 33,
+	 42, 41, 40, 43, 46, 45, 44, 47, 2, 1, 0, 3, 6, 5, 4, 7,
+	 14, 15, 12, 13, 10, 11, 8, 9, 18, 17, 16, 19, 22, 21, 20, 23},
+	{27, 26, 25, 24, 29, 28, 31, 30, 39, 36, 37, 38, 33, 34, 35, 32,
+	 43, 42, 41, 40, 45, 44, 47, 46, 3, 2, 1, 0, 5, 4, 7, 6,
+	 15, 12, 13, 14, 9, 10, 11, 8, 19, 18, 17, 16, 21, 20, 23, 22},
+	{28, 31, 30, 29, 24, 27, 26, 25, 32, 33, 34, 35, 36, 37, 38, 39,
+	 44, 47, 46, 45, 40, 43, 42, 41, 4, 7, 6, 5, 0, 3, 2, 1,
+	 8, 9, 10, 11, 12, 13, 14, 15, 20, 23, 22, 21, 16, 19, 18, 17},
+	{29, 28, 31, 30, 27, 26, 25, 24, 33, 34, 35, 32, 39, 36, 37, 38,
+	 45, 44, 47, 46, 43, 42, 41, 40, 5, 4, 7, 6, 3, 2, 1, 0,
+	 9, 10, 11, 8, 15, 12, 13, 14, 21, 20, 23, 22, 19, 18, 17, 16},
+	{30, 29, 28, 31, 26, 25, 24, 27, 34, 35, 32, 33, 38, 39, 36, 37,
+	 46, 45, 44, 47, 42, 41, 40, 43, 6, 5, 4, 7, 2, 1, 0, 3,
+	 10, 11, 8, 9, 14, 15, 12, 13, 22, 21, 20, 23, 18, 17, 16, 19},
+	{31, 30, 29, 28, 25, 24, 27, 26, 35, 32, 33, 34, 37, 38, 39, 36,
+	 47, 46, 45, 44, 41, 40, 43, 42, 7, 6, 5, 4, 1, 0, 3, 2,
+	 11, 8, 9, 10, 13, 14, 15, 12, 23, 22, 21, 20, 17, 16, 19, 18},
+	{32, 44, 36, 40, 38, 42, 34, 46, 47, 25, 43, 29, 41, 31, 45, 27,
+	 37, 28, 33, 24, 35, 26, 39, 30, 8, 20, 12, 16, 14, 18, 10, 22,
+	 23, 1, 19, 5, 17, 7, 21, 3, 13, 4, 9, 0, 11, 2, 15, 6},
+	{33, 45, 39, 43, 37, 41, 35, 47, 44, 24, 42, 30, 40, 28, 46, 26,
+	 36, 29, 34, 27, 32, 25, 38, 31, 9, 21, 15, 19, 13, 17, 11, 23,
+	 20, 0, 18, 6, 16, 4, 22, 2, 12, 5, 10, 3, 8, 1, 14, 7},
+	{34, 46, 38, 42, 36, 40, 32, 44, 45, 27, 41, 31, 43, 29, 47, 25,
+	 39, 30, 35, 26, 33, 24, 37, 28, 10, 22, 14, 18, 12, 16, 8, 20,
+	 21, 3, 17, 7, 19, 5, 23, 1, 15, 6, 11, 2, 9, 0, 13, 4},
+	{35, 47, 37, 41, 39, 43, 33, 45, 46, 26, 40, 28, 42, 30, 44, 24,
+	 38, 31, 32, 25, 34, 27, 36, 29, 11, 23, 13, 17, 15, 19, 9, 21,
+	 22, 2, 16, 4, 18, 6, 20, 0, 14, 7, 8, 1, 10, 3, 12, 5},
+	{36, 40, 32, 44, 34, 46, 38, 42, 43, 29, 47, 25, 45, 27, 41, 31,
+	 33, 24, 37, 28, 39, 30, 35, 26, 12, 16, 8, 20, 10, 22, 14, 18,
+	 19, 5, 23, 1, 21, 3, 17, 7, 9, 0, 13, 4, 15, 6, 11, 2},
+	{37, 41, 35, 47, 33, 45, 39, 43, 40, 28, 46, 26, 44, 24, 42, 30,
+	 32, 25, 38, 31, 36, 29, 34, 27, 13, 17, 11, 23, 9, 21, 15, 19,
+	 16, 4, 22, 2, 20, 0, 18, 6, 8, 1, 14, 7, 12, 5, 10, 3},
+	{38, 42, 34, 46, 32, 44, 36, 40, 41, 31, 45, 27, 47, 25, 43, 29,
+	 35, 26, 39, 30, 37, 28, 33, 24, 14, 18, 10, 22, 8, 20, 12, 16,
+	 17, 7, 21, 3, 23, 1, 19, 5, 11, 2, 15, 6, 13, 4, 9, 0},
+	{39, 43, 33, 45, 35, 47, 37, 41, 42, 30, 44, 24, 46, 26, 40, 28,
+	 34, 27, 36, 29, 38, 31, 32, 25, 15, 19, 9, 21, 11, 23, 13, 17,
+	 18, 6, 20, 0, 22, 2, 16, 4, 10, 3, 12, 5, 14, 7, 8, 1},
+	{40, 32, 44, 36, 42, 34, 46, 38, 25, 43, 29, 47, 27, 41, 31, 45,
+	 24, 37, 28, 33, 26, 39, 30, 35, 16, 8, 20, 12, 18, 10, 22, 14,
+	 1, 19, 5, 23, 3, 17, 7, 21, 0, 13, 4, 9, 2, 15, 6, 11},
+	{41, 35, 47, 37, 43, 33, 45, 39, 26, 40, 28, 46, 24, 42, 30, 44,
+	 25, 38, 31, 32, 27, 36, 29, 34, 17, 11, 23, 13, 19, 9, 21, 15,
+	 2, 16, 4, 22, 0, 18, 6, 20, 1, 14, 7, 8, 3, 12, 5, 10},
+	{42, 34, 46, 38, 40, 32, 44, 36, 27, 41, 31, 45, 25, 43, 29, 47,
+	 26, 39, 30, 35, 24, 37, 28, 33, 18, 10, 22, 14, 16, 8, 20, 12,
+	 3, 17, 7, 21, 1, 19, 5, 23, 2, 15, 6, 11, 0, 13, 4, 9},
+	{43, 33, 45, 39, 41, 35, 47, 37, 24, 42, 30, 44, 26, 40, 28, 46,
+	 27, 36, 29, 34, 25, 38, 31, 32, 19, 9, 21, 15, 17, 11, 23, 13,
+	 0, 18, 6, 20, 2, 16, 4, 22, 3, 12, 5, 10, 1, 14, 7, 8},
+	{44, 36, 40, 32, 46, 38, 42, 34, 29, 47, 25, 43, 31, 45, 27, 41,
+	 28, 33, 24, 37, 30, 35, 26, 39, 20, 12, 16, 8, 22, 14, 18, 10,
+	 5, 23, 1, 19, 7, 21, 3, 17, 4, 9, 0, 13, 6, 11, 2, 15},
+	{45, 39, 43, 33, 47, 37, 41, 35, 30, 44, 24, 42, 28, 46, 26, 40,
+	 29, 34, 27, 36, 31, 32, 25, 38, 21, 15, 19, 9, 23, 13, 17, 11,
+	 6, 20, 0, 18, 4, 22, 2, 16, 5, 10, 3, 12, 7, 8, 1, 14},
+	{46, 38, 42, 34, 44, 36, 40, 32, 31, 45, 27, 41, 29, 47, 25, 43,
+	 30, 35, 26, 39, 28, 33, 24, 37, 22, 14, 18, 10, 20, 12, 16, 8,
+	 7, 21, 3, 17, 5, 23, 1, 19, 6, 11, 2, 15, 4, 9, 0, 13},
+	{47, 37, 41, 35, 45, 39, 43, 33, 28, 46, 26, 40, 30, 44, 24, 42,
+	 31, 32, 25, 38, 29, 34, 27, 36, 23, 13, 17, 11, 21, 15, 19, 9,
+	 4, 22, 2, 16, 6, 20, 0, 18, 7, 8, 1, 14, 5, 10, 3, 12},
+};
+
+/*
+Moves transformed by a transformation: applying the move m to a cube and
+then transforming it by t is the same as transforming it by t and then
+applying the move transform_move_table[t][m].
+*/
+static uint8_t transform_move_table[48][18] = {
+	{0, 1, 2, 3, 4, 5, 6, 7, 8,
+	 9, 10, 11, 12, 13, 14, 15, 16, 17},
+	{0, 1, 2, 3, 4, 5, 12, 13, 14,
+	 15, 16, 17, 9, 10, 11, 6, 7, 8},
+	{0, 1, 2, 3, 4, 5, 9, 10, 11,
+	 6, 7, 8, 15, 16, 17, 12, 13, 14},
+	{0, 1, 2, 3, 4, 5, 15, 16, 17,
+	 12, 13, 14, 6, 7, 8, 9, 10, 11},
+	{3, 4, 5, 0, 1, 2, 9, 10, 11,
+	 6, 7, 8, 12, 13, 14, 15, 16, 17},
+	{3, 4, 5, 0, 1, 2, 15, 16, 17,
+	 12, 13, 14, 9, 10, 11, 6, 7, 8},
+	{3, 4, 5, 0, 1, 2, 6, 7, 8,
+	 9, 10, 11, 15, 16, 17, 12, 13, 14},
+	{3, 4, 5, 0, 1, 2, 12, 13, 14,
+	 15, 16, 17, 6, 7, 8, 9, 10, 11},
+	{6, 7, 8, 9, 10, 11, 12, 13, 14,
+	 15, 16, 17, 0, 1, 2, 3, 4, 5},
+	{6, 7, 8, 9, 10, 11, 3, 4, 5,
+	 0, 1, 2, 12, 13, 14, 15, 16, 17},
+	{6, 7, 8, 9, 10, 11, 15, 16, 17,
+	 12, 13, 14, 3, 4, 5, 0, 1, 2},
+	{6, 7, 8, 9, 10, 11, 0, 1, 2,
+	 3, 4, 5, 15, 16, 17, 12, 13, 14},
+	{9, 10, 11, 6, 7, 8, 15, 16, 17,
+	 12, 13, 14, 0, 1, 2, 3, 4, 5},
+	{9, 10, 11, 6, 7, 8, 0, 1, 2,
+	 3, 4, 5, 12, 13, 14, 15, 16, 17},
+	{9, 10, 11, 6, 7, 8, 12, 13, 14,
+	 15, 16, 17, 3, 4, 5, 0, 1, 2},
+	{9, 10, 11, 6, 7, 8, 3, 4, 5,
+	 0, 1, 2, 15, 16, 17, 12, 13, 14},
+	{12, 13, 14, 15, 16, 17, 9, 10, 11,
+	 6, 7, 8, 0, 1, 2, 3, 4, 5},
+	{12, 13, 14, 15, 16, 17, 0, 1, 2,
+	 3, 4, 5, 6, 7, 8, 9, 10, 11},
+	{12, 13, 14, 15, 16, 17, 6, 7, 8,
+	 9, 10, 11, 3, 4, 5, 0, 1, 2},
+	{12, 13, 14, 15, 16, 17, 3, 4, 5,
+	 0, 1, 2, 9, 10, 11, 6, 7, 8},
+	{15, 16, 17, 12, 13, 14, 6, 7, 8,
+	 9, 10, 11, 0, 1, 2, 3, 4, 5},
+	{15, 16, 17, 12, 13, 14, 3, 4, 5,
+	 0, 1, 2, 6, 7, 8, 9, 10, 11},
+	{15, 16, 17, 12, 13, 14, 9, 10, 11,
+	 6, 7, 8, 3, 4, 5, 0, 1, 2},
+	{15, 16, 17, 12, 13, 14, 0, 1, 2,
+	 3, 4, 5, 9, 10, 11, 6, 7, 8},
+	{2, 1, 0, 5, 4, 3, 11, 10, 9,
+	 8, 7, 6, 14, 13, 12, 17, 16, 15},
+	{2, 1, 0, 5, 4, 3, 14, 13, 12,
+	 17, 16, 15, 8, 7, 6, 11, 10, 9},
+	{2, 1, 0, 5, 4, 3, 8, 7, 6,
+	 11, 10, 9, 17, 16, 15, 14, 13, 12},
+	{2, 1, 0, 5, 4, 3, 17, 16, 15,
+	 14, 13, 12, 11, 10, 9, 8, 7, 6},
+	{5, 4, 3, 2, 1, 0, 8, 7, 6,
+	 11, 10, 9, 14, 13, 12, 17, 16, 15},
+	{5, 4, 3, 2, 1, 0, 17, 16, 15,
+	 14, 13, 12, 8, 7, 6, 11, 10, 9},
+	{5, 4, 3, 2, 1, 0, 11, 10, 9,
+	 8, 7, 6, 17, 16, 15, 14, 13, 12},
+	{5, 4, 3, 2, 1, 0, 14, 13, 12,
+	 17, 16, 15, 11, 10, 9, 8, 7, 6},
+	{11, 10, 9, 8, 7, 6, 14, 13, 12,
+	 17, 16, 15, 2, 1, 0, 5, 4, 3},
+	{11, 10, 9, 8, 7, 6, 5, 4, 3,
+	 2, 1, 0, 14, 13, 12, 17, 16, 15},
+	{11, 10, 9, 8, 7, 6, 17, 16, 15,
+	 14, 13, 12, 5, 4, 3, 2, 1, 0},
+	{11, 10, 9, 8, 7, 6, 2, 1, 0,
+	 5, 4, 3, 17, 16, 15, 14, 13, 12},
+	{8, 7, 6, 11, 10, 9, 17, 16, 15,
+	 14, 13, 12, 2, 1, 0, 5, 4, 3},
+	{8, 7, 6, 11, 10, 9, 2, 1, 0,
+	 5, 4, 3, 14, 13, 12, 17, 16, 15},
+	{8, 7, 6, 11, 10, 9, 14, 13, 12,
+	 17, 16, 15, 5, 4, 3, 2, 1, 0},
+	{8, 7, 6, 11, 10, 9, 5, 4, 3,
+	 2, 1, 0, 17, 16, 15, 14, 13, 12},
+	{14, 13, 12, 17, 16, 15, 8, 7, 6,
+	 11, 10, 9, 2, 1, 0, 5, 4, 3},
+	{14, 13, 12, 17, 16, 15, 2, 1, 0,
+	 5, 4, 3, 11, 10, 9, 8, 7, 6},
+	{14, 13, 12, 17, 16, 15, 11, 10, 9,
+	 8, 7, 6, 5, 4, 3, 2, 1, 0},
+	{14, 13, 12, 17, 16, 15, 5, 4, 3,
+	 2, 1, 0, 8, 7, 6, 11, 10, 9},
+	{17, 16, 15, 14, 13, 12, 11, 10, 9,
+	 8, 7, 6, 2, 1, 0, 5, 4, 3},
+	{17, 16, 15, 14, 13, 12, 5, 4, 3,
+	 2, 1, 0, 11, 10, 9, 8, 7, 6},
+	{17, 16, 15, 14, 13, 12, 8, 7, 6,
+	 11, 10, 9, 5, 4, 3, 2, 1, 0},
+	{17, 16, 15, 14, 13, 12, 2, 1, 0,
+	 5, 4, 3, 8, 7, 6, 11, 10, 9},
+};
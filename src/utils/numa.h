@@ -0,0 +1,313 @@
+/*
+Placement of the solver data on machines with more than one NUMA node, see
+nissy_setnuma(). The data is given by the caller, so it is usually on the
+node of the thread that read or generated it. With NISSY_NUMA_INTERLEAVE
+its pages are spread over all the nodes, and with NISSY_NUMA_REPLICATE a
+copy is made on each node and every solver thread is pinned to the CPUs
+of one node and uses the local copy.
+
+Only Linux is supported: the nodes and their CPUs are read from sysfs and
+the mbind(2) and sched_setaffinity(2) system calls are used directly, so
+that no external library is needed. On other systems, on machines with a
+single node, or if any of these steps fails, the data is used as it is.
+*/
+
+#define NUMA_MAXNODES 64
+#define NUMA_MAXCPUS  1024
+#define NUMA_ULONGBIT (sizeof(unsigned long) * CHAR_BIT)
+
+/*
+The copies of the data are kept in sets, one for each buffer, size and
+mode. The solves that use a set hold a reference to it, and a set is freed
+only when no solve is using it, so that a solve with a different buffer or
+a call to nissy_setnuma() does not free the copies used by another solve.
+*/
+#define NUMA_MAXSETS  8
+
+typedef struct {
+	const void *data;
+	uint64_t size;
+	unsigned mode;
+	unsigned users;
+	bool stale;
+	int nodes;
+	int node[NUMA_MAXNODES];
+	void *replica[NUMA_MAXNODES];
+} numa_set_t;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	numa_set_t set[NUMA_MAXSETS];
+} numa_state_t;
+
+STATIC _Atomic unsigned nissy_numa = NISSY_NUMA_DEFAULT;
+STATIC numa_state_t numa_state = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+STATIC int numa_prepare(uint64_t, const void *, int *,
+    int [static NUMA_MAXNODES], const void *[static NUMA_MAXNODES]);
+STATIC void numa_release(int);
+STATIC void numa_invalidate(void);
+STATIC void numa_reset(numa_set_t *);
+STATIC bool numa_pin(int);
+
+#if defined(__linux__)
+
+/* Declared here because it is hidden by glibc in strict C11 mode */
+long syscall(long, ...);
+
+STATIC int numa_readlist(const char *, unsigned long *, int);
+STATIC bool numa_mbind(const void *, uint64_t, int, const unsigned long *);
+
+/*
+Read a list in the format used by sysfs, for example "0-3,8,10-11", and
+set the corresponding bits in mask. Returns the number of bits set, or -1
+in case of error.
+*/
+STATIC int
+numa_readlist(const char *path, unsigned long *mask, int maxbits)
+{
+	int n, a, b, i;
+	char line[1024], *p, *q;
+	FILE *f;
+
+	if ((f = fopen(path, "r")) == NULL)
+		return -1;
+	p = fgets(line, sizeof(line), f);
+	fclose(f);
+	if (p == NULL)
+		return -1;
+
+	memset(mask, 0, DIV_ROUND_UP(maxbits, NUMA_ULONGBIT) *
+	    sizeof(unsigned long));
+	for (n = 0; *p >= '0' && *p <= '9'; p = *q == ',' ? q+1 : q) {
+		a = b = strtol(p, &q, 10);
+		if (*q == '-')
+			b = strtol(q+1, &q, 10);
+		if (a < 0 || b >= maxbits || a > b)
+			return -1;
+		for (i = a; i <= b; i++, n++)
+			mask[i / NUMA_ULONGBIT] |= 1UL << (i % NUMA_ULONGBIT);
+	}
+
+	return n;
+}
+
+/*
+Apply the memory policy mode with the given mask of nodes to the pages
+that are fully contained in the given memory range, moving the pages that
+are already allocated.
+*/
+STATIC bool
+numa_mbind(const void *p, uint64_t size, int mode, const unsigned long *mask)
+{
+	uintptr_t page, start, end;
+
+	page = (uintptr_t)sysconf(_SC_PAGESIZE);
+	start = ((uintptr_t)p + page - 1) & ~(page - 1);
+	end = ((uintptr_t)p + size) & ~(page - 1);
+	if (end <= start)
+		return true;
+
+	return syscall(SYS_mbind, (void *)start, end - start, mode, mask,
+	    NUMA_MAXNODES + 1, MPOL_MF_MOVE) == 0;
+}
+
+/*
+Pin the calling thread to the CPUs of the given node. The pinning is not
+undone at the end of the solve, but the threads are not reused.
+*/
+STATIC bool
+numa_pin(int node)
+{
+	char path[64];
+	unsigned long mask[NUMA_MAXCPUS / NUMA_ULONGBIT];
+
+	sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+	if (numa_readlist(path, mask, NUMA_MAXCPUS) <= 0)
+		return false;
+
+	return syscall(SYS_sched_setaffinity, 0, sizeof(mask), mask) == 0;
+}
+
+/*
+Prepare the data for the current NUMA mode. For each node on which the
+solver threads should be distributed, its number and the address of the
+copy of the data to be used there are written in node and replica, and
+the number of such nodes is returned. If the threads should not be
+pinned, 0 is returned.
+
+The copies are made the first time a buffer is used, and a reference to
+them is taken: the index of their set is written in set, and it must be
+given to numa_release() when the solve is done. If no set is used, -1 is
+written. When a different buffer is given, the sets that are not in use
+are freed. If all the sets are in use, or if the copies can not be made,
+the data is used as it is.
+*/
+STATIC int
+numa_prepare(
+	uint64_t size,
+	const void *data,
+	int *set,
+	int node[static NUMA_MAXNODES],
+	const void *replica[static NUMA_MAXNODES]
+)
+{
+	int i, n;
+	unsigned mode;
+	uintptr_t page;
+	numa_set_t *st;
+	unsigned long nodes[DIV_ROUND_UP(NUMA_MAXNODES, NUMA_ULONGBIT)];
+	unsigned long mask[DIV_ROUND_UP(NUMA_MAXNODES, NUMA_ULONGBIT)];
+
+	*set = -1;
+	mode = atomic_load(&nissy_numa);
+	if (mode == NISSY_NUMA_DEFAULT)
+		return 0;
+
+	pthread_mutex_lock(&numa_state.mutex);
+	for (i = 0; i < NUMA_MAXSETS; i++) {
+		st = &numa_state.set[i];
+		if (st->data == data && st->size == size &&
+		    st->mode == mode && !st->stale)
+			goto numa_prepare_done;
+	}
+
+	for (i = 0; i < NUMA_MAXSETS; i++)
+		if (numa_state.set[i].users == 0)
+			numa_reset(&numa_state.set[i]);
+	for (i = 0; i < NUMA_MAXSETS; i++)
+		if (numa_state.set[i].data == NULL)
+			break;
+	if (i == NUMA_MAXSETS) {
+		LOG("numa: too many buffers in use, using the data as it is\n");
+		pthread_mutex_unlock(&numa_state.mutex);
+		return 0;
+	}
+	st = &numa_state.set[i];
+	st->data = data;
+	st->size = size;
+	st->mode = mode;
+
+	n = numa_readlist("/sys/devices/system/node/online",
+	    nodes, NUMA_MAXNODES);
+	if (n <= 1)
+		goto numa_prepare_done;
+	for (n = 0; n < NUMA_MAXNODES; n++)
+		if (nodes[n / NUMA_ULONGBIT] & (1UL << (n % NUMA_ULONGBIT)))
+			st->node[st->nodes++] = n;
+
+	if (mode == NISSY_NUMA_INTERLEAVE) {
+		if (!numa_mbind(data, size, MPOL_INTERLEAVE, nodes))
+			LOG("numa: could not interleave the data\n");
+		st->nodes = 0; /* The threads are not pinned */
+		goto numa_prepare_done;
+	}
+
+	page = (uintptr_t)sysconf(_SC_PAGESIZE);
+	for (n = 0; n < st->nodes; n++) {
+		memset(mask, 0, sizeof(mask));
+		mask[st->node[n] / NUMA_ULONGBIT] |=
+		    1UL << (st->node[n] % NUMA_ULONGBIT);
+		st->replica[n] =
+		    aligned_alloc(page, DIV_ROUND_UP(size, page) * page);
+		if (st->replica[n] == NULL ||
+		    !numa_mbind(st->replica[n], size, MPOL_BIND, mask)) {
+			LOG("numa: could not allocate the data on node %d\n",
+			    st->node[n]);
+			numa_reset(st);
+			st->data = data;
+			st->size = size;
+			st->mode = mode;
+			goto numa_prepare_done;
+		}
+		/* The pages are allocated on the node when first touched */
+		memcpy(st->replica[n], data, size);
+	}
+	LOG("numa: data replicated on %d nodes\n", st->nodes);
+
+numa_prepare_done:
+	st->users++;
+	*set = i;
+	for (n = 0; n < st->nodes; n++) {
+		node[n] = st->node[n];
+		replica[n] = st->replica[n];
+	}
+	n = st->nodes;
+	pthread_mutex_unlock(&numa_state.mutex);
+
+	return n;
+}
+
+#else
+
+STATIC bool
+numa_pin(int node)
+{
+	return false;
+}
+
+STATIC int
+numa_prepare(
+	uint64_t size,
+	const void *data,
+	int *set,
+	int node[static NUMA_MAXNODES],
+	const void *replica[static NUMA_MAXNODES]
+)
+{
+	*set = -1;
+	return 0;
+}
+
+#endif
+
+/* Release the reference to a set taken by numa_prepare() */
+STATIC void
+numa_release(int set)
+{
+	numa_set_t *st;
+
+	if (set < 0)
+		return;
+
+	pthread_mutex_lock(&numa_state.mutex);
+	st = &numa_state.set[set];
+	if (--st->users == 0 && st->stale)
+		numa_reset(st);
+	pthread_mutex_unlock(&numa_state.mutex);
+}
+
+/*
+Free the sets that are not in use, and mark the others so that they are
+not used again and are freed by numa_release(). Must be called with
+numa_state.mutex locked.
+*/
+STATIC void
+numa_invalidate(void)
+{
+	int i;
+
+	for (i = 0; i < NUMA_MAXSETS; i++) {
+		if (numa_state.set[i].users == 0)
+			numa_reset(&numa_state.set[i]);
+		else
+			numa_state.set[i].stale = true;
+	}
+}
+
+/* Free the replicas of a set, must be called with numa_state.mutex locked */
+STATIC void
+numa_reset(numa_set_t *st)
+{
+	int i;
+
+	for (i = 0; i < st->nodes; i++) {
+		free(st->replica[i]);
+		st->replica[i] = NULL;
+	}
+	st->nodes = 0;
+	st->data = NULL;
+	st->size = 0;
+	st->mode = NISSY_NUMA_DEFAULT;
+	st->stale = false;
+}
@@ -0,0 +1,149 @@
+/*
+Memory for the solver data, see nissy_allocdata() and nissy_warmup(). The
+pruning tables are read at random positions, so with pages of 4KiB almost
+every lookup misses the TLB. On Linux the buffers are mapped with explicit
+huge pages (MAP_HUGETLB) when enough of them are reserved, and otherwise
+they are aligned to 2MiB and marked with madvise(MADV_HUGEPAGE), so that
+the kernel can back them with transparent huge pages. On other systems
+they are allocated with malloc().
+
+The pages are faulted in by several threads, so that the cost of the first
+access, which for a huge page includes clearing 2MiB of memory, is not
+paid by a single thread.
+*/
+
+#define PAGES_HUGESIZE  (UINT64_C(1) << 21)
+#define PAGES_SMALLSIZE (UINT64_C(1) << 12)
+
+typedef struct {
+	volatile char *data;
+	uint64_t size;
+	bool write;
+	uint64_t sum;
+} pages_touch_arg_t;
+
+STATIC long long pages_alloc(uint64_t, char **);
+STATIC void pages_free(uint64_t, char *);
+STATIC void pages_touch(uint64_t, const char *, bool);
+STATIC void *pages_touch_runthread(void *);
+
+#if defined(__linux__)
+
+/* Declared here because it is hidden by glibc in strict C11 mode */
+int madvise(void *, size_t, int);
+
+/*
+Returns the kind of pages used for the buffer, or NISSY_ERROR_UNKNOWN if
+the memory could not be allocated.
+*/
+STATIC long long
+pages_alloc(uint64_t size, char **data)
+{
+	uint64_t s, skip;
+	char *p;
+
+	s = DIV_ROUND_UP(size, PAGES_HUGESIZE) * PAGES_HUGESIZE;
+
+#if defined(MAP_HUGE_2MB)
+	p = mmap(NULL, s, PROT_READ | PROT_WRITE,
+	    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+	if (p != MAP_FAILED) {
+		*data = p;
+		return NISSY_HUGEPAGES_EXPLICIT;
+	}
+#endif
+
+	/* Map one huge page more, then cut the parts that are not aligned */
+	p = mmap(NULL, s + PAGES_HUGESIZE, PROT_READ | PROT_WRITE,
+	    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED) {
+		LOG("allocdata: could not map %" PRIu64 " bytes\n", size);
+		return NISSY_ERROR_UNKNOWN;
+	}
+	skip = (PAGES_HUGESIZE - (uintptr_t)p % PAGES_HUGESIZE) %
+	    PAGES_HUGESIZE;
+	if (skip > 0)
+		munmap(p, skip);
+	if (skip < PAGES_HUGESIZE)
+		munmap(p + skip + s, PAGES_HUGESIZE - skip);
+	*data = p + skip;
+
+	return madvise(*data, s, MADV_HUGEPAGE) == 0 ?
+	    NISSY_HUGEPAGES_TRANSPARENT : NISSY_HUGEPAGES_NONE;
+}
+
+STATIC void
+pages_free(uint64_t size, char *data)
+{
+	munmap(data, DIV_ROUND_UP(size, PAGES_HUGESIZE) * PAGES_HUGESIZE);
+}
+
+#else
+
+STATIC long long
+pages_alloc(uint64_t size, char **data)
+{
+	if ((*data = malloc(size)) == NULL) {
+		LOG("allocdata: could not allocate %" PRIu64 " bytes\n", size);
+		return NISSY_ERROR_UNKNOWN;
+	}
+
+	return NISSY_HUGEPAGES_NONE;
+}
+
+STATIC void
+pages_free(uint64_t size, char *data)
+{
+	free(data);
+}
+
+#endif
+
+/*
+Access one byte of each page of the buffer, using all the threads. If
+write is true, each byte is written back, so that the pages are really
+allocated, as reading a page that was never written may just map the
+shared zero page. Otherwise the content is only read, so that this can
+be done on a buffer that is in use.
+*/
+STATIC void
+pages_touch(uint64_t size, const char *data, bool write)
+{
+	uint64_t i, n, nthreads;
+	pthread_t thread[THREADS];
+	pages_touch_arg_t arg[THREADS];
+
+	nthreads = atomic_load(&nissy_threads);
+	n = DIV_ROUND_UP(DIV_ROUND_UP(size, PAGES_SMALLSIZE), nthreads) *
+	    PAGES_SMALLSIZE;
+	for (i = 0; i < nthreads; i++) {
+		arg[i] = (pages_touch_arg_t) {
+			.data = (volatile char *)data + MIN(i * n, size),
+			.size = MIN(n, size - MIN(i * n, size)),
+			.write = write,
+			.sum = 0,
+		};
+		pthread_create(
+		    &thread[i], NULL, pages_touch_runthread, &arg[i]);
+	}
+
+	for (i = 0; i < nthreads; i++)
+		pthread_join(thread[i], NULL);
+}
+
+STATIC void *
+pages_touch_runthread(void *arg)
+{
+	uint64_t i;
+	pages_touch_arg_t *a;
+
+	a = (pages_touch_arg_t *)arg;
+	for (i = 0; i < a->size; i += PAGES_SMALLSIZE) {
+		if (a->write)
+			a->data[i] = a->data[i];
+		else
+			a->sum += a->data[i];
+	}
+
+	return NULL;
+}
@@ -0,0 +1,13 @@
+/*
+Number of threads used by multi-threaded operations. It can be changed at
+runtime with nissy_setthreads(), but it is never larger than THREADS, the
+value chosen at build time.
+*/
+STATIC _Atomic unsigned nissy_threads = THREADS;
+
+/*
+Number of searches that each solver thread runs at the same time, see
+nissy_setinterleave(). It is never larger than INTERLEAVE_MAX.
+*/
+#define INTERLEAVE_MAX 8
+STATIC _Atomic unsigned nissy_interleave = 1;
@@ -1,3 +1,6 @@
 #include "dbg_log.h"
+#include "threads.h"
 #include "constants.h"
 #include "math.h"
+#include "numa.h"
+#include "pages.h"
@@ -0,0 +1,34 @@
+#include "../test.h"
+
+cube_t move(cube_t, uint8_t);
+cube_t premove(cube_t, uint8_t);
+void expand_moves(cube_t, uint32_t, cube_t [static 18]);
+void expand_premoves(cube_t, uint32_t, cube_t [static 18]);
+bool equal(cube_t, cube_t);
+extern char *movestr[];
+
+void run(void) {
+	uint8_t m, i;
+	uint32_t allowed, masks[] = { UINT32_C(0x3FFFF), UINT32_C(0x2DB6D) };
+	char str[STRLENMAX];
+	cube_t cube, moved[18], premoved[18];
+
+	fgets(str, STRLENMAX, stdin);
+	cube = readcube("H48", str);
+
+	for (i = 0; i < 2; i++) {
+		allowed = masks[i];
+		expand_moves(cube, allowed, moved);
+		expand_premoves(cube, allowed, premoved);
+
+		for (m = 0; m < 18; m++) {
+			if (!(allowed & (UINT32_C(1) << m)))
+				continue;
+			if (!equal(moved[m], move(cube, m)))
+				printf("%s: Error! Wrong move\n", movestr[m]);
+			if (!equal(premoved[m], premove(cube, m)))
+				printf("%s: Error! Wrong premove\n",
+				    movestr[m]);
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#include "../test.h"
+
+uint8_t compose_trans(uint8_t, uint8_t);
+cube_t applymoves(cube_t, char *);
+cube_t transform(cube_t, uint8_t);
+bool equal(cube_t, cube_t);
+extern char *transstr[];
+
+void run(void) {
+	uint8_t t1, t2, t;
+	char str[STRLENMAX];
+	cube_t cube, c, d;
+
+	fgets(str, STRLENMAX, stdin);
+	cube = readcube("H48", str);
+
+	for (t1 = 0; t1 < 48; t1++) {
+		for (t2 = 0; t2 < 48; t2++) {
+			c = transform(transform(cube, t1), t2);
+			t = compose_trans(t1, t2);
+			d = transform(cube, t);
+			if (!equal(c, d))
+				printf("%s, %s: Error! Got %s\n",
+				    transstr[t1], transstr[t2], transstr[t]);
+		}
+	}
+}
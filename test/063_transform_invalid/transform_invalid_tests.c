@@ -0,0 +1,20 @@
+#include "../test.h"
+
+cube_t transform(cube_t, uint8_t);
+cube_t transform_edges(cube_t, uint8_t);
+cube_t transform_corners(cube_t, uint8_t);
+
+void run(void) {
+	char str[STRLENMAX];
+	uint8_t t;
+
+	fgets(str, STRLENMAX, stdin);
+	t = atoi(str);
+
+	printf("transform: %s\n",
+	    iserror(transform(solvedcube(), t)) ? "error" : "ok");
+	printf("transform_edges: %s\n",
+	    iserror(transform_edges(solvedcube(), t)) ? "error" : "ok");
+	printf("transform_corners: %s\n",
+	    iserror(transform_corners(solvedcube(), t)) ? "error" : "ok");
+}
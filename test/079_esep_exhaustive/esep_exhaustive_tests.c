@@ -0,0 +1,78 @@
+#include "../test.h"
+
+int64_t coord_esep(cube_t);
+cube_t invcoord_esep(int64_t);
+void pieces(cube_t *, uint8_t [static 8], uint8_t [static 12]);
+
+/* Reference implementation, based on the definition of the coordinate */
+
+int64_t binomial(int64_t n, int64_t k) {
+	int64_t i, ret;
+
+	if (k < 0 || k > n)
+		return 0;
+
+	for (i = 0, ret = 1; i < k; i++)
+		ret = ret * (n - i) / (i + 1);
+
+	return ret;
+}
+
+int64_t coord_esep_ref(uint8_t edge[static 12]) {
+	int64_t i, j, k, l, ret1, ret2;
+
+	for (i = 0, j = 0, k = 4, l = 4, ret1 = 0, ret2 = 0; i < 12; i++) {
+		if (edge[i] & 8) {
+			ret1 += binomial(11-i, k--);
+		} else {
+			if (edge[i] & 4)
+				ret2 += binomial(7-j, l--);
+			j++;
+		}
+	}
+
+	return ret1 * 70 + ret2;
+}
+
+void run(void) {
+	char str[STRLENMAX];
+	uint8_t c[8], e[12], slice[3];
+	int64_t i, j, s;
+	cube_t cube;
+	bool ok;
+
+	/* The input is not used */
+	fgets(str, STRLENMAX, stdin);
+
+	for (i = 0, ok = true; i < 34650; i++) {
+		cube = invcoord_esep(i);
+		if (coord_esep(cube) != i) {
+			printf("Error: coord_esep(invcoord_esep(%" PRId64
+			    ")) = %" PRId64 "\n", i, coord_esep(cube));
+			ok = false;
+		}
+
+		pieces(&cube, c, e);
+		if (coord_esep_ref(e) != i) {
+			printf("Error: invcoord_esep(%" PRId64 ") has "
+			    "reference coordinate %" PRId64 "\n",
+			    i, coord_esep_ref(e));
+			ok = false;
+		}
+
+		/* Edges in the same slice must be in increasing order */
+		slice[0] = 0; slice[1] = 4; slice[2] = 8;
+		for (j = 0; j < 12; j++) {
+			s = e[j] >> 2;
+			if (s > 2 || e[j] != slice[s]++) {
+				printf("Error: invcoord_esep(%" PRId64 ") has "
+				    "edge %" PRIu8 " in position %" PRId64
+				    "\n", i, e[j], j);
+				ok = false;
+			}
+		}
+	}
+
+	if (ok)
+		printf("All 34650 values checked\n");
+}
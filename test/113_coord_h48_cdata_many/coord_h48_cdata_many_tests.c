@@ -0,0 +1,45 @@
+#include "../test.h"
+
+size_t gendata_cocsep(void *, uint64_t *, cube_t *);
+cube_t move(cube_t, uint8_t);
+int64_t coord_cocsep(cube_t);
+void coord_h48_cdata_many(
+    const cube_t *, uint32_t, const uint32_t *, uint32_t *);
+
+void run(void) {
+	char str[STRLENMAX];
+	int i;
+	bool ok;
+	uint8_t m;
+	uint32_t mask, data[18];
+	char buf[2000000];
+	uint32_t *cocsepdata;
+	uint64_t selfsim[COCSEP_CLASSES];
+	cube_t cube, cubes[18], rep[COCSEP_CLASSES];
+
+	gendata_cocsep(buf, selfsim, rep);
+	cocsepdata = (uint32_t *)((char *)buf + INFOSIZE);
+
+	i = 1;
+	mask = UINT32_C(0x2DB6D);
+	while (fgets(str, STRLENMAX, stdin) != NULL) {
+		cube = readcube("H48", str);
+		for (m = 0; m < 18; m++)
+			cubes[m] = move(cube, m);
+
+		for (m = 0; m < 18; m++)
+			data[m] = UINT32_MAX;
+
+		coord_h48_cdata_many(cubes, mask, cocsepdata, data);
+
+		for (m = 0, ok = true; m < 18; m++) {
+			if (mask & (UINT32_C(1) << m))
+				ok = ok && data[m] ==
+				    cocsepdata[coord_cocsep(cubes[m])];
+			else
+				ok = ok && data[m] == UINT32_MAX;
+		}
+		printf("%d %s\n", i, ok ? "ok" : "ERROR");
+		i++;
+	}
+}
@@ -0,0 +1,46 @@
+#include "../test.h"
+
+size_t gendata_cocsep(void *, uint64_t *, cube_t *);
+int64_t coord_cocsep(cube_t);
+int64_t coord_h48corners(cube_t, int64_t, uint8_t);
+cube_t invcoord_h48corners(int64_t, const cube_t *);
+cube_t transform(cube_t, uint8_t);
+
+static int64_t
+coord(cube_t cube, const uint32_t *cocsepdata)
+{
+	uint32_t data;
+
+	data = cocsepdata[coord_cocsep(cube)];
+
+	return coord_h48corners(cube, COCLASS(data), TTREP(data));
+}
+
+void run(void) {
+	char str[STRLENMAX];
+	int i;
+	bool found;
+	uint8_t t;
+	char buf[2000000];
+	uint32_t *cocsepdata;
+	uint64_t selfsim[COCSEP_CLASSES];
+	int64_t c, cc;
+	cube_t cube, invc, rep[COCSEP_CLASSES];
+
+	gendata_cocsep(buf, selfsim, rep);
+	cocsepdata = (uint32_t *)((char *)buf + INFOSIZE);
+
+	i = 1;
+	while (fgets(str, STRLENMAX, stdin) != NULL) {
+		cube = readcube("H48", str);
+		c = coord(cube, cocsepdata);
+		invc = invcoord_h48corners(c, rep);
+		for (t = 0, found = false; t < 48; t++) {
+			cube = transform(invc, t);
+			cc = coord(cube, cocsepdata);
+			found = found || cc == c;
+		}
+		printf("%d %s\n", i, found ? "ok" : "ERROR");
+		i++;
+	}
+}
@@ -0,0 +1,26 @@
+#include "../test.h"
+
+int64_t coord_h48eoesep(cube_t);
+cube_t invcoord_h48eoesep(int64_t);
+
+void run(void) {
+	char str[STRLENMAX];
+	int i;
+	bool ok;
+	int64_t c, j;
+	cube_t cube;
+
+	i = 1;
+	while (fgets(str, STRLENMAX, stdin) != NULL) {
+		cube = readcube("H48", str);
+		c = coord_h48eoesep(cube);
+		cube = invcoord_h48eoesep(c);
+		printf("%d %s\n", i, coord_h48eoesep(cube) == c ? "ok" : "ERROR");
+		i++;
+	}
+
+	/* Unlike the h48 coordinates, this coordinate is not up to symmetry */
+	for (j = 0, ok = true; j < (INT64_C(34650) << 11); j += 997)
+		ok = ok && coord_h48eoesep(invcoord_h48eoesep(j)) == j;
+	printf("all %s\n", ok ? "ok" : "ERROR");
+}
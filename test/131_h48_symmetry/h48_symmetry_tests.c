@@ -0,0 +1,35 @@
+#include "../test.h"
+
+typedef struct {
+	uint64_t trans;
+	uint64_t anti;
+} h48_symmetry_t;
+
+cube_t applymoves(cube_t, char *);
+bool solve_h48_symmetry(cube_t, h48_symmetry_t *);
+
+static int
+count(uint64_t mask)
+{
+	int n;
+
+	for (n = 0; mask != 0; mask >>= 1)
+		n += mask & 1;
+
+	return n;
+}
+
+void run(void) {
+	char movestr[STRLENMAX];
+	cube_t cube;
+	h48_symmetry_t sym;
+
+	fgets(movestr, STRLENMAX, stdin);
+	cube = applymoves(solvedcube(), movestr);
+
+	if (solve_h48_symmetry(cube, &sym))
+		printf("%d symmetries, %d antisymmetries\n",
+		    count(sym.trans), count(sym.anti));
+	else
+		printf("No symmetry\n");
+}
@@ -0,0 +1,120 @@
+#include "../test.h"
+
+/*
+The h48 table is left empty, so that only the corner bounds prune the
+search and the data can be generated quickly. A value of 0 is a valid
+lower bound with k = 4.
+*/
+
+#define SOL_BUFFER_LEN 100000
+#define MAXSOLS 1000
+
+cube_t applymoves(cube_t, char *);
+size_t gendata_cocsep(void *, uint64_t *, cube_t *);
+int64_t writetableinfo(const tableinfo_t *, uint64_t, char *);
+int64_t readtableinfo(uint64_t, const char *, tableinfo_t *);
+int64_t solve_h48(cube_t, int8_t, int8_t, int8_t, uint64_t, const void *,
+    uint64_t, char *, long long [static NISSY_SIZE_SOLVE_STATS]);
+int64_t solve_h48_multithread(cube_t, int8_t, int8_t, int8_t, uint64_t,
+    const void *, uint64_t, char *, long long [static NISSY_SIZE_SOLVE_STATS]);
+
+static int
+compare(const void *x, const void *y)
+{
+	return strcmp(*(char * const *)x, *(char * const *)y);
+}
+
+static int
+sortlines(char *sols, char *lines[static MAXSOLS])
+{
+	int n;
+	char *p;
+
+	for (n = 0, p = strtok(sols, "\n"); p != NULL && n < MAXSOLS;
+	    p = strtok(NULL, "\n"))
+		lines[n++] = p;
+	qsort(lines, n, sizeof(char *), compare);
+
+	return n;
+}
+
+static bool
+samelines(int n, char *a[static MAXSOLS], int m, char *b[static MAXSOLS])
+{
+	int i;
+
+	if (n != m)
+		return false;
+
+	for (i = 0; i < n; i++)
+		if (strcmp(a[i], b[i]))
+			return false;
+
+	return true;
+}
+
+void run(void) {
+	char movestr[STRLENMAX], *buf, *sols, *solsil;
+	char *lines[MAXSOLS], *linesil[MAXSOLS];
+	int i, n, nil;
+	int8_t minmoves, maxmoves;
+	int64_t r, ril;
+	uint64_t size, cocsepsize, selfsim[COCSEP_CLASSES];
+	long long stats[NISSY_SIZE_SOLVE_STATS];
+	unsigned threads[] = { 1, THREADS };
+	cube_t cube, crep[COCSEP_CLASSES];
+	tableinfo_t info;
+
+	fgets(movestr, STRLENMAX, stdin);
+	cube = applymoves(solvedcube(), movestr);
+	fgets(movestr, STRLENMAX, stdin);
+	minmoves = atoi(movestr);
+	fgets(movestr, STRLENMAX, stdin);
+	maxmoves = atoi(movestr);
+
+	size = nissy_datasize("h48h0k4");
+	buf = calloc(size, 1);
+	sols = malloc(SOL_BUFFER_LEN);
+	solsil = malloc(SOL_BUFFER_LEN);
+
+	cocsepsize = gendata_cocsep(buf, selfsim, crep);
+	readtableinfo(size, buf, &info);
+	info.next = cocsepsize;
+	writetableinfo(&info, size, buf);
+	info = (tableinfo_t) {
+		.solver = "h48 solver h = 0, k = 4",
+		.type = TABLETYPE_PRUNING,
+		.infosize = INFOSIZE,
+		.fullsize = size - cocsepsize,
+		.entries = 2 * (size - cocsepsize - INFOSIZE),
+		.classes = COCSEP_CLASSES,
+		.h48h = 0,
+		.bits = 4,
+		.base = 0,
+		.maxvalue = 0,
+		.next = 0,
+	};
+	writetableinfo(&info, size - cocsepsize, buf + cocsepsize);
+
+	r = solve_h48(cube, minmoves, maxmoves, 127, size, buf,
+	    SOL_BUFFER_LEN, sols, stats);
+	n = sortlines(sols, lines);
+	printf("%" PRId64 " solutions\n", r);
+	for (i = 0; i < n; i++)
+		printf("%s\n", lines[i]);
+
+	nissy_setinterleave(4);
+	for (i = 0; i < 2; i++) {
+		nissy_setthreads(threads[i]);
+		ril = solve_h48_multithread(cube, minmoves, maxmoves, 127,
+		    size, buf, SOL_BUFFER_LEN, solsil, stats);
+		nil = sortlines(solsil, linesil);
+		if (ril != r || !samelines(n, lines, nil, linesil))
+			printf("Different solutions with %u threads\n",
+			    threads[i]);
+	}
+
+	free(buf);
+	free(sols);
+	free(solsil);
+}
@@ -0,0 +1,107 @@
+#include "../test.h"
+
+/*
+Solutions shorter than the BFS of the multi-threaded solver, including the
+empty solution. The solutions buffer is allocated with the exact size, so
+that writing before it is detected by the address sanitizer. The h48 table
+is left empty, see test 132.
+*/
+
+#define SOL_BUFFER_LEN 10000
+#define MAXSOLS 100
+
+cube_t applymoves(cube_t, char *);
+size_t gendata_cocsep(void *, uint64_t *, cube_t *);
+int64_t writetableinfo(const tableinfo_t *, uint64_t, char *);
+int64_t readtableinfo(uint64_t, const char *, tableinfo_t *);
+int64_t solve_h48(cube_t, int8_t, int8_t, int8_t, uint64_t, const void *,
+    uint64_t, char *, long long [static NISSY_SIZE_SOLVE_STATS]);
+int64_t solve_h48_multithread(cube_t, int8_t, int8_t, int8_t, uint64_t,
+    const void *, uint64_t, char *, long long [static NISSY_SIZE_SOLVE_STATS]);
+
+static int
+compare(const void *x, const void *y)
+{
+	return strcmp(*(char * const *)x, *(char * const *)y);
+}
+
+/* Unlike strtok(), this keeps the empty lines */
+static void
+printsorted(const char *name, int64_t r, char *sols, long long stats[])
+{
+	int i, n;
+	char *p, *q, *lines[MAXSOLS];
+
+	if (memchr(sols, '\0', SOL_BUFFER_LEN) == NULL) {
+		printf("%s: solutions not terminated\n", name);
+		return;
+	}
+
+	for (n = 0, p = sols; *p != '\0' && n < MAXSOLS; p = q + 1) {
+		if ((q = strchr(p, '\n')) == NULL)
+			break;
+		*q = '\0';
+		lines[n++] = p;
+	}
+	qsort(lines, n, sizeof(char *), compare);
+
+	printf("%s: %" PRId64 " solutions%s\n", name, r,
+	    stats[0] < 0 ? ", stats not filled" : "");
+	for (i = 0; i < n; i++)
+		printf("\"%s\"\n", lines[i]);
+}
+
+void run(void) {
+	char movestr[STRLENMAX], *buf, *sols;
+	int8_t maxsolutions, maxmoves;
+	int64_t r;
+	uint64_t size, cocsepsize, selfsim[COCSEP_CLASSES];
+	long long stats[NISSY_SIZE_SOLVE_STATS];
+	cube_t cube, crep[COCSEP_CLASSES];
+	tableinfo_t info;
+
+	fgets(movestr, STRLENMAX, stdin);
+	cube = applymoves(solvedcube(), movestr);
+	fgets(movestr, STRLENMAX, stdin);
+	maxsolutions = atoi(movestr);
+	fgets(movestr, STRLENMAX, stdin);
+	maxmoves = atoi(movestr);
+
+	size = nissy_datasize("h48h0k4");
+	buf = calloc(size, 1);
+	sols = malloc(SOL_BUFFER_LEN);
+
+	cocsepsize = gendata_cocsep(buf, selfsim, crep);
+	readtableinfo(size, buf, &info);
+	info.next = cocsepsize;
+	writetableinfo(&info, size, buf);
+	info = (tableinfo_t) {
+		.solver = "h48 solver h = 0, k = 4",
+		.type = TABLETYPE_PRUNING,
+		.infosize = INFOSIZE,
+		.fullsize = size - cocsepsize,
+		.entries = 2 * (size - cocsepsize - INFOSIZE),
+		.classes = COCSEP_CLASSES,
+		.h48h = 0,
+		.bits = 4,
+		.base = 0,
+		.maxvalue = 0,
+		.next = 0,
+	};
+	writetableinfo(&info, size - cocsepsize, buf + cocsepsize);
+
+	memset(sols, 'x', SOL_BUFFER_LEN);
+	memset(stats, -1, sizeof(stats));
+	r = solve_h48(cube, 0, maxmoves, maxsolutions, size, buf,
+	    SOL_BUFFER_LEN, sols, stats);
+	printsorted("solve_h48", r, sols, stats);
+
+	memset(sols, 'x', SOL_BUFFER_LEN);
+	memset(stats, -1, sizeof(stats));
+	r = solve_h48_multithread(cube, 0, maxmoves, maxsolutions, size, buf,
+	    SOL_BUFFER_LEN, sols, stats);
+	printsorted("solve_h48_multithread", r, sols, stats);
+
+	free(buf);
+	free(sols);
+}
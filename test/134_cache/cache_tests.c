@@ -0,0 +1,182 @@
+#include "../test.h"
+
+/*
+Solve a cube and some of its rotations, mirrorings and inverses, first
+with the cache disabled and then with the cache enabled, and compare the
+solutions. Then check that the least recently used entries are removed
+first. The h48 table is left empty, see test 132.
+*/
+
+#define SOL_BUFFER_LEN 100000
+#define MAXSOLS 1000
+#define NTRANS 6
+#define SOLVER "h48h0k4"
+
+static const char *trans[NTRANS] = {
+	"rotation UF",
+	"rotation LB",
+	"rotation DR",
+	"mirrored UF",
+	"mirrored FD",
+	"mirrored RB",
+};
+
+size_t gendata_cocsep(void *, uint64_t *, cube_t *);
+int64_t writetableinfo(const tableinfo_t *, uint64_t, char *);
+int64_t readtableinfo(uint64_t, const char *, tableinfo_t *);
+
+static int
+compare(const void *x, const void *y)
+{
+	return strcmp(*(char * const *)x, *(char * const *)y);
+}
+
+static int
+sortlines(char *sols, char *lines[static MAXSOLS])
+{
+	int n;
+	char *p;
+
+	for (n = 0, p = strtok(sols, "\n"); p != NULL && n < MAXSOLS;
+	    p = strtok(NULL, "\n"))
+		lines[n++] = p;
+	qsort(lines, n, sizeof(char *), compare);
+
+	return n;
+}
+
+/* The solutions are the same, up to their order */
+static bool
+samesolutions(const char *a, const char *b)
+{
+	static char x[SOL_BUFFER_LEN], y[SOL_BUFFER_LEN];
+	char *linesx[MAXSOLS], *linesy[MAXSOLS];
+	int i, n, m;
+
+	strcpy(x, a);
+	strcpy(y, b);
+	n = sortlines(x, linesx);
+	m = sortlines(y, linesy);
+	if (n != m)
+		return false;
+
+	for (i = 0; i < n; i++)
+		if (strcmp(linesx[i], linesy[i]))
+			return false;
+
+	return true;
+}
+
+static long long
+solve(
+	const char *cube,
+	unsigned maxmoves,
+	unsigned maxsols,
+	uint64_t size,
+	const char *buf,
+	char *sols
+)
+{
+	long long stats[NISSY_SIZE_SOLVE_STATS];
+
+	return nissy_solve(cube, SOLVER, NISSY_NISSFLAG_NORMAL, 0, maxmoves,
+	    maxsols, -1, size, buf, SOL_BUFFER_LEN, sols, stats);
+}
+
+void run(void) {
+	char movestr[STRLENMAX], *buf, *sols, *ref[2*NTRANS], *lruref[NTRANS];
+	char solved[NISSY_SIZE_B32], scrambled[NISSY_SIZE_B32];
+	char inv[NISSY_SIZE_B32], cube[2*NTRANS][NISSY_SIZE_B32];
+	char name[2*NTRANS][STRLENMAX];
+	int i;
+	unsigned maxmoves, maxsols, lru[] = { 127, 126, 127, 125, 127, 126 };
+	long long r, rref[2*NTRANS], rlru[NTRANS];
+	long long stats[NISSY_SIZE_CACHE_STATS];
+	uint64_t size, cocsepsize, selfsim[COCSEP_CLASSES];
+	cube_t crep[COCSEP_CLASSES];
+	tableinfo_t info;
+
+	fgets(movestr, STRLENMAX, stdin);
+	writecube("B32", solvedcube(), NISSY_SIZE_B32, solved);
+	nissy_applymoves(solved, movestr, scrambled);
+	nissy_inverse(scrambled, inv);
+	fgets(movestr, STRLENMAX, stdin);
+	maxmoves = atoi(movestr);
+	fgets(movestr, STRLENMAX, stdin);
+	maxsols = atoi(movestr);
+
+	size = nissy_datasize(SOLVER);
+	buf = calloc(size, 1);
+	sols = malloc(SOL_BUFFER_LEN);
+
+	cocsepsize = gendata_cocsep(buf, selfsim, crep);
+	readtableinfo(size, buf, &info);
+	info.next = cocsepsize;
+	writetableinfo(&info, size, buf);
+	info = (tableinfo_t) {
+		.solver = "h48 solver h = 0, k = 4",
+		.type = TABLETYPE_PRUNING,
+		.infosize = INFOSIZE,
+		.fullsize = size - cocsepsize,
+		.entries = 2 * (size - cocsepsize - INFOSIZE),
+		.classes = COCSEP_CLASSES,
+		.h48h = 0,
+		.bits = 4,
+		.base = 0,
+		.maxvalue = 0,
+		.next = 0,
+	};
+	writetableinfo(&info, size - cocsepsize, buf + cocsepsize);
+
+	/* The solutions that are cut short must not depend on the threads */
+	nissy_setthreads(1);
+	nissy_setinterleave(1);
+
+	nissy_setcache(0, NISSY_CACHE_OFF);
+	for (i = 0; i < 2*NTRANS; i++) {
+		nissy_applytrans(i < NTRANS ? scrambled : inv,
+		    trans[i % NTRANS], cube[i]);
+		sprintf(name[i], "%s%s", i < NTRANS ? "" : "inverse ",
+		    trans[i % NTRANS]);
+		ref[i] = malloc(SOL_BUFFER_LEN);
+		rref[i] = solve(cube[i], maxmoves, maxsols, size, buf, ref[i]);
+	}
+	for (i = 0; i < NTRANS; i++) {
+		lruref[i] = malloc(SOL_BUFFER_LEN);
+		rlru[i] = solve(cube[i], maxmoves, 127, size, buf, lruref[i]);
+	}
+
+	nissy_setcache(1 << 20, NISSY_CACHE_INVERSE);
+	for (i = 0; i < 2*NTRANS; i++) {
+		r = solve(cube[i], maxmoves, maxsols, size, buf, sols);
+		printf("%s: %lld solutions\n", name[i], rref[i]);
+		if (r != rref[i] || !samesolutions(sols, ref[i]))
+			printf("Different solutions with the cache\n");
+	}
+	nissy_cachestats(stats);
+	printf("Cache: %lld hits, %lld misses, %lld entries\n",
+	    stats[0], stats[1], stats[3]);
+
+	/* Room for two entries with the same solutions */
+	nissy_setcache(1 << 20, NISSY_CACHE_SYMMETRY);
+	solve(cube[0], maxmoves, 127, size, buf, sols);
+	nissy_cachestats(stats);
+	nissy_setcache(2 * stats[4], NISSY_CACHE_SYMMETRY);
+	for (i = 0; i < (int)(sizeof(lru) / sizeof(lru[0])); i++) {
+		r = solve(cube[i % NTRANS], maxmoves, lru[i], size, buf, sols);
+		if (r != rlru[i % NTRANS] ||
+		    !samesolutions(sols, lruref[i % NTRANS]))
+			printf("Different solutions with the cache\n");
+	}
+	nissy_cachestats(stats);
+	printf("LRU: %lld hits, %lld misses, %lld evictions, %lld entries\n",
+	    stats[0], stats[1], stats[2], stats[3]);
+
+	nissy_setcache(0, NISSY_CACHE_OFF);
+	for (i = 0; i < 2*NTRANS; i++)
+		free(ref[i]);
+	for (i = 0; i < NTRANS; i++)
+		free(lruref[i]);
+	free(buf);
+	free(sols);
+}
@@ -35,7 +35,7 @@ run(void) {
 	}
 
 gendata_run_finish:
-	free(buf);
+	freedata(solver, buf);
 }
 
 int main(int argc, char **argv) {
@@ -112,6 +112,6 @@ int main(int argc, char **argv) {
 
 	timerun(run);
 
-	free(buf);
+	freedata(solver, buf);
 	return 0;
 }
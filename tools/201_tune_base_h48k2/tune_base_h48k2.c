@@ -0,0 +1,350 @@
+/*
+Choose the base value of an h48 k=2 or k=1 table by sampling, instead of
+using the hand-picked values of gendata_h48k2().
+
+A k=2 table with base b stores, for a position at distance d from solved
+in the h48 coordinate with the given h, the value 0 if d <= b (in which case
+the solver uses the h0k4 fallback table), the value d-b if b < d < b+3 and
+the value 3 otherwise. A k=1 table stores 0 if d <= b and 1 otherwise.
+The exact values of d (and of the h0k4 fallback bound) are computed with
+the h48stats solver on random positions, and for each candidate base they
+give an estimate of the distribution of the lower bound used by the solver.
+
+The number of nodes of an iterative-deepening search up to depth D is
+estimated as in Korf, Reid and Edelkamp, "Time complexity of
+iterative-deepening A*" (2001): the search at depth D visits about
+   sum_{i=0}^{D} N(i) * P(bound <= D-i)
+nodes, where N(i) is the number of move sequences of length i that the
+solver considers. The cost of a base is the sum of this value over all
+depths up to D, plus the estimated number of lookups in the fallback table
+multiplied by the relative cost of such a lookup.
+
+Usage:
+   tune_base_h48k2 h [-k K] [-samples N] [-depth D] [-fallbackcost W]
+                   [-generate]
+
+With -generate, the table is generated with the best base and written to
+tables/h48hHkK; the base is stored in the header of the table, so the
+solver picks it up automatically.
+
+This tool includes the library source directly, so that the table can be
+generated with a custom base.
+*/
+
+#include <pthread.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/nissy.c"
+
+#define MAX_BASE 14
+#define MAX_DISTANCE 32
+#define MAX_SAMPLE_THREADS 64
+
+static void log_stdout(const char *, ...);
+
+typedef struct {
+	uint64_t seed;
+	int64_t n;
+	uint8_t h;
+	const char *data;
+	int64_t size;
+	int64_t count[MAX_DISTANCE][MAX_DISTANCE]; /* [d_h][d_0] */
+} sample_arg_t;
+
+typedef struct {
+	int base;
+	double fraction[4];
+	double mean_bound;
+	double nodes;
+	double fallbacks;
+	double cost;
+} estimate_t;
+
+static uint64_t
+xorshift(uint64_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+
+	return *state;
+}
+
+static void *
+sample_thread(void *arg)
+{
+	int64_t i;
+	long long stats[NISSY_SIZE_SOLVE_STATS];
+	uint64_t ep, eo, cp, co;
+	char cube[NISSY_SIZE_B32], s[12];
+	sample_arg_t *a;
+
+	a = (sample_arg_t *)arg;
+	for (i = 0; i < a->n; i++) {
+		ep = xorshift(&a->seed);
+		eo = xorshift(&a->seed);
+		cp = xorshift(&a->seed);
+		co = xorshift(&a->seed);
+		nissy_getcube(ep, eo, cp, co, "fix", cube);
+		nissy_solve(cube, "h48stats", NISSY_NISSFLAG_NORMAL, 0, 20, 1,
+		    -1, a->size, a->data, 12, s, stats);
+		if (s[a->h] < MAX_DISTANCE && s[0] < MAX_DISTANCE)
+			a->count[(int)s[a->h]][(int)s[0]]++;
+	}
+
+	return NULL;
+}
+
+/* Number of move sequences of length n that the solver considers */
+static double
+sequences(int n)
+{
+	int i;
+	double first, second, f, s;
+
+	/*
+	A sequence can't contain two consecutive moves on the same face,
+	and two consecutive moves on opposite faces must be in a fixed
+	order. We count separately the sequences ending on the first and on
+	the second face of each axis.
+	*/
+	if (n == 0)
+		return 1.0;
+	for (i = 1, first = 9.0, second = 9.0; i < n; i++) {
+		f = 3.0 * (2.0 * first + 2.0 * second);
+		s = 3.0 * (3.0 * first + 2.0 * second);
+		first = f;
+		second = s;
+	}
+
+	return first + second;
+}
+
+static estimate_t
+estimate(
+	uint8_t k,
+	int base,
+	int depth,
+	double fallbackcost,
+	int64_t count[static MAX_DISTANCE][MAX_DISTANCE],
+	int64_t total
+)
+{
+	int dh, d0, bound, value, D, i;
+	double p, bound_le[MAX_DISTANCE], fallback_le[MAX_DISTANCE];
+	estimate_t e;
+
+	memset(&e, 0, sizeof(e));
+	memset(bound_le, 0, sizeof(bound_le));
+	memset(fallback_le, 0, sizeof(fallback_le));
+	e.base = base;
+
+	for (dh = 0; dh < MAX_DISTANCE; dh++) {
+		for (d0 = 0; d0 < MAX_DISTANCE; d0++) {
+			if (count[dh][d0] == 0)
+				continue;
+			p = (double)count[dh][d0] / total;
+			value = dh <= base ?
+			    0 : MIN(dh - base, UINT8_BIT(k) - 1);
+			bound = value == 0 ? d0 : base + value;
+			e.fraction[value] += p;
+			e.mean_bound += p * bound;
+			for (i = bound; i < MAX_DISTANCE; i++) {
+				bound_le[i] += p;
+				if (value == 0)
+					fallback_le[i] += p;
+			}
+		}
+	}
+
+	for (D = 0; D <= depth; D++) {
+		for (i = 0; i <= D; i++) {
+			e.nodes += sequences(i) * bound_le[D-i];
+			e.fallbacks += sequences(i) * fallback_le[D-i];
+		}
+	}
+	e.cost = e.nodes + fallbackcost * e.fallbacks;
+
+	return e;
+}
+
+static int
+generate(uint8_t h, uint8_t k, uint8_t base)
+{
+	int64_t size;
+	char filename[256];
+	static gendata_h48_arg_t arg;
+	FILE *f;
+
+	sprintf(filename, "tables/h48h%" PRIu8 "k%" PRIu8, h, k);
+	size = nissy_datasize(filename + strlen("tables/"));
+	arg.buf_size = size;
+	arg.buf = malloc(size);
+	arg.h = h;
+	arg.k = k;
+	arg.base = base;
+	arg.maxdepth = 20;
+	if (arg.buf == NULL || gendata_h48(&arg) != size) {
+		printf("Error generating the table\n");
+		free(arg.buf);
+		return 1;
+	}
+
+	nissy_datainfo(size, arg.buf, log_stdout);
+	if ((f = fopen(filename, "wb")) == NULL) {
+		printf("Could not write the table to %s\n", filename);
+		free(arg.buf);
+		return 1;
+	}
+	fwrite(arg.buf, size, 1, f);
+	fclose(f);
+	printf("Table written to %s\n", filename);
+
+	free(arg.buf);
+	return 0;
+}
+
+static void
+log_stdout(const char *str, ...)
+{
+	va_list args;
+
+	va_start(args, str);
+	vprintf(str, args);
+	va_end(args);
+}
+
+static int
+readh0k4(char **data, int64_t *size)
+{
+	FILE *f;
+
+	*size = nissy_datasize("h48h0k4");
+	if ((*data = malloc(*size)) == NULL)
+		return 1;
+
+	if ((f = fopen("tables/h48h0k4", "rb")) != NULL) {
+		if (fread(*data, *size, 1, f) == 1) {
+			fclose(f);
+			return 0;
+		}
+		fclose(f);
+	}
+
+	printf("Could not read tables/h48h0k4, generating it.\n");
+	return nissy_gendata("h48h0k4", *size, *data) != *size;
+}
+
+int
+main(int argc, char **argv)
+{
+	int i, b, best, second, nthreads, depth, dh, d0;
+	bool gen;
+	int64_t samples, size, n, total, count[MAX_DISTANCE][MAX_DISTANCE];
+	double fallbackcost;
+	uint8_t h, k;
+	char *data;
+	estimate_t e[MAX_BASE+1];
+	pthread_t thread[MAX_SAMPLE_THREADS];
+	static sample_arg_t arg[MAX_SAMPLE_THREADS];
+
+	if (argc < 2) {
+		printf("Error: the value of h must be given.\n");
+		return 1;
+	}
+
+	h = atoi(argv[1]);
+	k = 2;
+	samples = 10000;
+	depth = 18;
+	fallbackcost = 1.0;
+	gen = false;
+	for (i = 2; i < argc; i++) {
+		if (!strcmp(argv[i], "-k") && i+1 < argc) {
+			k = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-samples") && i+1 < argc) {
+			samples = atoll(argv[++i]);
+		} else if (!strcmp(argv[i], "-depth") && i+1 < argc) {
+			depth = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-fallbackcost") && i+1 < argc) {
+			fallbackcost = strtod(argv[++i], NULL);
+		} else if (!strcmp(argv[i], "-generate")) {
+			gen = true;
+		} else {
+			printf("Error: unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (h < 1 || h > 10 || (k != 1 && k != 2) || samples < 1 ||
+	    depth < 1 || depth >= MAX_DISTANCE) {
+		printf("Error: invalid options (h must be between 1 and 10"
+		    " and k must be 1 or 2)\n");
+		return 1;
+	}
+
+	if (readh0k4(&data, &size) != 0) {
+		printf("Error: could not get the h0k4 table\n");
+		return 1;
+	}
+
+	/* Fixed seeds, so that different runs use the same positions */
+	nthreads = MIN(atomic_load(&nissy_threads), MAX_SAMPLE_THREADS);
+	for (i = 0; i < nthreads; i++) {
+		arg[i] = (sample_arg_t) {
+			.seed = UINT64_C(0x9E3779B97F4A7C15) * (i+1),
+			.n = samples / nthreads + (i < samples % nthreads),
+			.h = h,
+			.data = data,
+			.size = size,
+		};
+		pthread_create(&thread[i], NULL, sample_thread, &arg[i]);
+	}
+	memset(count, 0, sizeof(count));
+	for (i = 0; i < nthreads; i++) {
+		pthread_join(thread[i], NULL);
+		for (dh = 0; dh < MAX_DISTANCE; dh++)
+			for (d0 = 0; d0 < MAX_DISTANCE; d0++)
+				count[dh][d0] += arg[i].count[dh][d0];
+	}
+	free(data);
+
+	printf("Distribution of the h%" PRIu8 " distance on %" PRId64
+	    " random positions:\n", h, samples);
+	for (dh = 0, total = 0; dh < MAX_DISTANCE; dh++) {
+		for (d0 = 0, n = 0; d0 < MAX_DISTANCE; d0++)
+			n += count[dh][d0];
+		if (n > 0)
+			printf("%2d: %" PRId64 "\n", dh, n);
+		total += n;
+	}
+
+	printf("\nEstimates for an optimal search up to depth %d "
+	    "(fallback cost %.2f):\n", depth, fallbackcost);
+	printf("%4s %8s %8s %8s %8s %7s %12s %12s %12s\n", "base", "P(0)",
+	    "P(1)", "P(2)", "P(3)", "mean", "nodes", "fallbacks", "cost");
+	for (b = 0, best = second = -1; b <= MAX_BASE; b++) {
+		e[b] = estimate(k, b, depth, fallbackcost, count, total);
+		if (best == -1 || e[b].cost < e[best].cost) {
+			second = best;
+			best = b;
+		} else if (second == -1 || e[b].cost < e[second].cost) {
+			second = b;
+		}
+		printf("%4d %8.5f %8.5f %8.5f %8.5f %7.3f %12.4g %12.4g "
+		    "%12.4g\n", b, e[b].fraction[0], e[b].fraction[1],
+		    e[b].fraction[2], e[b].fraction[3], e[b].mean_bound,
+		    e[b].nodes, e[b].fallbacks, e[b].cost);
+	}
+
+	printf("\nBest base for h = %" PRIu8 ", k = %" PRIu8 ": %d (estimated "
+	    "cost %.1f%% of the second best, base %d)\n", h, k, best,
+	    100.0 * e[best].cost / e[second].cost, second);
+
+	if (gen)
+		return generate(h, k, best);
+
+	return 0;
+}
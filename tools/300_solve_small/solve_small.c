@@ -67,6 +67,6 @@ int main(int argc, char **argv) {
 
 	timerun(run);
 
-	free(buf);
+	freedata(solver, buf);
 	return 0;
 }
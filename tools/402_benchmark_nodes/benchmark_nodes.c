@@ -185,13 +185,13 @@ int main(int argc, char **argv) {
 
 	if (read_scrambles_from_file(scrambles_filename, scrambles) != 0) {
 		printf("Error: failed to read scrambles from file\n");
-		free(buf);
+		freedata(solver, buf);
 		return 1;
 	}
 
 	run_all_scrambles();
 
-	free(buf);
+	freedata(solver, buf);
 
 	for (int i = 0; scrambles[i] != NULL; i++) {
 		free(scrambles[i]);
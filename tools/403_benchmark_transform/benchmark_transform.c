@@ -0,0 +1,132 @@
+/*
+Microbenchmark for transform_edges() and transform(), comparing the
+table-driven implementation with a reference implementation that
+switches over the 48 transformations. The transformations are chosen
+at random, as they are in the solver.
+
+This tool includes the library source directly, so that the internal
+functions can be inlined as they are in the library itself.
+*/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/nissy.c"
+
+#define NCUBES (1 << 10)
+#define NTRANS (1 << 12)
+#define REPEAT 4000
+
+#define CASE_EDGES(T, c) case TRANS_ ## T: \
+	return compose_edges(compose_edges(TRANS_CUBE_ ## T, c), \
+	    TRANS_CUBE_ ## T ## _INVERSE);
+#define CASE_ROTATION(T, c) case TRANS_ ## T: \
+	return compose(compose(TRANS_CUBE_ ## T, c), \
+	    TRANS_CUBE_ ## T ## _INVERSE);
+#define CASE_MIRRORED(T, c) case TRANS_ ## T: \
+	return invertco(compose(compose(TRANS_CUBE_ ## T, c), \
+	    TRANS_CUBE_ ## T ## _INVERSE));
+
+#define ALL_CASES(CASE_R, CASE_M, c) \
+	CASE_R(UFr, c) CASE_R(ULr, c) CASE_R(UBr, c) CASE_R(URr, c) \
+	CASE_R(DFr, c) CASE_R(DLr, c) CASE_R(DBr, c) CASE_R(DRr, c) \
+	CASE_R(RUr, c) CASE_R(RFr, c) CASE_R(RDr, c) CASE_R(RBr, c) \
+	CASE_R(LUr, c) CASE_R(LFr, c) CASE_R(LDr, c) CASE_R(LBr, c) \
+	CASE_R(FUr, c) CASE_R(FRr, c) CASE_R(FDr, c) CASE_R(FLr, c) \
+	CASE_R(BUr, c) CASE_R(BRr, c) CASE_R(BDr, c) CASE_R(BLr, c) \
+	CASE_M(UFm, c) CASE_M(ULm, c) CASE_M(UBm, c) CASE_M(URm, c) \
+	CASE_M(DFm, c) CASE_M(DLm, c) CASE_M(DBm, c) CASE_M(DRm, c) \
+	CASE_M(RUm, c) CASE_M(RFm, c) CASE_M(RDm, c) CASE_M(RBm, c) \
+	CASE_M(LUm, c) CASE_M(LFm, c) CASE_M(LDm, c) CASE_M(LBm, c) \
+	CASE_M(FUm, c) CASE_M(FRm, c) CASE_M(FDm, c) CASE_M(FLm, c) \
+	CASE_M(BUm, c) CASE_M(BRm, c) CASE_M(BDm, c) CASE_M(BLm, c)
+
+static cube_t cubes[NCUBES];
+static uint8_t trans[NTRANS];
+
+static cube_t
+switch_transform_edges(cube_t c, uint8_t t)
+{
+	switch (t) {
+	ALL_CASES(CASE_EDGES, CASE_EDGES, c)
+	default:
+		return ZERO_CUBE;
+	}
+}
+
+static cube_t
+switch_transform(cube_t c, uint8_t t)
+{
+	switch (t) {
+	ALL_CASES(CASE_ROTATION, CASE_MIRRORED, c)
+	default:
+		return ZERO_CUBE;
+	}
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+#define BENCH(NAME, F) \
+static double \
+bench_ ## NAME(int64_t *check) \
+{ \
+	int64_t i, j, k, sum; \
+	double start; \
+	cube_t c; \
+	start = now(); \
+	sum = 0; \
+	for (i = 0; i < REPEAT; i++) { \
+		for (j = 0; j < NCUBES; j++) { \
+			k = (i * NCUBES + j) % NTRANS; \
+			c = F(cubes[j], trans[k]); \
+			sum += coord_eo(c) + coord_csep(c) + coord_co(c); \
+		} \
+	} \
+	*check = sum; \
+	return 1e9 * (now() - start) / ((double)REPEAT * NCUBES); \
+}
+
+BENCH(switch_edges, switch_transform_edges)
+BENCH(table_edges, transform_edges)
+BENCH(switch_full, switch_transform)
+BENCH(table_full, transform)
+
+int
+main(void)
+{
+	int64_t i, j, c1, c2;
+	double t1, t2;
+
+	srand(time(NULL));
+	for (i = 0; i < NCUBES; i++) {
+		cubes[i] = SOLVED_CUBE;
+		for (j = 0; j < 30; j++)
+			cubes[i] = move(cubes[i], rand() % 18);
+	}
+	for (i = 0; i < NTRANS; i++)
+		trans[i] = rand() % 48;
+
+	printf("Average time per call (%d calls):\n\n",
+	    REPEAT * NCUBES);
+
+	t1 = bench_switch_edges(&c1);
+	t2 = bench_table_edges(&c2);
+	printf("transform_edges  switch: %6.2fns  table: %6.2fns%s\n",
+	    t1, t2, c1 == c2 ? "" : "  (results differ!)");
+
+	t1 = bench_switch_full(&c1);
+	t2 = bench_table_full(&c2);
+	printf("transform        switch: %6.2fns  table: %6.2fns%s\n",
+	    t1, t2, c1 == c2 ? "" : "  (results differ!)");
+
+	return c1 == c2 ? 0 : 1;
+}
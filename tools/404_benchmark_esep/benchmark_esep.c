@@ -0,0 +1,161 @@
+/*
+Microbenchmark for coord_esep() and invcoord_esep(), comparing them with
+the reference implementation that loops over the edges and computes the
+ranks with a table of binomial coefficients.
+
+This tool includes the library source directly, so that the internal
+functions can be inlined as they are in the library itself.
+*/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/nissy.c"
+
+#define NCUBES (1 << 12)
+#define REPEAT 2000
+
+static int64_t binomial[12][12];
+static cube_t cubes[NCUBES];
+static int64_t coords[NCUBES];
+
+static int64_t
+loop_coord_esep(cube_t c)
+{
+	uint8_t corner[8], edge[12];
+	int64_t i, j, jj, k, l, ret1, ret2, bit1, bit2, is1;
+
+	pieces(&c, corner, edge);
+	for (i = 0, j = 0, k = 4, l = 4, ret1 = 0, ret2 = 0; i < 12; i++) {
+		bit1 = (edge[i] & ESEPBIT_1) >> 2;
+		bit2 = (edge[i] & ESEPBIT_2) >> 3;
+		is1 = (1 - bit2) * bit1;
+
+		ret1 += bit2 * binomial[11-i][k];
+		k -= bit2;
+
+		jj = j < 8;
+		ret2 += jj * is1 * binomial[7-(j*jj)][l];
+		l -= is1;
+		j += (1-bit2);
+	}
+
+	return ret1 * 70 + ret2;
+}
+
+static cube_t
+loop_invcoord_esep(int64_t esep)
+{
+	int64_t bit1, bit2, i, j, jj, k, l, s, v, w, is1, set1, set2;
+	uint8_t slice[3] = {0}, mem[32] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+	set1 = esep % 70;
+	set2 = esep / 70;
+	for (i = 0, j = 0, k = 4, l = 4; i < 12; i++) {
+		v = binomial[11 - i][k];
+		jj = j < 8;
+		w = jj * binomial[7 - (j * jj)][l];
+		bit2 = set2 >= v;
+		bit1 = set1 >= w;
+		is1 = (1 - bit2) * bit1;
+
+		set2 -= bit2 * v;
+		k -= bit2;
+		set1 -= is1 * w;
+		l -= is1;
+		j += (1 - bit2);
+		s = 2 * bit2 + (1 - bit2) * bit1;
+
+		mem[16 + i] = (slice[s]++) | (uint8_t)(s << 2);
+	}
+
+	return loadcube(mem);
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+#define BENCH_COORD(NAME, F) \
+static double \
+bench_ ## NAME(int64_t *check) \
+{ \
+	int64_t i, j, sum; \
+	double start; \
+	start = now(); \
+	for (i = 0, sum = 0; i < REPEAT; i++) \
+		for (j = 0; j < NCUBES; j++) \
+			sum += F(cubes[j]); \
+	*check = sum; \
+	return 1e9 * (now() - start) / ((double)REPEAT * NCUBES); \
+}
+
+#define BENCH_INVCOORD(NAME, F) \
+static double \
+bench_ ## NAME(int64_t *check) \
+{ \
+	int64_t i, j, sum; \
+	double start; \
+	start = now(); \
+	for (i = 0, sum = 0; i < REPEAT; i++) \
+		for (j = 0; j < NCUBES; j++) \
+			sum += coord_eo(F(coords[j])) + \
+			    coord_csep(F(coords[j])); \
+	*check = sum; \
+	return 1e9 * (now() - start) / ((double)REPEAT * NCUBES); \
+}
+
+BENCH_COORD(loop_coord, loop_coord_esep)
+BENCH_COORD(table_coord, coord_esep)
+BENCH_INVCOORD(loop_invcoord, loop_invcoord_esep)
+BENCH_INVCOORD(table_invcoord, invcoord_esep)
+
+int
+main(void)
+{
+	int64_t i, j, c1, c2;
+	double t1, t2;
+	bool ok;
+
+	for (i = 0; i < 12; i++) {
+		binomial[i][0] = 1;
+		for (j = 1; j <= i; j++)
+			binomial[i][j] = binomial[i-1][j-1] + binomial[i-1][j];
+	}
+
+	srand(time(NULL));
+	for (i = 0; i < NCUBES; i++) {
+		cubes[i] = SOLVED_CUBE;
+		for (j = 0; j < 30; j++)
+			cubes[i] = move(cubes[i], rand() % 18);
+		coords[i] = rand() % 34650;
+	}
+
+	for (i = 0, ok = true; i < 34650; i++)
+		ok = ok && loop_coord_esep(loop_invcoord_esep(i)) == i &&
+		    equal(invcoord_esep(i), loop_invcoord_esep(i));
+	printf("Check against reference: %s\n\n", ok ? "ok" : "FAILED");
+
+	printf("Average time per call (%d calls):\n\n", REPEAT * NCUBES);
+
+	t1 = bench_loop_coord(&c1);
+	t2 = bench_table_coord(&c2);
+	ok = ok && c1 == c2;
+	printf("coord_esep     loop: %6.2fns  table: %6.2fns%s\n",
+	    t1, t2, c1 == c2 ? "" : "  (results differ!)");
+
+	t1 = bench_loop_invcoord(&c1);
+	t2 = bench_table_invcoord(&c2);
+	ok = ok && c1 == c2;
+	printf("invcoord_esep  loop: %6.2fns  table: %6.2fns%s\n",
+	    t1, t2, c1 == c2 ? "" : "  (results differ!)");
+
+	return ok ? 0 : 1;
+}
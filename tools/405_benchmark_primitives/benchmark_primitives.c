@@ -0,0 +1,274 @@
+/*
+Microbenchmark for the primitives on cubes and for the h48 coordinate and
+table lookups. Run it with different ARCH values (see configure.sh) to
+compare the backends, or use "./benchmark.sh primitives" to run it for
+each backend supported by this machine.
+
+Each primitive is measured in two ways:
+   - throughput: the primitive is applied to an array of random cubes and
+     the results are stored, so that the calls are independent;
+   - latency (the "chain" rows): the result of each call is the input of
+     the next one, so that the calls can't overlap.
+A checksum of the results is printed, so that the compiler can't discard
+the calls.
+
+If arguments are given, only the benchmarks whose name contains one of them
+are run, for example TOOLARGS="compose coord_h48".
+
+This tool includes the library source directly, so that the internal
+functions can be inlined as they are in the library itself.
+*/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/nissy.c"
+
+#define NCUBES (1 << 12)
+#define REPEAT 2000
+#define CHAIN_LENGTH ((int64_t)REPEAT * NCUBES)
+
+/* Pruning table used for get_h48_pval, filled with random values */
+#define PVAL_H 0
+#define PVAL_K 4
+#define NLOOKUPS (1 << 20)
+#define LOOKUP_REPEAT 8
+
+static cube_t cubes[NCUBES];
+static cube_t results[NCUBES];
+static int64_t eos[NCUBES];
+static int64_t coords[NCUBES];
+static uint8_t moves[NCUBES];
+static uint8_t trans[NCUBES];
+static char cocsepbuf[COCSEP_FULLSIZE + INFOSIZE];
+static uint32_t *cocsepdata;
+static cube_t crep[COCSEP_CLASSES];
+static uint8_t *pvaltable;
+static int64_t lookups[NLOOKUPS];
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int64_t
+checksum(void)
+{
+	int64_t j, sum;
+
+	for (j = 0, sum = 0; j < NCUBES; j++)
+		sum += coord_cocsep(results[j]) + coord_esep(results[j]) +
+		    coord_eo(results[j]);
+
+	return sum;
+}
+
+#define BENCH_CUBE(NAME, EXPR) \
+static double \
+bench_ ## NAME(int64_t *check) \
+{ \
+	int64_t i, j; \
+	double start; \
+	start = now(); \
+	for (i = 0; i < REPEAT; i++) \
+		for (j = 0; j < NCUBES; j++) \
+			results[j] = EXPR; \
+	start = 1e9 * (now() - start) / ((double)REPEAT * NCUBES); \
+	*check = checksum(); \
+	return start; \
+}
+
+#define BENCH_COORD(NAME, F) \
+static double \
+bench_ ## NAME(int64_t *check) \
+{ \
+	int64_t i, j, sum; \
+	double start; \
+	start = now(); \
+	for (i = 0, sum = 0; i < REPEAT; i++) \
+		for (j = 0; j < NCUBES; j++) \
+			sum += F(CUBE(i, j)); \
+	*check = sum; \
+	return 1e9 * (now() - start) / ((double)REPEAT * NCUBES); \
+}
+
+#define BENCH_CHAIN(NAME, EXPR) \
+static double \
+bench_ ## NAME(int64_t *check) \
+{ \
+	int64_t i; \
+	double start; \
+	cube_t c; \
+	c = cubes[0]; \
+	start = now(); \
+	for (i = 0; i < CHAIN_LENGTH; i++) \
+		c = EXPR; \
+	start = 1e9 * (now() - start) / (double)CHAIN_LENGTH; \
+	*check = coord_cocsep(c) + coord_esep(c) + coord_eo(c); \
+	return start; \
+}
+
+/* The index depends on i, so that the compiler can't hoist the inner loop */
+#define CUBE(i, j) cubes[((i) + (j)) % NCUBES]
+#define INDEX(i, j) (((i) + (j)) % NCUBES)
+#define EQUAL_SOLVED(c) equal(c, SOLVED_CUBE)
+#define COORD_H48(c) coord_h48(c, cocsepdata, PVAL_H)
+
+BENCH_CUBE(compose, compose(CUBE(i, j), CUBE(i, j+1)))
+BENCH_CUBE(compose_edges, compose_edges(CUBE(i, j), CUBE(i, j+1)))
+BENCH_CUBE(compose_corners, compose_corners(CUBE(i, j), CUBE(i, j+1)))
+BENCH_CUBE(inverse, inverse(CUBE(i, j)))
+BENCH_CUBE(invertco, invertco(CUBE(i, j)))
+BENCH_CUBE(move, move(CUBE(i, j), moves[j]))
+BENCH_CUBE(premove, premove(CUBE(i, j), moves[j]))
+BENCH_CUBE(transform, transform(CUBE(i, j), trans[j]))
+BENCH_CUBE(transform_edges, transform_edges(CUBE(i, j), trans[j]))
+BENCH_CUBE(transform_corners, transform_corners(CUBE(i, j), trans[j]))
+BENCH_CUBE(invcoord_h48, invcoord_h48(coords[INDEX(i, j)], crep, PVAL_H))
+BENCH_CUBE(set_eo, (results[j] = CUBE(i, j), \
+    set_eo(&results[j], eos[j]), results[j]))
+BENCH_COORD(coord_co, coord_co)
+BENCH_COORD(coord_csep, coord_csep)
+BENCH_COORD(coord_cocsep, coord_cocsep)
+BENCH_COORD(coord_eo, coord_eo)
+BENCH_COORD(coord_esep, coord_esep)
+BENCH_COORD(equal, EQUAL_SOLVED)
+BENCH_COORD(coord_h48, COORD_H48)
+
+static double
+bench_get_h48_pval(int64_t *check)
+{
+	int64_t i, j, sum;
+	double start;
+
+	start = now();
+	for (i = 0, sum = 0; i < LOOKUP_REPEAT; i++)
+		for (j = 0; j < NLOOKUPS; j++)
+			sum += get_h48_pval(pvaltable, lookups[j], PVAL_K);
+	*check = sum;
+
+	return 1e9 * (now() - start) / ((double)LOOKUP_REPEAT * NLOOKUPS);
+}
+
+BENCH_CHAIN(compose_chain, compose(c, cubes[i % NCUBES]))
+BENCH_CHAIN(inverse_chain, inverse(c))
+BENCH_CHAIN(move_chain, move(c, moves[i % NCUBES]))
+BENCH_CHAIN(premove_chain, premove(c, moves[i % NCUBES]))
+BENCH_CHAIN(transform_chain, transform(c, trans[i % NCUBES]))
+
+/* Each lookup depends on the previous one, like in a search */
+static double
+bench_get_h48_pval_chain(int64_t *check)
+{
+	int64_t i, p;
+	double start;
+
+	start = now();
+	for (i = 0, p = 0; i < CHAIN_LENGTH; i++)
+		p = get_h48_pval(
+		    pvaltable, lookups[(i + p) % NLOOKUPS], PVAL_K);
+	*check = p;
+
+	return 1e9 * (now() - start) / (double)CHAIN_LENGTH;
+}
+
+struct {
+	const char *name;
+	double (*bench)(int64_t *);
+} benchmarks[] = {
+	{ "compose", bench_compose },
+	{ "compose_edges", bench_compose_edges },
+	{ "compose_corners", bench_compose_corners },
+	{ "inverse", bench_inverse },
+	{ "invertco", bench_invertco },
+	{ "move", bench_move },
+	{ "premove", bench_premove },
+	{ "transform", bench_transform },
+	{ "transform_edges", bench_transform_edges },
+	{ "transform_corners", bench_transform_corners },
+	{ "set_eo", bench_set_eo },
+	{ "coord_co", bench_coord_co },
+	{ "coord_csep", bench_coord_csep },
+	{ "coord_cocsep", bench_coord_cocsep },
+	{ "coord_eo", bench_coord_eo },
+	{ "coord_esep", bench_coord_esep },
+	{ "equal", bench_equal },
+	{ "coord_h48", bench_coord_h48 },
+	{ "invcoord_h48", bench_invcoord_h48 },
+	{ "get_h48_pval", bench_get_h48_pval },
+	{ "compose_chain", bench_compose_chain },
+	{ "inverse_chain", bench_inverse_chain },
+	{ "move_chain", bench_move_chain },
+	{ "premove_chain", bench_premove_chain },
+	{ "transform_chain", bench_transform_chain },
+	{ "get_h48_pval_chain", bench_get_h48_pval_chain },
+	{ NULL, NULL }
+};
+
+static bool
+selected(const char *name, int argc, char **argv)
+{
+	int i;
+
+	for (i = 1; i < argc; i++)
+		if (strstr(name, argv[i]) != NULL)
+			return true;
+
+	return argc <= 1;
+}
+
+int
+main(int argc, char **argv)
+{
+	int64_t i, j, check;
+	size_t tablesize;
+	double t;
+
+	/* Fixed seed, so that different runs use the same cubes */
+	srand(1);
+	for (i = 0; i < NCUBES; i++) {
+		cubes[i] = SOLVED_CUBE;
+		for (j = 0; j < 30; j++)
+			cubes[i] = move(cubes[i], rand() % 18);
+		eos[i] = rand() % 2048;
+		moves[i] = rand() % 18;
+		trans[i] = rand() % 48;
+	}
+
+	gendata_cocsep(cocsepbuf, NULL, crep);
+	cocsepdata = (uint32_t *)(cocsepbuf + INFOSIZE);
+	for (i = 0; i < NCUBES; i++)
+		coords[i] = coord_h48(cubes[i], cocsepdata, PVAL_H);
+
+	tablesize = H48_TABLESIZE(PVAL_H, PVAL_K);
+	if ((pvaltable = malloc(tablesize)) == NULL) {
+		printf("Could not allocate %zu bytes\n", tablesize);
+		return 1;
+	}
+	for (i = 0; i < (int64_t)tablesize; i++)
+		pvaltable[i] = rand();
+	for (i = 0; i < NLOOKUPS; i++)
+		lookups[i] = ((int64_t)rand() * RAND_MAX + rand()) %
+		    H48_COORDMAX(PVAL_H);
+
+	printf("Backend: %s\n", ARCH_NAME);
+	printf("Average time per call (%d calls):\n\n", REPEAT * NCUBES);
+	printf("%-20s %9s %12s\n", "primitive", "time", "calls/s");
+
+	for (i = 0; benchmarks[i].name != NULL; i++) {
+		if (!selected(benchmarks[i].name, argc, argv))
+			continue;
+		t = benchmarks[i].bench(&check);
+		printf("%-20s %7.2fns %11.2fM  (checksum %" PRId64 ")\n",
+		    benchmarks[i].name, t, 1e3 / t, check);
+	}
+
+	free(pvaltable);
+	return 0;
+}
@@ -0,0 +1,577 @@
+/*
+Benchmark the solvers on sets of scrambles, for each combination of solver,
+number of threads and scramble set given on the command line. The library
+does not need to be rebuilt between runs: the number of threads is set with
+nissy_setthreads(), so the library should be configured with the largest
+value of THREADS that is going to be tested.
+
+Usage:
+   benchmark_solve [-solver S1,S2,...] [-threads T1,T2,...]
+                   [-scrambles FILE1,FILE2,...] [-format text|csv|json]
+                   [-output FILE] [-baseline FILE] [-tolerance PERCENT]
+
+Each scramble file contains one scramble per line; empty lines and lines
+starting with // are ignored. The optimal solution of each scramble is
+found, and for each run the wall time, the number of nodes visited, the
+number of table fallbacks and the number of nodes pruned by each table are
+recorded. The results are summarized in one
+row for the whole set (depth "all") and one row for each length of the
+optimal solution. The nodes pruned by each table (the corner bound, the h48
+table and the extra tables, in the order given in the solver name) are
+shown in a separate table for the whole sets, and as additional columns in
+the csv and json formats.
+
+A file written with -format csv can be used as a baseline for a later run.
+Every row whose mean time is more than PERCENT (by default 10) percent
+larger than in the baseline is reported as a regression, and the exit
+status is 1. A change in the number of nodes is also reported, because it
+means that the search itself has changed.
+
+Examples (TOOLARGS is passed to the tool by make):
+   TOOL=benchmark_solve TOOLARGS="-solver h48h0k4 -threads 1,2,4" make tool
+   TOOL=benchmark_solve TOOLARGS="-format csv -output base.csv" make tool
+   TOOL=benchmark_solve TOOLARGS="-baseline base.csv" make tool
+*/
+
+#include "../tool.h"
+
+#define SOL_BUFFER_LEN 1000
+#define LINE_LEN 1024
+#define MAX_LIST 64
+#define MAX_DEPTH 21
+#define PRUNES 6 /* Entries 2 to 7 of the stats of nissy_solve() */
+#define DEFAULT_SCRAMBLES "tools/406_benchmark_solve/scrambles/short.txt"
+
+typedef enum { FORMAT_TEXT, FORMAT_CSV, FORMAT_JSON } format_t;
+
+typedef struct {
+	double time;
+	long long nodes;
+	long long fallbacks;
+	long long prunes[PRUNES];
+	int depth;
+} sample_t;
+
+typedef struct {
+	char solver[64];
+	unsigned threads;
+	char scrambles[256];
+	char depth[8];
+	size_t count;
+	double time_total;
+	double time_mean;
+	double time_p50;
+	double time_p90;
+	double time_p99;
+	double time_max;
+	long long nodes;
+	long long fallbacks;
+	double nodes_per_second;
+	long long prunes[PRUNES];
+} row_t;
+
+typedef struct {
+	size_t n;
+	size_t capacity;
+	row_t *rows;
+} rows_t;
+
+static int splitlist(char *, char *[static MAX_LIST]);
+static const char *basename_noext(const char *, char [static 256]);
+static double now(void);
+static int compare_times(const void *, const void *);
+static double percentile(const double *, size_t, double);
+static void addrow(rows_t *, const char *, unsigned, const char *, int,
+    const sample_t *, size_t);
+static int runset(rows_t *, const char *, unsigned, unsigned long long,
+    const char *, const char *);
+static void writerows(FILE *, format_t, const rows_t *);
+static int readbaseline(const char *, rows_t *);
+static int compare(const rows_t *, const rows_t *, double);
+
+static int
+splitlist(char *str, char *list[static MAX_LIST])
+{
+	int n;
+	char *p;
+
+	for (n = 0, p = str; p != NULL && n < MAX_LIST; n++) {
+		list[n] = p;
+		if ((p = strchr(p, ',')) != NULL)
+			*p++ = '\0';
+	}
+
+	return n;
+}
+
+static const char *
+basename_noext(const char *path, char name[static 256])
+{
+	const char *slash;
+	char *dot;
+
+	slash = strrchr(path, '/');
+	snprintf(name, 256, "%s", slash == NULL ? path : slash+1);
+	if ((dot = strrchr(name, '.')) != NULL && dot != name)
+		*dot = '\0';
+
+	return name;
+}
+
+static double
+now(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static int
+compare_times(const void *a, const void *b)
+{
+	double x, y;
+
+	x = *(const double *)a;
+	y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of a sorted array */
+static double
+percentile(const double *sorted, size_t n, double p)
+{
+	size_t rank;
+
+	rank = (size_t)(p * n / 100.0 + 0.999999);
+	if (rank == 0)
+		rank = 1;
+	if (rank > n)
+		rank = n;
+
+	return sorted[rank-1];
+}
+
+/* Add a row for the samples of the given depth, or all of them if -1 */
+static void
+addrow(
+	rows_t *rows,
+	const char *solver,
+	unsigned threads,
+	const char *scrambles,
+	int depth,
+	const sample_t *samples,
+	size_t n
+)
+{
+	int j;
+	size_t i, count;
+	double *times;
+	row_t *row;
+
+	times = malloc(n * sizeof(double));
+	if (rows->n == rows->capacity) {
+		rows->capacity = rows->capacity == 0 ? 64 : 2 * rows->capacity;
+		rows->rows = realloc(rows->rows, rows->capacity * sizeof(row_t));
+	}
+	row = &rows->rows[rows->n];
+	memset(row, 0, sizeof(row_t));
+	snprintf(row->solver, sizeof(row->solver), "%s", solver);
+	snprintf(row->scrambles, sizeof(row->scrambles), "%s", scrambles);
+	row->threads = threads;
+	if (depth < 0)
+		snprintf(row->depth, sizeof(row->depth), "all");
+	else
+		snprintf(row->depth, sizeof(row->depth), "%d", depth);
+
+	for (i = 0, count = 0; i < n; i++) {
+		if (depth >= 0 && samples[i].depth != depth)
+			continue;
+		times[count++] = samples[i].time;
+		row->time_total += samples[i].time;
+		row->nodes += samples[i].nodes;
+		row->fallbacks += samples[i].fallbacks;
+		for (j = 0; j < PRUNES; j++)
+			row->prunes[j] += samples[i].prunes[j];
+	}
+
+	if (count > 0) {
+		qsort(times, count, sizeof(double), compare_times);
+		row->count = count;
+		row->time_mean = row->time_total / count;
+		row->time_p50 = percentile(times, count, 50.0);
+		row->time_p90 = percentile(times, count, 90.0);
+		row->time_p99 = percentile(times, count, 99.0);
+		row->time_max = times[count-1];
+		row->nodes_per_second = row->time_total > 0.0 ?
+		    row->nodes / row->time_total : 0.0;
+		rows->n++;
+	}
+
+	free(times);
+}
+
+static int
+runset(
+	rows_t *rows,
+	const char *solver,
+	unsigned threads,
+	unsigned long long size,
+	const char *data,
+	const char *filename
+)
+{
+	int d, j;
+	long long n, stats[NISSY_SIZE_SOLVE_STATS];
+	size_t ns, capacity;
+	double start;
+	char line[LINE_LEN], cube[NISSY_SIZE_B32], sol[SOL_BUFFER_LEN];
+	char name[256];
+	bool found[MAX_DEPTH];
+	sample_t *samples;
+	FILE *f;
+
+	if ((f = fopen(filename, "r")) == NULL) {
+		fprintf(stderr, "Error: could not open %s\n", filename);
+		return 1;
+	}
+
+	basename_noext(filename, name);
+	memset(found, 0, sizeof(found));
+	ns = capacity = 0;
+	samples = NULL;
+	while (fgets(line, LINE_LEN, f) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '\0' || !strncmp(line, "//", 2))
+			continue;
+
+		if (nissy_applymoves(NISSY_SOLVED_CUBE, line, cube) < 0) {
+			fprintf(stderr, "Skipping invalid scramble %s\n", line);
+			continue;
+		}
+
+		start = now();
+		memset(stats, 0, sizeof(stats));
+		n = nissy_solve(cube, solver, NISSY_NISSFLAG_NORMAL, 0, 20,
+		    1, -1, size, data, SOL_BUFFER_LEN, sol, stats);
+		if (ns == capacity) {
+			capacity = capacity == 0 ? 64 : 2 * capacity;
+			samples = realloc(samples, capacity * sizeof(sample_t));
+		}
+		samples[ns].time = now() - start;
+		if (n <= 0) {
+			fprintf(stderr, "Skipping scramble %s: %s\n", line,
+			    n == 0 ? "no solution found" : "error");
+			continue;
+		}
+
+		/* Only the first solution is considered */
+		sol[strcspn(sol, "\n")] = '\0';
+		d = nissy_countmoves(sol);
+		samples[ns].nodes = stats[0];
+		samples[ns].fallbacks = stats[1];
+		for (j = 0; j < PRUNES; j++)
+			samples[ns].prunes[j] = stats[2+j];
+		samples[ns].depth = d < 0 || d >= MAX_DEPTH ? MAX_DEPTH-1 : d;
+		found[samples[ns].depth] = true;
+
+		fprintf(stderr, "%s %u %s #%zu: %d moves, %.4fs, %lld nodes\n",
+		    solver, threads, name, ns+1, d, samples[ns].time,
+		    samples[ns].nodes);
+		ns++;
+	}
+	fclose(f);
+
+	if (ns > 0) {
+		addrow(rows, solver, threads, name, -1, samples, ns);
+		for (d = 0; d < MAX_DEPTH; d++)
+			if (found[d])
+				addrow(rows, solver, threads, name, d,
+				    samples, ns);
+	}
+
+	free(samples);
+	return 0;
+}
+
+static void
+writerows(FILE *f, format_t format, const rows_t *rows)
+{
+	int j;
+	size_t i;
+	const row_t *r;
+
+	switch (format) {
+	case FORMAT_CSV:
+		fprintf(f, "solver,threads,scrambles,depth,count,time_total,"
+		    "time_mean,time_p50,time_p90,time_p99,time_max,nodes,"
+		    "fallbacks,nodes_per_second,pruned_cbound,pruned_h48,"
+		    "pruned_extra1,pruned_extra2,pruned_extra3,"
+		    "pruned_extra4\n");
+		for (i = 0; i < rows->n; i++) {
+			r = &rows->rows[i];
+			fprintf(f, "%s,%u,%s,%s,%zu,%.6f,%.6f,%.6f,%.6f,%.6f,"
+			    "%.6f,%lld,%lld,%.0f", r->solver, r->threads,
+			    r->scrambles, r->depth, r->count, r->time_total,
+			    r->time_mean, r->time_p50, r->time_p90,
+			    r->time_p99, r->time_max, r->nodes, r->fallbacks,
+			    r->nodes_per_second);
+			for (j = 0; j < PRUNES; j++)
+				fprintf(f, ",%lld", r->prunes[j]);
+			fprintf(f, "\n");
+		}
+		break;
+	case FORMAT_JSON:
+		fprintf(f, "[\n");
+		for (i = 0; i < rows->n; i++) {
+			r = &rows->rows[i];
+			fprintf(f, "  {\"solver\": \"%s\", \"threads\": %u, "
+			    "\"scrambles\": \"%s\", \"depth\": \"%s\", "
+			    "\"count\": %zu, \"time_total\": %.6f, "
+			    "\"time_mean\": %.6f, \"time_p50\": %.6f, "
+			    "\"time_p90\": %.6f, \"time_p99\": %.6f, "
+			    "\"time_max\": %.6f, \"nodes\": %lld, "
+			    "\"fallbacks\": %lld, \"nodes_per_second\": %.0f, "
+			    "\"pruned\": [", r->solver, r->threads,
+			    r->scrambles, r->depth, r->count, r->time_total,
+			    r->time_mean, r->time_p50, r->time_p90, r->time_p99,
+			    r->time_max, r->nodes, r->fallbacks,
+			    r->nodes_per_second);
+			for (j = 0; j < PRUNES; j++)
+				fprintf(f, "%lld%s", r->prunes[j],
+				    j == PRUNES-1 ? "" : ", ");
+			fprintf(f, "]}%s\n", i == rows->n-1 ? "" : ",");
+		}
+		fprintf(f, "]\n");
+		break;
+	default:
+		fprintf(f, "%-10s %7s %-12s %5s %5s %9s %9s %9s %9s %9s "
+		    "%13s %11s\n", "solver", "threads", "scrambles", "depth",
+		    "count", "total", "mean", "p50", "p90", "p99", "nodes",
+		    "nodes/s");
+		for (i = 0; i < rows->n; i++) {
+			r = &rows->rows[i];
+			fprintf(f, "%-10s %7u %-12s %5s %5zu %9.4f %9.4f %9.4f "
+			    "%9.4f %9.4f %13lld %11.0f\n", r->solver,
+			    r->threads, r->scrambles, r->depth, r->count,
+			    r->time_total, r->time_mean, r->time_p50,
+			    r->time_p90, r->time_p99, r->nodes,
+			    r->nodes_per_second);
+		}
+
+		fprintf(f, "\nNodes pruned by each table:\n");
+		fprintf(f, "%-10s %7s %-12s %13s %13s %13s %13s %13s %13s\n",
+		    "solver", "threads", "scrambles", "cbound", "h48",
+		    "extra1", "extra2", "extra3", "extra4");
+		for (i = 0; i < rows->n; i++) {
+			r = &rows->rows[i];
+			if (strcmp(r->depth, "all"))
+				continue;
+			fprintf(f, "%-10s %7u %-12s", r->solver, r->threads,
+			    r->scrambles);
+			for (j = 0; j < PRUNES; j++)
+				fprintf(f, " %13lld", r->prunes[j]);
+			fprintf(f, "\n");
+		}
+		break;
+	}
+}
+
+static int
+readbaseline(const char *filename, rows_t *rows)
+{
+	char line[LINE_LEN];
+	row_t r;
+	FILE *f;
+
+	if ((f = fopen(filename, "r")) == NULL) {
+		fprintf(stderr, "Error: could not open %s\n", filename);
+		return 1;
+	}
+
+	/* Skip the header */
+	if (fgets(line, LINE_LEN, f) == NULL) {
+		fclose(f);
+		return 1;
+	}
+
+	while (fgets(line, LINE_LEN, f) != NULL) {
+		memset(&r, 0, sizeof(r));
+		if (sscanf(line, "%63[^,],%u,%255[^,],%7[^,],%zu,%lf,%lf,%lf,"
+		    "%lf,%lf,%lf,%lld,%lld,%lf", r.solver, &r.threads,
+		    r.scrambles, r.depth, &r.count, &r.time_total,
+		    &r.time_mean, &r.time_p50, &r.time_p90, &r.time_p99,
+		    &r.time_max, &r.nodes, &r.fallbacks, &r.nodes_per_second)
+		    != 14) {
+			fprintf(stderr, "Error: %s is not a CSV file written "
+			    "by this tool\n", filename);
+			fclose(f);
+			return 1;
+		}
+		if (rows->n == rows->capacity) {
+			rows->capacity =
+			    rows->capacity == 0 ? 64 : 2 * rows->capacity;
+			rows->rows = realloc(
+			    rows->rows, rows->capacity * sizeof(row_t));
+		}
+		rows->rows[rows->n++] = r;
+	}
+
+	fclose(f);
+	return 0;
+}
+
+/* Returns the number of regressions */
+static int
+compare(const rows_t *rows, const rows_t *baseline, double tolerance)
+{
+	int regressions;
+	size_t i, j;
+	double ratio;
+	const row_t *r, *b;
+
+	fprintf(stderr, "\nComparison with baseline:\n");
+	for (i = 0, regressions = 0; i < rows->n; i++) {
+		r = &rows->rows[i];
+		for (j = 0; j < baseline->n; j++) {
+			b = &baseline->rows[j];
+			if (!strcmp(r->solver, b->solver) &&
+			    r->threads == b->threads &&
+			    !strcmp(r->scrambles, b->scrambles) &&
+			    !strcmp(r->depth, b->depth))
+				break;
+		}
+		if (j == baseline->n || b->time_mean <= 0.0)
+			continue;
+
+		ratio = r->time_mean / b->time_mean;
+		fprintf(stderr, "%s %u %s depth %s: mean %.6fs -> %.6fs "
+		    "(%+.1f%%)", r->solver, r->threads, r->scrambles,
+		    r->depth, b->time_mean, r->time_mean, 100.0 * (ratio-1.0));
+		if (ratio > 1.0 + tolerance / 100.0) {
+			fprintf(stderr, " REGRESSION");
+			regressions++;
+		}
+		if (r->nodes != b->nodes || r->count != b->count)
+			fprintf(stderr, " (nodes changed: %lld -> %lld)",
+			    b->nodes, r->nodes);
+		fprintf(stderr, "\n");
+	}
+
+	return regressions;
+}
+
+int
+main(int argc, char **argv)
+{
+	int i, s, t, c, nsolvers, nthreads, nsets, ret;
+	long long threads, size;
+	double tolerance;
+	char *solvers[MAX_LIST], *threadlist[MAX_LIST], *sets[MAX_LIST];
+	char solvers_default[] = "h48h0k4", threads_default[] = "128";
+	char sets_default[] = DEFAULT_SCRAMBLES, filename[1024], *data;
+	const char *output, *baseline;
+	format_t format;
+	rows_t rows = {0}, baserows = {0};
+	FILE *out;
+
+	nsolvers = splitlist(solvers_default, solvers);
+	nthreads = splitlist(threads_default, threadlist);
+	nsets = splitlist(sets_default, sets);
+	format = FORMAT_TEXT;
+	output = baseline = NULL;
+	tolerance = 10.0;
+
+	for (i = 1; i < argc; i++) {
+		if (i+1 >= argc) {
+			fprintf(stderr, "Error: no value for %s\n", argv[i]);
+			return 1;
+		}
+		if (!strcmp(argv[i], "-solver")) {
+			nsolvers = splitlist(argv[++i], solvers);
+		} else if (!strcmp(argv[i], "-threads")) {
+			nthreads = splitlist(argv[++i], threadlist);
+		} else if (!strcmp(argv[i], "-scrambles")) {
+			nsets = splitlist(argv[++i], sets);
+		} else if (!strcmp(argv[i], "-format")) {
+			i++;
+			if (!strcmp(argv[i], "text")) {
+				format = FORMAT_TEXT;
+			} else if (!strcmp(argv[i], "csv")) {
+				format = FORMAT_CSV;
+			} else if (!strcmp(argv[i], "json")) {
+				format = FORMAT_JSON;
+			} else {
+				fprintf(stderr, "Error: unknown format %s\n",
+				    argv[i]);
+				return 1;
+			}
+		} else if (!strcmp(argv[i], "-output")) {
+			output = argv[++i];
+		} else if (!strcmp(argv[i], "-baseline")) {
+			baseline = argv[++i];
+		} else if (!strcmp(argv[i], "-tolerance")) {
+			tolerance = strtod(argv[++i], NULL);
+		} else {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (baseline != NULL && readbaseline(baseline, &baserows) != 0)
+		return 1;
+
+	for (s = 0, ret = 0; s < nsolvers && ret == 0; s++) {
+		sprintf(filename, "tables/%s", solvers[s]);
+		if (getdata(solvers[s], &data, filename) != 0)
+			return 1;
+		size = nissy_datasize(solvers[s]);
+
+		for (t = 0; t < nthreads && ret == 0; t++) {
+			threads = nissy_setthreads(strtoul(threadlist[t],
+			    NULL, 10));
+			if (threads < 0) {
+				fprintf(stderr, "Error: invalid number of "
+				    "threads %s\n", threadlist[t]);
+				ret = 1;
+				break;
+			}
+			if (threads != strtol(threadlist[t], NULL, 10) &&
+			    strcmp(threadlist[t], threads_default))
+				fprintf(stderr, "Warning: using %lld threads "
+				    "instead of %s, the maximum for this "
+				    "build\n", threads, threadlist[t]);
+
+			for (c = 0; c < nsets && ret == 0; c++)
+				ret = runset(&rows, solvers[s],
+				    (unsigned)threads, size, data, sets[c]);
+		}
+
+		freedata(solvers[s], data);
+	}
+
+	if (ret != 0)
+		goto benchmark_solve_done;
+
+	if (output == NULL) {
+		writerows(stdout, format, &rows);
+	} else if ((out = fopen(output, "w")) == NULL) {
+		fprintf(stderr, "Error: could not write to %s\n", output);
+		ret = 1;
+	} else {
+		writerows(out, format, &rows);
+		fclose(out);
+		printf("Results written to %s\n", output);
+	}
+
+	if (ret == 0 && baseline != NULL &&
+	    compare(&rows, &baserows, tolerance) > 0)
+		ret = 1;
+
+benchmark_solve_done:
+	free(rows.rows);
+	free(baserows.rows);
+	return ret;
+}
@@ -0,0 +1,298 @@
+/*
+Benchmark for the generation of the h48 tables. For each combination of
+solver and number of threads given on the command line, a table is generated
+and the wall time of each phase is measured: the cocsep table, each depth
+of the h0k4 breadth-first search and of the count of its distribution, the
+short positions, the depth-first search workers and the final count of the
+k2 tables, and optionally the writing of the table to a file.
+
+Usage:
+   benchmark_gendata [-solver S1,S2,...] [-threads T1,T2,...]
+                     [-format text|csv|json] [-write FILE]
+
+For each phase the number of positions processed (coordinates scanned for
+the h0k4 and the count phases, short positions for the k2 phases), the
+number of table bytes processed and the resulting bandwidth are reported,
+together with the peak resident set size of the process at the end of the
+phase. The phases of the h0k4 table used as fallback for k2 tables are
+prefixed with "fallback_".
+
+This tool includes the library source directly, so that the phases can be
+timed with the GENDATA_PHASE_BEGIN and GENDATA_PHASE_END hooks.
+*/
+
+#define _XOPEN_SOURCE 500 /* For getrusage() */
+
+#include <inttypes.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#define GENDATA_PHASE_BEGIN(name, depth) phase_begin(name, depth)
+#define GENDATA_PHASE_END(positions, bytes) phase_end(positions, bytes)
+
+static void phase_begin(const char *, int);
+static void phase_end(uint64_t, uint64_t);
+
+#include "../../src/nissy.c"
+
+#define MAX_LIST 64
+#define MAX_ROWS 4096
+
+typedef enum { FORMAT_TEXT, FORMAT_CSV, FORMAT_JSON } format_t;
+
+typedef struct {
+	char solver[64];
+	unsigned threads;
+	char phase[32];
+	int depth;
+	double seconds;
+	uint64_t positions;
+	uint64_t bytes;
+	long peak_rss_kb;
+} row_t;
+
+static row_t rows[MAX_ROWS];
+static row_t pending;
+static size_t nrows;
+static const char *current_solver;
+static unsigned current_threads;
+static bool fallback;
+static double phase_start;
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static long
+peak_rss_kb(void)
+{
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return -1;
+
+	/* On Linux ru_maxrss is in kilobytes */
+	return usage.ru_maxrss;
+}
+
+static void
+phase_begin(const char *name, int depth)
+{
+	/* The h0k4 phases that come after a k2 table are for the fallback */
+	if (!strncmp(name, "k2_", 3))
+		fallback = true;
+
+	memset(&pending, 0, sizeof(row_t));
+	snprintf(pending.solver, sizeof(pending.solver), "%s",
+	    current_solver);
+	snprintf(pending.phase, sizeof(pending.phase), "%s%s",
+	    fallback && !strncmp(name, "h0k4_", 5) ? "fallback_" : "", name);
+	pending.threads = current_threads;
+	pending.depth = depth;
+
+	phase_start = now();
+}
+
+static void
+phase_end(uint64_t positions, uint64_t bytes)
+{
+	if (nrows == MAX_ROWS)
+		return;
+
+	pending.seconds = now() - phase_start;
+	pending.positions = positions;
+	pending.bytes = bytes;
+	pending.peak_rss_kb = peak_rss_kb();
+	rows[nrows++] = pending;
+}
+
+static int
+splitlist(char *str, char *list[static MAX_LIST])
+{
+	int n;
+	char *p;
+
+	for (n = 0, p = str; p != NULL && n < MAX_LIST; n++) {
+		list[n] = p;
+		if ((p = strchr(p, ',')) != NULL)
+			*p++ = '\0';
+	}
+
+	return n;
+}
+
+static int
+run(const char *solver, const char *writefile)
+{
+	int64_t size, gensize;
+	double start;
+	char *buf;
+	FILE *f;
+
+	fallback = false;
+	size = nissy_datasize(solver);
+	if (size < 0) {
+		fprintf(stderr, "Error: unknown solver %s\n", solver);
+		return 1;
+	}
+	if (nissy_allocdata(size, &buf) < 0) {
+		fprintf(stderr, "Error: could not allocate %" PRId64
+		    " bytes\n", size);
+		return 1;
+	}
+
+	start = now();
+	gensize = nissy_gendata(solver, size, buf);
+	phase_begin("total", -1);
+	phase_start = start;
+	phase_end(0, size);
+	if (gensize != size) {
+		fprintf(stderr, "Error generating table for %s\n", solver);
+		nissy_freedata(size, buf);
+		return 1;
+	}
+
+	if (writefile != NULL) {
+		if ((f = fopen(writefile, "wb")) == NULL) {
+			fprintf(stderr, "Error: could not write to %s\n",
+			    writefile);
+			nissy_freedata(size, buf);
+			return 1;
+		}
+		phase_begin("write", -1);
+		fwrite(buf, size, 1, f);
+		fclose(f);
+		phase_end(0, size);
+	}
+
+	nissy_freedata(size, buf);
+	return 0;
+}
+
+static void
+writerows(format_t format)
+{
+	size_t i;
+	double pps, gbs;
+	const row_t *r;
+
+	if (format == FORMAT_CSV)
+		printf("solver,threads,phase,depth,seconds,positions,"
+		    "positions_per_second,bytes,bandwidth_gbs,peak_rss_kb\n");
+	else if (format == FORMAT_JSON)
+		printf("[\n");
+	else
+		printf("%-10s %7s %-20s %5s %10s %13s %12s %8s %10s\n",
+		    "solver", "threads", "phase", "depth", "seconds",
+		    "positions", "positions/s", "GB/s", "peak RSS");
+
+	for (i = 0; i < nrows; i++) {
+		r = &rows[i];
+		pps = r->seconds > 0.0 ? r->positions / r->seconds : 0.0;
+		gbs = r->seconds > 0.0 ? 1e-9 * r->bytes / r->seconds : 0.0;
+		switch (format) {
+		case FORMAT_CSV:
+			printf("%s,%u,%s,%d,%.6f,%" PRIu64 ",%.0f,%" PRIu64
+			    ",%.3f,%ld\n", r->solver, r->threads, r->phase,
+			    r->depth, r->seconds, r->positions, pps, r->bytes,
+			    gbs, r->peak_rss_kb);
+			break;
+		case FORMAT_JSON:
+			printf("  {\"solver\": \"%s\", \"threads\": %u, "
+			    "\"phase\": \"%s\", \"depth\": %d, "
+			    "\"seconds\": %.6f, \"positions\": %" PRIu64 ", "
+			    "\"positions_per_second\": %.0f, "
+			    "\"bytes\": %" PRIu64 ", \"bandwidth_gbs\": %.3f, "
+			    "\"peak_rss_kb\": %ld}%s\n", r->solver,
+			    r->threads, r->phase, r->depth, r->seconds,
+			    r->positions, pps, r->bytes, gbs, r->peak_rss_kb,
+			    i == nrows-1 ? "" : ",");
+			break;
+		default:
+			printf("%-10s %7u %-20s %5d %10.4f %13" PRIu64
+			    " %12.0f %8.3f %8ldMB\n", r->solver, r->threads,
+			    r->phase, r->depth, r->seconds, r->positions, pps,
+			    gbs, r->peak_rss_kb / 1024);
+			break;
+		}
+	}
+
+	if (format == FORMAT_JSON)
+		printf("]\n");
+}
+
+int
+main(int argc, char **argv)
+{
+	int i, s, t, nsolvers, nthreads;
+	long long threads;
+	char *solvers[MAX_LIST], *threadlist[MAX_LIST];
+	char solvers_default[] = "h48h0k4", threads_default[] = "128";
+	const char *writefile;
+	format_t format;
+
+	nsolvers = splitlist(solvers_default, solvers);
+	nthreads = splitlist(threads_default, threadlist);
+	format = FORMAT_TEXT;
+	writefile = NULL;
+
+	for (i = 1; i < argc; i++) {
+		if (i+1 >= argc) {
+			fprintf(stderr, "Error: no value for %s\n", argv[i]);
+			return 1;
+		}
+		if (!strcmp(argv[i], "-solver")) {
+			nsolvers = splitlist(argv[++i], solvers);
+		} else if (!strcmp(argv[i], "-threads")) {
+			nthreads = splitlist(argv[++i], threadlist);
+		} else if (!strcmp(argv[i], "-write")) {
+			writefile = argv[++i];
+		} else if (!strcmp(argv[i], "-format")) {
+			i++;
+			if (!strcmp(argv[i], "text")) {
+				format = FORMAT_TEXT;
+			} else if (!strcmp(argv[i], "csv")) {
+				format = FORMAT_CSV;
+			} else if (!strcmp(argv[i], "json")) {
+				format = FORMAT_JSON;
+			} else {
+				fprintf(stderr, "Error: unknown format %s\n",
+				    argv[i]);
+				return 1;
+			}
+		} else {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	for (s = 0; s < nsolvers; s++) {
+		for (t = 0; t < nthreads; t++) {
+			threads = nissy_setthreads(
+			    strtoul(threadlist[t], NULL, 10));
+			if (threads < 0) {
+				fprintf(stderr, "Error: invalid number of "
+				    "threads %s\n", threadlist[t]);
+				return 1;
+			}
+			fprintf(stderr, "Generating %s with %lld threads\n",
+			    solvers[s], threads);
+			current_solver = solvers[s];
+			current_threads = threads;
+			if (run(solvers[s], writefile) != 0)
+				return 1;
+		}
+	}
+
+	writerows(format);
+
+	return 0;
+}
@@ -0,0 +1,206 @@
+/*
+Benchmark the placement of the data on machines with more than one NUMA
+node, see nissy_setnuma(). For each combination of NUMA mode and number of
+threads given on the command line, the optimal solution of each scramble
+is found with the given solver, and the total number of nodes visited per
+second and per second and thread is reported.
+
+Usage:
+   benchmark_numa [-solver S] [-threads T1,T2,...]
+                  [-numa default,interleave,replicate] [-scrambles FILE]
+
+The modes are run in the given order, and the data is read from the table
+file only once. With the interleave mode the pages of the data are moved,
+so a default run that comes after it does not use the original placement
+anymore: to compare with the default placement, run it first. On machines
+with a single node all the modes are equivalent.
+*/
+
+#include "../tool.h"
+
+#define SOL_BUFFER_LEN 1000
+#define LINE_LEN 1024
+#define MAX_LIST 64
+#define DEFAULT_SCRAMBLES "tools/406_benchmark_solve/scrambles/medium.txt"
+
+static const struct {
+	const char *name;
+	unsigned mode;
+} modes[] = {
+	{ .name = "default", .mode = NISSY_NUMA_DEFAULT },
+	{ .name = "interleave", .mode = NISSY_NUMA_INTERLEAVE },
+	{ .name = "replicate", .mode = NISSY_NUMA_REPLICATE },
+};
+
+#define MODES_COUNT (sizeof(modes) / sizeof(modes[0]))
+
+static int splitlist(char *, char *[static MAX_LIST]);
+static double now(void);
+static int run(const char *, unsigned long long, const char *,
+    const char *, const char *, long long);
+
+static int
+splitlist(char *str, char *list[static MAX_LIST])
+{
+	int n;
+	char *p;
+
+	for (n = 0, p = str; p != NULL && n < MAX_LIST; n++) {
+		list[n] = p;
+		if ((p = strchr(p, ',')) != NULL)
+			*p++ = '\0';
+	}
+
+	return n;
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int
+run(
+	const char *solver,
+	unsigned long long size,
+	const char *data,
+	const char *filename,
+	const char *mode,
+	long long threads
+)
+{
+	long long n, nodes, count, stats[NISSY_SIZE_SOLVE_STATS];
+	double start, first, time;
+	char line[LINE_LEN], cube[NISSY_SIZE_B32], sol[SOL_BUFFER_LEN];
+	FILE *f;
+
+	if ((f = fopen(filename, "r")) == NULL) {
+		fprintf(stderr, "Error: could not open %s\n", filename);
+		return 1;
+	}
+
+	nodes = count = 0;
+	time = first = 0.0;
+	while (fgets(line, LINE_LEN, f) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '\0' || !strncmp(line, "//", 2))
+			continue;
+
+		if (nissy_applymoves(NISSY_SOLVED_CUBE, line, cube) < 0) {
+			fprintf(stderr, "Skipping invalid scramble %s\n", line);
+			continue;
+		}
+
+		start = now();
+		n = nissy_solve(cube, solver, NISSY_NISSFLAG_NORMAL, 0, 20,
+		    1, -1, size, data, SOL_BUFFER_LEN, sol, stats);
+		if (n <= 0) {
+			fprintf(stderr, "Skipping scramble %s: %s\n", line,
+			    n == 0 ? "no solution found" : "error");
+			continue;
+		}
+
+		/* The first solve includes the preparation of the data */
+		if (count == 0) {
+			first = now() - start;
+		} else {
+			time += now() - start;
+			nodes += stats[0];
+		}
+		count++;
+	}
+	fclose(f);
+
+	if (count < 2) {
+		fprintf(stderr, "Error: at least 2 scrambles are needed\n");
+		return 1;
+	}
+
+	printf("%-10s %7lld %5lld %10.4f %10.4f %13lld %12.0f %12.0f\n",
+	    mode, threads, count, first, time, nodes, nodes / time,
+	    nodes / time / threads);
+	fflush(stdout);
+
+	return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+	int i, t, m, nthreads, nmodes;
+	long long threads, size;
+	size_t j;
+	char *threadlist[MAX_LIST], *modelist[MAX_LIST];
+	char threads_default[] = "1,128", modes_default[] =
+	    "default,interleave,replicate", filename[1024], *data;
+	const char *solver, *scrambles;
+
+	solver = "h48h0k4";
+	scrambles = DEFAULT_SCRAMBLES;
+	nthreads = splitlist(threads_default, threadlist);
+	nmodes = splitlist(modes_default, modelist);
+
+	for (i = 1; i < argc; i++) {
+		if (i+1 >= argc) {
+			fprintf(stderr, "Error: no value for %s\n", argv[i]);
+			return 1;
+		}
+		if (!strcmp(argv[i], "-solver")) {
+			solver = argv[++i];
+		} else if (!strcmp(argv[i], "-threads")) {
+			nthreads = splitlist(argv[++i], threadlist);
+		} else if (!strcmp(argv[i], "-numa")) {
+			nmodes = splitlist(argv[++i], modelist);
+		} else if (!strcmp(argv[i], "-scrambles")) {
+			scrambles = argv[++i];
+		} else {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	sprintf(filename, "tables/%s", solver);
+	if (getdata(solver, &data, filename) != 0)
+		return 1;
+	size = nissy_datasize(solver);
+
+	printf("Solver %s, scrambles %s\n", solver, scrambles);
+	printf("%-10s %7s %5s %10s %10s %13s %12s %12s\n", "numa", "threads",
+	    "count", "first", "time", "nodes", "nodes/s", "nodes/s/thr");
+	for (m = 0; m < nmodes; m++) {
+		for (j = 0; j < MODES_COUNT; j++)
+			if (!strcmp(modelist[m], modes[j].name))
+				break;
+		if (j == MODES_COUNT) {
+			fprintf(stderr, "Error: unknown mode %s\n", modelist[m]);
+			freedata(solver, data);
+			return 1;
+		}
+
+		for (t = 0; t < nthreads; t++) {
+			/* Setting the mode again drops the replicas */
+			nissy_setnuma(modes[j].mode);
+			threads = nissy_setthreads(
+			    strtoul(threadlist[t], NULL, 10));
+			if (threads < 0) {
+				fprintf(stderr, "Error: invalid number of "
+				    "threads %s\n", threadlist[t]);
+				freedata(solver, data);
+				return 1;
+			}
+			if (run(solver, size, data, scrambles, modelist[m],
+			    threads) != 0) {
+				freedata(solver, data);
+				return 1;
+			}
+		}
+	}
+
+	freedata(solver, data);
+	return 0;
+}
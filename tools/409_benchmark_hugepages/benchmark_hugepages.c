@@ -0,0 +1,328 @@
+/*
+Benchmark the memory used for the solver data. The table of the given
+solver is read from file into a buffer allocated in three different ways:
+   malloc  - with malloc(3), as done before nissy_allocdata() was added;
+   huge    - with nissy_allocdata(), that uses huge pages if possible;
+   warmup  - with nissy_allocdata(), followed by a call to nissy_warmup().
+
+For each buffer the following are measured: the time to allocate it, to
+read the table and to warm it up; the latency of random dependent lookups
+in the table; the time of the first solve and the mean time of the other
+solves of the given scrambles, and the number of nodes per second. On
+Linux, the data TLB misses per lookup and per node are counted with
+perf_event_open(2), if it is allowed (see
+/proc/sys/kernel/perf_event_paranoid); otherwise "-" is shown.
+
+Usage:
+   benchmark_hugepages [-solver S] [-threads T] [-lookups N] [-scrambles FILE]
+
+The "pages" column shows the value returned by nissy_allocdata(): 0 for
+normal pages, 1 for transparent huge pages and 2 for explicit huge pages.
+The "thp_mb" column shows how much of the process memory is backed by
+transparent huge pages after the table is loaded.
+*/
+
+#include "../tool.h"
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/* Declared here because it is hidden by glibc in strict C11 mode */
+long syscall(long, ...);
+#endif
+
+#define SOL_BUFFER_LEN 1000
+#define LINE_LEN 1024
+#define MAX_SCRAMBLES 1000
+#define DEFAULT_SCRAMBLES "tools/406_benchmark_solve/scrambles/short.txt"
+
+typedef enum { ALLOC_MALLOC, ALLOC_HUGE, ALLOC_WARMUP } alloc_t;
+
+static const char *allocname[] = { "malloc", "huge", "warmup" };
+
+static char scrambles[MAX_SCRAMBLES][NISSY_SIZE_B32];
+static int nscrambles;
+static volatile uint64_t lookup_result; /* So the lookups are not skipped */
+
+static double now(void);
+static int tlb_open(void);
+static long long tlb_read(int);
+static long thp_mb(void);
+static int readscrambles(const char *);
+static int run(const char *, alloc_t, long long);
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/*
+Open a counter of the data TLB misses of this process, including the
+threads created later. Returns -1 if it is not available.
+*/
+static int
+tlb_open(void)
+{
+#if defined(__linux__)
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HW_CACHE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_DTLB |
+	    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+	    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.inherit = 1;
+
+	return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+	return -1;
+#endif
+}
+
+static long long
+tlb_read(int fd)
+{
+	long long count;
+
+#if defined(__linux__)
+	if (fd >= 0 && read(fd, &count, sizeof(count)) == sizeof(count))
+		return count;
+#endif
+
+	return -1;
+}
+
+/* Memory backed by transparent huge pages, in MiB, or -1 if unknown */
+static long
+thp_mb(void)
+{
+	long kb;
+	char line[LINE_LEN];
+	FILE *f;
+
+	if ((f = fopen("/proc/self/smaps_rollup", "r")) == NULL)
+		return -1;
+
+	kb = -1;
+	while (fgets(line, LINE_LEN, f) != NULL)
+		if (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1)
+			break;
+	fclose(f);
+
+	return kb < 0 ? -1 : kb / 1024;
+}
+
+static int
+readscrambles(const char *filename)
+{
+	char line[LINE_LEN];
+	FILE *f;
+
+	if ((f = fopen(filename, "r")) == NULL) {
+		fprintf(stderr, "Error: could not open %s\n", filename);
+		return 1;
+	}
+
+	nscrambles = 0;
+	while (fgets(line, LINE_LEN, f) != NULL && nscrambles < MAX_SCRAMBLES) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '\0' || !strncmp(line, "//", 2))
+			continue;
+		if (nissy_applymoves(NISSY_SOLVED_CUBE, line,
+		    scrambles[nscrambles]) < 0) {
+			fprintf(stderr, "Skipping invalid scramble %s\n", line);
+			continue;
+		}
+		nscrambles++;
+	}
+	fclose(f);
+
+	if (nscrambles < 2) {
+		fprintf(stderr, "Error: at least 2 scrambles are needed\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+run(const char *solver, alloc_t alloc, long long lookups)
+{
+	int i, fd;
+	long long pages, size, n, nodes, tlb, tlbnodes, tlblookups;
+	long long stats[NISSY_SIZE_SOLVE_STATS];
+	uint64_t index, x;
+	double start, talloc, tread, twarmup, tlookup, tfirst, tsolve;
+	char filename[1024], *data, sol[SOL_BUFFER_LEN];
+	const unsigned char *table;
+	FILE *f;
+
+	sprintf(filename, "tables/%s", solver);
+	size = nissy_datasize(solver);
+	if (size < 0) {
+		fprintf(stderr, "Error: unknown solver %s\n", solver);
+		return 1;
+	}
+
+	start = now();
+	if (alloc == ALLOC_MALLOC) {
+		pages = NISSY_HUGEPAGES_NONE;
+		data = malloc(size);
+	} else if ((pages = nissy_allocdata(size, &data)) < 0) {
+		data = NULL;
+	}
+	talloc = now() - start;
+	if (data == NULL) {
+		fprintf(stderr, "Error: could not allocate the table\n");
+		return 1;
+	}
+
+	if ((f = fopen(filename, "rb")) == NULL) {
+		fprintf(stderr, "Error: could not open %s, generate it "
+		    "first\n", filename);
+		goto run_error;
+	}
+	start = now();
+	n = fread(data, size, 1, f);
+	tread = now() - start;
+	fclose(f);
+	if (n != 1) {
+		fprintf(stderr, "Error reading %s\n", filename);
+		goto run_error;
+	}
+
+	start = now();
+	if (alloc == ALLOC_WARMUP)
+		nissy_warmup(size, data);
+	twarmup = now() - start;
+
+	fd = tlb_open();
+
+	/* Each lookup depends on the previous one, to measure the latency */
+	table = (const unsigned char *)data;
+	tlb = tlb_read(fd);
+	start = now();
+	for (n = 0, index = 0, x = 0; n < lookups; n++) {
+		x = x * UINT64_C(6364136223846793005) + table[index] + 1;
+		index = (x >> 16) % size;
+	}
+	tlookup = now() - start;
+	lookup_result = x;
+	tlblookups = tlb < 0 ? -1 : tlb_read(fd) - tlb;
+
+	tfirst = tsolve = 0.0;
+	nodes = 0;
+	tlb = tlb_read(fd);
+	for (i = 0; i < nscrambles; i++) {
+		start = now();
+		n = nissy_solve(scrambles[i], solver, NISSY_NISSFLAG_NORMAL, 0,
+		    20, 1, -1, size, data, SOL_BUFFER_LEN, sol, stats);
+		if (n <= 0) {
+			fprintf(stderr, "Error solving scramble %d\n", i);
+			goto run_error;
+		}
+		if (i == 0) {
+			tfirst = now() - start;
+			tlb = tlb_read(fd);
+		} else {
+			tsolve += now() - start;
+			nodes += stats[0];
+		}
+	}
+	tlbnodes = tlb < 0 ? -1 : tlb_read(fd) - tlb;
+
+#if defined(__linux__)
+	if (fd >= 0)
+		close(fd);
+#endif
+
+	printf("%-7s %5lld %7ld %8.4f %8.4f %8.4f %9.1f ", allocname[alloc],
+	    pages, thp_mb(), talloc, tread, twarmup, 1e9 * tlookup / lookups);
+	if (tlblookups < 0)
+		printf("%10s ", "-");
+	else
+		printf("%10.4f ", (double)tlblookups / lookups);
+	printf("%9.4f %9.4f %12.0f ", 1e3 * tfirst,
+	    1e3 * tsolve / (nscrambles - 1), nodes / tsolve);
+	if (tlbnodes < 0 || nodes == 0)
+		printf("%10s\n", "-");
+	else
+		printf("%10.4f\n", (double)tlbnodes / nodes);
+	fflush(stdout);
+
+	if (alloc == ALLOC_MALLOC)
+		free(data);
+	else
+		nissy_freedata(size, data);
+	return 0;
+
+run_error:
+	if (alloc == ALLOC_MALLOC)
+		free(data);
+	else
+		nissy_freedata(size, data);
+	return 1;
+}
+
+int
+main(int argc, char **argv)
+{
+	int i;
+	long long lookups, threads;
+	alloc_t alloc;
+	const char *solver, *scramblefile;
+
+	solver = "h48h0k4";
+	scramblefile = DEFAULT_SCRAMBLES;
+	lookups = 10000000;
+	threads = 1;
+
+	for (i = 1; i < argc; i++) {
+		if (i+1 >= argc) {
+			fprintf(stderr, "Error: no value for %s\n", argv[i]);
+			return 1;
+		}
+		if (!strcmp(argv[i], "-solver")) {
+			solver = argv[++i];
+		} else if (!strcmp(argv[i], "-threads")) {
+			threads = strtoll(argv[++i], NULL, 10);
+		} else if (!strcmp(argv[i], "-lookups")) {
+			lookups = strtoll(argv[++i], NULL, 10);
+		} else if (!strcmp(argv[i], "-scrambles")) {
+			scramblefile = argv[++i];
+		} else {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (lookups < 1 || (threads = nissy_setthreads(threads)) < 0) {
+		fprintf(stderr, "Error: invalid options\n");
+		return 1;
+	}
+	if (readscrambles(scramblefile) != 0)
+		return 1;
+
+	printf("Solver %s, %lld threads, %lld lookups, scrambles %s\n",
+	    solver, threads, lookups, scramblefile);
+	printf("Times in seconds, except for the lookups (ns) and the solves "
+	    "(ms)\n");
+	printf("%-7s %5s %7s %8s %8s %8s %9s %10s %9s %9s %12s %10s\n",
+	    "alloc", "pages", "thp_mb", "alloc", "read", "warmup", "lookup",
+	    "tlb/lookup", "first", "solve", "nodes/s", "tlb/node");
+	for (alloc = ALLOC_MALLOC; alloc <= ALLOC_WARMUP; alloc++)
+		if (run(solver, alloc, lookups) != 0)
+			return 1;
+
+	return 0;
+}
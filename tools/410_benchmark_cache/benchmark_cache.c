@@ -0,0 +1,256 @@
+/*
+Benchmark the cache of the solutions, see nissy_setcache(). Each scramble
+is solved in several variants: rotated and mirrored by a few of the 48
+transformations and, for the second half of the variants, also inverted.
+This is repeated with the cache disabled, with NISSY_CACHE_SYMMETRY and
+with NISSY_CACHE_INVERSE, and for each mode the total time, the cache
+statistics and the number of solutions that do not solve their cube (which
+should always be 0) are reported.
+
+Usage:
+   benchmark_cache [-solver S] [-threads T] [-variants N] [-size BYTES]
+                   [-scrambles FILE]
+
+With the cache disabled every variant is solved; with NISSY_CACHE_SYMMETRY
+only the first variant and the first inverted one are, and with
+NISSY_CACHE_INVERSE only the first one.
+
+The solves that find maxsols solutions are not cached, so each variant is
+solved for all its optimal solutions, with the optimal length found by a
+first solve of the scramble, before the benchmark.
+*/
+
+#include "../tool.h"
+
+#define SOL_BUFFER_LEN 10000
+#define MAX_SOLUTIONS 100
+#define LINE_LEN 1024
+#define MAX_SCRAMBLES 1000
+#define MAX_VARIANTS 16
+#define DEFAULT_SCRAMBLES "tools/406_benchmark_solve/scrambles/short.txt"
+
+static const char *trans[MAX_VARIANTS / 2] = {
+	"rotation UF", "mirrored UF", "rotation RD", "mirrored FL",
+	"rotation BU", "mirrored LB", "rotation DR", "mirrored UR",
+};
+
+static const struct {
+	const char *name;
+	unsigned mode;
+} modes[] = {
+	{ .name = "off", .mode = NISSY_CACHE_OFF },
+	{ .name = "symmetry", .mode = NISSY_CACHE_SYMMETRY },
+	{ .name = "inverse", .mode = NISSY_CACHE_INVERSE },
+};
+
+#define MODES_COUNT (sizeof(modes) / sizeof(modes[0]))
+
+static char scrambles[MAX_SCRAMBLES][NISSY_SIZE_B32];
+static int lengths[MAX_SCRAMBLES];
+static int nscrambles;
+
+static double now(void);
+static int readscrambles(const char *);
+static int findlengths(const char *, long long, const char *);
+static bool checksolutions(const char *, const char *);
+static int run(const char *, long long, const char *, int, size_t);
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int
+readscrambles(const char *filename)
+{
+	char line[LINE_LEN];
+	FILE *f;
+
+	if ((f = fopen(filename, "r")) == NULL) {
+		fprintf(stderr, "Error: could not open %s\n", filename);
+		return 1;
+	}
+
+	nscrambles = 0;
+	while (fgets(line, LINE_LEN, f) != NULL && nscrambles < MAX_SCRAMBLES) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '\0' || !strncmp(line, "//", 2))
+			continue;
+		if (nissy_applymoves(NISSY_SOLVED_CUBE, line,
+		    scrambles[nscrambles]) < 0) {
+			fprintf(stderr, "Skipping invalid scramble %s\n", line);
+			continue;
+		}
+		nscrambles++;
+	}
+	fclose(f);
+
+	return 0;
+}
+
+/* Find the optimal length of each scramble, with the cache disabled */
+static int
+findlengths(const char *solver, long long size, const char *data)
+{
+	int i;
+	long long stats[NISSY_SIZE_SOLVE_STATS];
+	char sol[SOL_BUFFER_LEN];
+
+	for (i = 0; i < nscrambles; i++) {
+		if (nissy_solve(scrambles[i], solver, NISSY_NISSFLAG_NORMAL,
+		    0, 20, 1, -1, size, data, SOL_BUFFER_LEN, sol,
+		    stats) <= 0) {
+			fprintf(stderr, "Error solving scramble %d\n", i);
+			return 1;
+		}
+		lengths[i] = nissy_countmoves(sol);
+	}
+
+	return 0;
+}
+
+/* Check that each of the solutions, one per line, solves the cube */
+static bool
+checksolutions(const char *cube, const char *sols)
+{
+	char line[LINE_LEN], result[NISSY_SIZE_B32];
+	const char *next;
+
+	for ( ; *sols != '\0'; sols = next+1) {
+		if ((next = strchr(sols, '\n')) == NULL ||
+		    next - sols >= LINE_LEN)
+			return false;
+		memcpy(line, sols, next - sols);
+		line[next - sols] = '\0';
+		if (nissy_applymoves(cube, line, result) < 0 ||
+		    strcmp(result, NISSY_SOLVED_CUBE))
+			return false;
+	}
+
+	return true;
+}
+
+static int
+run(
+	const char *solver,
+	long long size,
+	const char *data,
+	int variants,
+	size_t m
+)
+{
+	int i, v, bad;
+	long long n, solves, stats[NISSY_SIZE_SOLVE_STATS],
+	    cachestats[NISSY_SIZE_CACHE_STATS];
+	double start, time;
+	char cube[NISSY_SIZE_B32], sol[SOL_BUFFER_LEN];
+
+	solves = bad = 0;
+	start = now();
+	for (i = 0; i < nscrambles; i++) {
+		for (v = 0; v < variants; v++) {
+			if (v < variants / 2 || variants == 1)
+				nissy_applytrans(scrambles[i],
+				    trans[v % (MAX_VARIANTS / 2)], cube);
+			else if (nissy_inverse(scrambles[i], cube) >= 0)
+				nissy_applytrans(cube,
+				    trans[v % (MAX_VARIANTS / 2)], cube);
+
+			n = nissy_solve(cube, solver, NISSY_NISSFLAG_NORMAL,
+			    lengths[i], lengths[i], MAX_SOLUTIONS, -1, size,
+			    data, SOL_BUFFER_LEN, sol, stats);
+			if (n <= 0) {
+				fprintf(stderr, "Error solving scramble %d\n",
+				    i);
+				return 1;
+			}
+			solves++;
+			bad += !checksolutions(cube, sol);
+		}
+	}
+	time = now() - start;
+
+	nissy_cachestats(cachestats);
+	printf("%-9s %7lld %10.4f %10.4f %8lld %8lld %8lld %8lld %10lld "
+	    "%5d\n", modes[m].name, solves, time, 1e3 * time / solves,
+	    cachestats[0], cachestats[1], cachestats[2], cachestats[3],
+	    cachestats[4], bad);
+	fflush(stdout);
+
+	return bad > 0;
+}
+
+int
+main(int argc, char **argv)
+{
+	int i, variants, ret;
+	long long threads, size, cachesize;
+	size_t m;
+	char filename[1024], *data;
+	const char *solver, *scramblefile;
+
+	solver = "h48h0k4";
+	scramblefile = DEFAULT_SCRAMBLES;
+	threads = 1;
+	variants = MAX_VARIANTS;
+	cachesize = 1 << 20;
+
+	for (i = 1; i < argc; i++) {
+		if (i+1 >= argc) {
+			fprintf(stderr, "Error: no value for %s\n", argv[i]);
+			return 1;
+		}
+		if (!strcmp(argv[i], "-solver")) {
+			solver = argv[++i];
+		} else if (!strcmp(argv[i], "-threads")) {
+			threads = strtoll(argv[++i], NULL, 10);
+		} else if (!strcmp(argv[i], "-variants")) {
+			variants = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-size")) {
+			cachesize = strtoll(argv[++i], NULL, 10);
+		} else if (!strcmp(argv[i], "-scrambles")) {
+			scramblefile = argv[++i];
+		} else {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (variants < 1 || variants > MAX_VARIANTS || cachesize < 0 ||
+	    (threads = nissy_setthreads(threads)) < 0) {
+		fprintf(stderr, "Error: invalid options\n");
+		return 1;
+	}
+	if (readscrambles(scramblefile) != 0)
+		return 1;
+
+	sprintf(filename, "tables/%s", solver);
+	if (getdata(solver, &data, filename) != 0)
+		return 1;
+	size = nissy_datasize(solver);
+	nissy_setcache(0, NISSY_CACHE_OFF);
+	if (findlengths(solver, size, data) != 0) {
+		freedata(solver, data);
+		return 1;
+	}
+
+	printf("Solver %s, %lld threads, %d variants, cache size %lld, "
+	    "scrambles %s\n", solver, threads, variants, cachesize,
+	    scramblefile);
+	printf("%-9s %7s %10s %10s %8s %8s %8s %8s %10s %5s\n", "cache",
+	    "solves", "time", "ms/solve", "hits", "misses", "evicted",
+	    "entries", "bytes", "bad");
+	for (m = 0, ret = 0; m < MODES_COUNT && ret == 0; m++) {
+		nissy_setcache(cachesize, modes[m].mode);
+		ret = run(solver, size, data, variants, m);
+	}
+	nissy_setcache(0, NISSY_CACHE_OFF);
+
+	freedata(solver, data);
+	return ret;
+}
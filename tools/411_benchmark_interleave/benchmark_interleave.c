@@ -0,0 +1,187 @@
+/*
+Benchmark the interleaving of the searches of the h48 solvers, see
+nissy_setinterleave(). For each combination of number of searches per
+thread and number of threads given on the command line, the optimal
+solution of each scramble is found with the given solver, and the total
+number of nodes visited per second and per second and thread is reported.
+
+Usage:
+   benchmark_interleave [-solver S] [-threads T1,T2,...]
+                        [-interleave N1,N2,...] [-scrambles FILE]
+
+The interleaving hides the latency of the memory when the tables do not fit
+in the CPU cache. Only the first solution of each scramble is searched, and
+the solutions can be found in a different order with more than one thread
+or search, so the number of nodes can change slightly between the runs;
+with one thread and one search the single-threaded solver is used, which
+also visits a different number of nodes.
+*/
+
+#include "../tool.h"
+
+#define SOL_BUFFER_LEN 1000
+#define LINE_LEN 1024
+#define MAX_LIST 64
+#define DEFAULT_SCRAMBLES "tools/406_benchmark_solve/scrambles/medium.txt"
+
+static int splitlist(char *, char *[static MAX_LIST]);
+static double now(void);
+static int run(const char *, unsigned long long, const char *,
+    const char *, long long, long long);
+
+static int
+splitlist(char *str, char *list[static MAX_LIST])
+{
+	int n;
+	char *p;
+
+	for (n = 0, p = str; p != NULL && n < MAX_LIST; n++) {
+		list[n] = p;
+		if ((p = strchr(p, ',')) != NULL)
+			*p++ = '\0';
+	}
+
+	return n;
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int
+run(
+	const char *solver,
+	unsigned long long size,
+	const char *data,
+	const char *filename,
+	long long searches,
+	long long threads
+)
+{
+	long long n, nodes, count, stats[NISSY_SIZE_SOLVE_STATS];
+	double start, time;
+	char line[LINE_LEN], cube[NISSY_SIZE_B32], sol[SOL_BUFFER_LEN];
+	FILE *f;
+
+	if ((f = fopen(filename, "r")) == NULL) {
+		fprintf(stderr, "Error: could not open %s\n", filename);
+		return 1;
+	}
+
+	nodes = count = 0;
+	time = 0.0;
+	while (fgets(line, LINE_LEN, f) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '\0' || !strncmp(line, "//", 2))
+			continue;
+
+		if (nissy_applymoves(NISSY_SOLVED_CUBE, line, cube) < 0) {
+			fprintf(stderr, "Skipping invalid scramble %s\n", line);
+			continue;
+		}
+
+		start = now();
+		n = nissy_solve(cube, solver, NISSY_NISSFLAG_NORMAL, 0, 20,
+		    1, -1, size, data, SOL_BUFFER_LEN, sol, stats);
+		if (n <= 0) {
+			fprintf(stderr, "Skipping scramble %s: %s\n", line,
+			    n == 0 ? "no solution found" : "error");
+			continue;
+		}
+		time += now() - start;
+		nodes += stats[0];
+		count++;
+	}
+	fclose(f);
+
+	if (count == 0) {
+		fprintf(stderr, "Error: no scramble was solved\n");
+		return 1;
+	}
+
+	printf("%10lld %7lld %5lld %10.4f %13lld %12.0f %12.0f\n",
+	    searches, threads, count, time, nodes, nodes / time,
+	    nodes / time / threads);
+	fflush(stdout);
+
+	return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+	int i, s, t, nthreads, nsearches;
+	long long threads, searches, size;
+	char *threadlist[MAX_LIST], *searchlist[MAX_LIST];
+	char threads_default[] = "1", searches_default[] = "1,2,4,8",
+	    filename[1024], *data;
+	const char *solver, *scrambles;
+
+	solver = "h48h0k4";
+	scrambles = DEFAULT_SCRAMBLES;
+	nthreads = splitlist(threads_default, threadlist);
+	nsearches = splitlist(searches_default, searchlist);
+
+	for (i = 1; i < argc; i++) {
+		if (i+1 >= argc) {
+			fprintf(stderr, "Error: no value for %s\n", argv[i]);
+			return 1;
+		}
+		if (!strcmp(argv[i], "-solver")) {
+			solver = argv[++i];
+		} else if (!strcmp(argv[i], "-threads")) {
+			nthreads = splitlist(argv[++i], threadlist);
+		} else if (!strcmp(argv[i], "-interleave")) {
+			nsearches = splitlist(argv[++i], searchlist);
+		} else if (!strcmp(argv[i], "-scrambles")) {
+			scrambles = argv[++i];
+		} else {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	sprintf(filename, "tables/%s", solver);
+	if (getdata(solver, &data, filename) != 0)
+		return 1;
+	size = nissy_datasize(solver);
+
+	printf("Solver %s, scrambles %s\n", solver, scrambles);
+	printf("%10s %7s %5s %10s %13s %12s %12s\n", "interleave", "threads",
+	    "count", "time", "nodes", "nodes/s", "nodes/s/thr");
+	for (s = 0; s < nsearches; s++) {
+		searches = nissy_setinterleave(
+		    strtoul(searchlist[s], NULL, 10));
+		if (searches < 0) {
+			fprintf(stderr, "Error: invalid number of searches "
+			    "%s\n", searchlist[s]);
+			freedata(solver, data);
+			return 1;
+		}
+
+		for (t = 0; t < nthreads; t++) {
+			threads = nissy_setthreads(
+			    strtoul(threadlist[t], NULL, 10));
+			if (threads < 0) {
+				fprintf(stderr, "Error: invalid number of "
+				    "threads %s\n", threadlist[t]);
+				freedata(solver, data);
+				return 1;
+			}
+			if (run(solver, size, data, scrambles, searches,
+			    threads) != 0) {
+				freedata(solver, data);
+				return 1;
+			}
+		}
+	}
+
+	freedata(solver, data);
+	return 0;
+}
@@ -17,6 +17,7 @@ static long long int generatetable(const char *, char **);
 static long long int derivetable(
     const char *, const char *, const char *, char **);
 static int getdata(const char *, char **, const char *);
+static void freedata(const char *, char *);
 static void gendata_run(const char *, uint64_t[static 21]);
 static void derivedata_run(
     const char *, const char *, const char *, const char *);
@@ -96,7 +97,11 @@ generatetable(const char *solver, char **buf)
 		return -1;
 	}
 
-	*buf = malloc(size);
+	if (nissy_allocdata(size, buf) < 0) {
+		printf("Error allocating memory for the table.\n");
+		*buf = NULL;
+		return -2;
+	}
 	gensize = nissy_gendata(solver, size, *buf);
 
 	if (gensize != size) {
@@ -140,7 +145,12 @@ derivetable(
 		goto derivetable_error;
 	}
 
-	*buf = malloc(size);
+	if (nissy_allocdata(size, buf) < 0) {
+		printf("Error allocating memory for the table.\n");
+		*buf = NULL;
+		gensize = -4;
+		goto derivetable_error;
+	}
 	gensize = gendata_h48_derive(h, fulltable, *buf);
 
 	if (gensize != size) {
@@ -150,7 +160,7 @@ derivetable(
 	}
 
 derivetable_error:
-	free(fulltable);
+	freedata(solver_large, fulltable);
 
 derivetable_error_nofree:
 	return gensize;
@@ -180,23 +190,35 @@ getdata(
 	} else {
 		printf("Reading tables from file %s\n", filename);
 		size = nissy_datasize(solver);
-		*buf = malloc(size);
+		if (nissy_allocdata(size, buf) < 0) {
+			printf("Error allocating memory for the table\n");
+			fclose(f);
+			goto getdata_error_nofree;
+		}
 		sizeread = fread(*buf, size, 1, f);
 		fclose(f);
 		if (sizeread != 1) {
 			printf("Error reading table, stopping\n");
 			goto getdata_error;
 		}
+		nissy_warmup(size, *buf);
 	}
 
 	return 0;
 
 getdata_error:
-	free(*buf);
+	freedata(solver, *buf);
 getdata_error_nofree:
 	return 1;
 }
 
+/* Release a table obtained with getdata() or generatetable() */
+static void
+freedata(const char *solver, char *buf)
+{
+	nissy_freedata(nissy_datasize(solver), buf);
+}
+
 static void
 gendata_run(
 	const char *solver,
@@ -224,7 +246,7 @@ gendata_run(
 	}
 
 gendata_run_finish:
-	free(buf);
+	freedata(solver, buf);
 }
 
 static void
@@ -256,5 +278,5 @@ derivedata_run(
 	}
 
 derivedata_run_finish:
-	free(buf);
+	freedata(solver_small, buf);
 }
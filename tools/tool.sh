@@ -22,7 +22,12 @@ done
 
 file="$RESULTS/$toolname-$date.txt"
 
-$CC -o $BIN "$t"/*.c "$OBJ" || exit 1;
+# Tools that include the library source directly are not linked with it
+if grep -q "src/nissy.c" "$t"/*.c; then
+	OBJ=""
+fi
+
+$CC -o $BIN "$t"/*.c $OBJ || exit 1;
 
 (
 date +'%Y-%m-%d %H:%M'